@@ -25,7 +25,7 @@
  * \library       seq66qt5 application
  * \author        Chris Ahlstrom
  * \date          2017-09-05
- * \updates       2026-04-15
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  This is an attempt to change from the hoary old (or, as H.P. Lovecraft
@@ -116,6 +116,11 @@ main (int argc, char * argv [])
         printf("ring_buffer test FAILED\n");
         exit(1);
     }
+    else if (! seq66::run_ring_benchmark())
+    {
+        printf("ring_buffer benchmark FAILED\n");
+        exit(1);
+    }
     else
         exit(0);
 #endif
@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-09-22
- * \updates       2026-05-18
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  This collection of variables describes the options of the application,
@@ -95,6 +95,24 @@ const int c_input_buss_default  =  4;
 const int c_output_buss_max     = 48;
 const int c_output_buss_default =  8;
 
+/**
+ *  The maximum lookahead, in milliseconds, for the ALSA queue-scheduling mode.
+ *  Events are stamped this far into the future on the ALSA queue so that the
+ *  kernel, rather than the output thread, determines when they go out.  More
+ *  than a tenth of a second would make live control too sluggish.
+ */
+
+const int c_alsa_queue_lookahead_max = 100;
+
+/**
+ *  The default and maximum pacing, in bytes per second, of large SysEx
+ *  messages sent to ALSA ports.  The default matches the old 256 bytes
+ *  every 80 ms, a little over the 3125 bytes per second of a MIDI cable.
+ */
+
+const int c_alsa_sysex_rate_default = 3200;
+const int c_alsa_sysex_rate_max = 1000000;
+
 /**
  *  Maximum number of groups that can be supported.  Basically, the number of
  *  groups set in the 'rc' file.  32 groups can be filled.  This is a permanent
@@ -334,6 +352,7 @@ private:
     bool m_show_midi;               /**< Show MIDI events to console.       */
     bool m_priority;                /**< Run at high priority (Linux only). */
     int m_thread_priority;          /**< The desired priority (Linux only). */
+    bool m_deadline_scheduler;      /**< Output thread wakes at deadlines.  */
     bool m_pass_sysex;              /**< Pass SysEx to outputs, not ready.  */
     bool m_with_jack_transport;     /**< Enable synchrony with JACK.        */
     bool m_with_jack_master;        /**< Serve as a JACK transport Master.  */
@@ -342,7 +361,10 @@ private:
     bool m_with_alsa_midi;          /**< Use ALSA MIDI.                     */
     bool m_jack_auto_connect;       /**< Connect JACK ports in normal mode. */
     bool m_jack_use_offset;         /**< Try to calculate output offset.    */
+    bool m_jack_pull_mode;          /**< JACK callback plays the patterns.  */
     int m_jack_buffer_size;         /**< The desired power-of-2 size, or 0. */
+    int m_alsa_queue_lookahead;     /**< ALSA queue scheduling ms, or 0.    */
+    int m_alsa_sysex_rate;          /**< ALSA SysEx bytes/second, or 0.     */
     sequence::playback m_song_start_mode; /**< Song mode versus Live mode.  */
     bool m_song_start_is_auto;      /**< True if "auto" read from 'rc'.     */
     bool m_record_by_buss;          /**< Record into sequence w/input-buss. */
@@ -904,6 +926,11 @@ public:
         return m_thread_priority;
     }
 
+    bool deadline_scheduler () const
+    {
+        return m_deadline_scheduler;
+    }
+
     bool pass_sysex () const
     {
         return m_pass_sysex;
@@ -955,11 +982,31 @@ public:
         return m_jack_use_offset;
     }
 
+    bool jack_pull_mode () const
+    {
+        return m_jack_pull_mode;
+    }
+
     int jack_buffer_size () const
     {
         return m_jack_buffer_size;
     }
 
+    int alsa_queue_lookahead () const
+    {
+        return m_alsa_queue_lookahead;
+    }
+
+    bool alsa_queue_scheduling () const
+    {
+        return m_alsa_queue_lookahead > 0;
+    }
+
+    int alsa_sysex_rate () const
+    {
+        return m_alsa_sysex_rate;
+    }
+
     bool song_start_mode () const
     {
         return m_song_start_mode == sequence::playback::song;
@@ -1022,6 +1069,11 @@ public:
         m_jack_use_offset = flag;
     }
 
+    void jack_pull_mode (bool flag)
+    {
+        m_jack_pull_mode = flag;
+    }
+
     /*
      * This check is the same as is_power_of_2() in the calculations module.
      */
@@ -1032,6 +1084,28 @@ public:
             m_jack_buffer_size = sz;
     }
 
+    /*
+     *  A lookahead of 0 means to send ALSA events directly, the legacy
+     *  behavior.  Missing or out-of-range values are ignored.
+     */
+
+    void alsa_queue_lookahead (int ms)
+    {
+        if (ms >= 0 && ms <= c_alsa_queue_lookahead_max)
+            m_alsa_queue_lookahead = ms;
+    }
+
+    /*
+     *  A rate of 0 sends the chunks of a large SysEx message back to back.
+     *  Missing or out-of-range values are ignored.
+     */
+
+    void alsa_sysex_rate (int bytespersecond)
+    {
+        if (bytespersecond >= 0 && bytespersecond <= c_alsa_sysex_rate_max)
+            m_alsa_sysex_rate = bytespersecond;
+    }
+
     /**
      * \getter m_with_jack_transport m_with_jack_master, and
      * m_with_jack_master_cond, to save client code some trouble.  Do not
@@ -1512,6 +1586,11 @@ public:
         m_thread_priority = p;
     }
 
+    void deadline_scheduler (bool flag)
+    {
+        m_deadline_scheduler = flag;
+    }
+
     void pass_sysex (bool flag)
     {
         m_pass_sysex = flag;
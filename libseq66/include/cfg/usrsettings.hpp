@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-09-22
- * \updates       2025-07-19
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  This module defines the following categories of "global" variables that
@@ -838,6 +838,14 @@ private:
 
     std::string m_user_option_logfile;
 
+    /**
+     *  If not empty, the loaded song is rendered offline to this MIDI file
+     *  by seq66cli, which then exits.  Set by the "-o bounce=filename"
+     *  option, and never saved.  See performer::bounce().
+     */
+
+    std::string m_user_option_bounce;
+
     /**
      *  The full path to PDF and browser executables, in case the system
      *  defaults are not present or are not suitable.
@@ -1020,6 +1028,14 @@ private:
 
     bool m_pattern_wraparound;
 
+    /**
+     *  The most memory, in kilobytes, that the undo/redo log of each pattern
+     *  can hold.  The oldest edits are dropped to stay within it.  If 0,
+     *  there is no limit.
+     */
+
+    int m_undo_budget;
+
     /**
      *  Normal (none = no alteration), tighten, quantize, or note-map (jitter
      *  and random are not supported during recording at this time).
@@ -1670,6 +1686,11 @@ public:
         return m_user_option_logfile;
     }
 
+    const std::string & option_bounce () const
+    {
+        return m_user_option_bounce;
+    }
+
     const std::string & user_pdf_viewer () const
     {
         return m_user_pdf_viewer;
@@ -1912,6 +1933,16 @@ public:
         return m_pattern_wraparound;
     }
 
+    int undo_budget () const
+    {
+        return m_undo_budget;
+    }
+
+    std::size_t undo_budget_bytes () const
+    {
+        return std::size_t(m_undo_budget) * 1024;
+    }
+
     std::string pattern_record_string () const;
 
     /*
@@ -2062,6 +2093,11 @@ public:         // used in main application module and the usrfile class
     void option_use_logfile (bool flag);
     void option_logfile (const std::string & file);
 
+    void option_bounce (const std::string & file)
+    {
+        m_user_option_bounce = file;
+    }
+
     /*
      *  Since these a paths to executable, probably good to provide a full
      *  path, for now we will not enforce that.
@@ -2179,6 +2215,8 @@ public:         // used in main application module and the usrfile class
         m_pattern_wraparound = flag;
     }
 
+    bool undo_budget (int kb);
+
     void grid_mode (gridmode mode)
     {
         m_grid_mode = mode;
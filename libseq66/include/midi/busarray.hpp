@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2026-05-09
- * \updates       2026-05-09
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  The busarray module defines busarray classes so that we can
@@ -45,6 +45,7 @@ namespace seq66
 {
     class event;
     class midibus;
+    class pulseclock;
 
 /**
  *  Holds a number of businfo objects.
@@ -62,6 +63,14 @@ private:
 
     std::vector<businfo> m_container;
 
+    /**
+     *  The input buss at which get_midi_event() starts looking, so that the
+     *  busses are drained round-robin and a busy port cannot starve the
+     *  others.
+     */
+
+    int m_next_input;
+
 public:
 
     busarray ();
@@ -82,8 +91,11 @@ public:
     void stop ();
     void continue_from (midipulse tick);
     void init_clock (midipulse tick);
-    void clock (midipulse tick);
+    void clock (midipulse tick, const pulseclock * pc = nullptr);
     void play (bussbyte bus, const event * e24, midibyte channel);
+    void queue (bussbyte bus, const event * e24, midibyte channel);
+    void commit (const pulseclock & pc);
+    bool try_commit (const pulseclock & pc);
     void sysex (bussbyte bus, const event * ev);
     bool set_clock (bussbyte bus, e_clock clocktype);
     void set_all_clocks ();
@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2016-12-31
- * \updates       2026-05-16
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  The businfo module defines the businfo and busarray classes so that we can
@@ -47,6 +47,7 @@ namespace seq66
 {
     class event;
     class midibus;
+    class pulseclock;
 
 /**
  *  A new class to consolidate a number of bus-related arrays into one array.
@@ -176,7 +177,7 @@ private:
     void stop ();
     void continue_from (midipulse tick);
     void init_clock (midipulse tick);
-    void clock (midipulse tick);
+    void clock (midipulse tick, const pulseclock * pc = nullptr);
     void sysex (const event * ev);
 
 private:
@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-07-24
- * \updates       2025-07-13
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  This module also declares/defines the various constants, status-byte
@@ -398,6 +398,16 @@ private:
 
     iterator m_linked;
 
+    /**
+     *  The position of the linked event in the owning eventlist.  Unlike
+     *  m_linked, this index stays meaningful when the vector reallocates,
+     *  and eventlist adjusts it when it inserts, removes, or sorts events.
+     *  After any such change, eventlist refreshes m_linked from this index,
+     *  so that the links survive without a full verify_and_link().
+     */
+
+    int m_link_index;
+
     /**
      *  Indicates that a link has been made.  This item is used [via
      *  the get_link() and link() accessors] in the sequence class.
@@ -1121,11 +1131,15 @@ public:
      *      Provides a pointer to the event value to set.  Since we're using
      *      an iterator, we can't use a null-pointer test that.  We assume the
      *      caller has checked that the value is not end() for the container.
+     *
+     * \param index
+     *      The position of \a ev in the container, kept in m_link_index.
      */
 
-    void link (iterator ev)
+    void link (iterator ev, int index)
     {
         m_linked = ev;
+        m_link_index = index;
         m_has_link = true;
     }
 
@@ -1134,6 +1148,26 @@ public:
         return m_linked;        /* iterator could be invalid, though    */
     }
 
+    int link_index () const
+    {
+        return m_link_index;
+    }
+
+    /**
+     *  Used by eventlist to move the link index when events are inserted,
+     *  removed, or reordered, and then to refresh the iterator from it.
+     */
+
+    void link_index (int index)
+    {
+        m_link_index = index;
+    }
+
+    void relink (iterator ev)
+    {
+        m_linked = ev;
+    }
+
     bool is_linked () const
     {
         return m_has_link;
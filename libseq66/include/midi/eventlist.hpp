@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-09-19
- * \updates       2025-10-22
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  This module extracts the event-list functionality from the sequencer
@@ -81,6 +81,8 @@
 
 #undef SEQ66_USE_JITTER_EVENTS
 
+#include <functional>                   /* std::function<> for remove_if()  */
+
 #include "midi/event.hpp"               /* seq66::event, event::buffer      */
 
 namespace seq66
@@ -93,6 +95,7 @@ namespace seq66
 class eventlist
 {
     friend class editable_events;       /* access to verify_and_link()      */
+    friend class eventundo;             /* access to m_events, patch_links()*/
     friend class midifile;              /* access to print()                */
     friend class sequence;              /* any_selected_notes()             */
 
@@ -226,6 +229,19 @@ private:
 
     bool m_link_wraparound;
 
+    /**
+     *  The number of leading and trailing events known to be unchanged since
+     *  clean() was called.  The undo log (see eventundo) compares only the
+     *  events in between, so the cost of logging an edit follows the size
+     *  of the edit, not of the list.  A change to the time, status, data,
+     *  or order of events, or to their number, narrows the range.  A change
+     *  that is not tracked exactly, including any access through begin() or
+     *  end(), sets both to 0.  Selection and links are not tracked.
+     */
+
+    int m_clean_head;
+    int m_clean_tail;
+
 public:
 
     eventlist ();
@@ -243,6 +259,7 @@ public:
 
     event::iterator begin ()
     {
+        touch();                        /* the caller can change anything   */
         return m_events.begin();
     }
 
@@ -253,6 +270,7 @@ public:
 
     event::iterator end ()
     {
+        touch();
         return m_events.end();
     }
 
@@ -277,6 +295,7 @@ public:
     midipulse get_min_timestamp () const;
     midipulse get_max_timestamp () const;
     bool add (const event & e);
+    bool add (const event::buffer & evlist);
     bool append (const event & e);
 
     bool empty () const
@@ -323,7 +342,8 @@ public:
     /**
      *  Provides a wrapper for the iterator form of erase(), which is the
      *  only one that sequence uses.  Currently, no check on removal is
-     *  performered.  Sets the modified-flag.
+     *  performered.  The links of the remaining events are adjusted (see
+     *  remove_links()).  Sets the modified-flag.
      *
      * \param ie
      *      Provides the iterator to the event to be removed.
@@ -335,11 +355,42 @@ public:
 
     event::iterator remove (event::iterator ie)
     {
+        int index = int(ie - m_events.begin());
         event::iterator result = m_events.erase(ie);
+        touch(index, index - 1);
+        remove_links(index);
         m_is_modified = true;
         return result;
     }
 
+    /**
+     *  Marks all of the events as unchanged.  See m_clean_head.
+     */
+
+    void clean ()
+    {
+        m_clean_head = m_clean_tail = count();
+    }
+
+    /**
+     *  Marks all of the events as possibly changed.
+     */
+
+    void touch ()
+    {
+        m_clean_head = m_clean_tail = 0;
+    }
+
+    int clean_head () const
+    {
+        return m_clean_head;
+    }
+
+    int clean_tail () const
+    {
+        return m_clean_tail;
+    }
+
     void clear ();
     void sort ();
     bool merge (const eventlist & el, bool presort = true);
@@ -372,6 +423,14 @@ private:                                /* internal quantization functions  */
 
     bool add (event::buffer & evlist, const event & e);
     void merge (const event::buffer & evlist);
+    void merge_tail (std::size_t oldsize);
+    void note_flags (const event & e);
+    void reorder (const std::vector<int> & order);
+    void insert_links (int index);
+    void remove_links (int index);
+    void patch_links ();
+    void touch (int first, int last);
+    bool remove_if (const std::function<bool (const event &)> & pred);
 
 private:                                /* functions for friend sequence    */
 
@@ -419,6 +478,18 @@ private:                                /* functions for friend sequence    */
 #endif
     bool jitter_notes (int snap, int jitr, bool all = false);
     bool link_new (bool wrap = false);
+
+    /**
+     *  Links only the notes that are not yet linked, leaving existing links
+     *  alone.  Since links survive insertion and sorting, this is all that
+     *  is needed after adding events that do not change existing pairings.
+     */
+
+    bool link_unlinked ()
+    {
+        return link_new(m_link_wraparound);
+    }
+
     bool link_notes (event::iterator eon, event::iterator eoff);
 #if defined SEQ66_LINK_NEWEST_NOTE_ON_RECORD
     void link_new_note ();
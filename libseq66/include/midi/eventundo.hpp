@@ -0,0 +1,230 @@
+#if ! defined SEQ66_EVENTUNDO_HPP
+#define SEQ66_EVENTUNDO_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          eventundo.hpp
+ *
+ *  This module declares the undo/redo log of a pattern's events.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-15
+ * \updates       2026-10-15
+ * \license       GNU GPLv2 or above
+ *
+ *  The undo and redo stacks of a sequence used to hold whole copies of the
+ *  eventlist, one per edit, with no limit.  Now each entry holds only the
+ *  range of events that an edit changed:
+ *
+ *      -   The index of the first changed event.
+ *      -   The number of events now in the range.
+ *      -   The events that were in the range before the edit.
+ *      -   The old links of the events outside the range whose links cannot
+ *          be derived by shifting, such as a Note On whose Note Off was in
+ *          the range.
+ *
+ *  Callers still announce an edit before making it, via push().  The log
+ *  keeps a copy of the events as they were at the last push(), undo(), or
+ *  redo(), and compares it to the events at the next one.  The eventlist
+ *  keeps track of how many of its leading and trailing events are unchanged
+ *  (see eventlist::clean()), so only the events in between are compared.
+ *  The unchanged head and tail are trimmed off, and what is left is the
+ *  entry.  The copy is then brought up to date by replacing only that range,
+ *  so it is made in full only once.  Pushes that change nothing leave no
+ *  entry.  What remains linear is one pass over the link indices, which is
+ *  cheaper than the link updates that the edit itself makes.
+ *
+ *  Consecutive edits that follow closely in time, and that only change
+ *  events inside the range of the previous edit, are merged into one entry.
+ *  A drag or a slider thus makes one entry, not hundreds.
+ *
+ *  The entries are kept under a memory budget.  When the budget is
+ *  exceeded, the oldest entries are dropped.
+ */
+
+#include <deque>                        /* std::deque<>                     */
+#include <utility>                      /* std::pair<>                      */
+#include <vector>                       /* std::vector<>                    */
+
+#include "midi/event.hpp"               /* seq66::event, event::buffer      */
+
+namespace seq66
+{
+
+class eventlist;
+
+/**
+ *  One entry of the undo or redo log.  Applying it to the events restores
+ *  the events it was made from, and yields the entry that goes the other
+ *  way.
+ */
+
+class eventdelta
+{
+    friend class eventundo;
+
+public:
+
+    /**
+     *  The position of an event outside the changed range, and its link
+     *  index, or -1 if it was not linked.
+     */
+
+    using linkfix = std::pair<int, int>;
+
+private:
+
+    int m_index;                        /**< First event that changed.      */
+    int m_count;                        /**< Events now in the range.       */
+    event::buffer m_events;             /**< Events formerly in the range.  */
+    std::vector<linkfix> m_links;       /**< Outside links to restore.      */
+    long m_time_ms;                     /**< When the edit was announced.   */
+
+public:
+
+    eventdelta ();
+
+    bool empty () const
+    {
+        return m_count == 0 && m_events.empty() && m_links.empty();
+    }
+
+    std::size_t bytes () const;
+
+};          // class eventdelta
+
+/**
+ *  Holds the undo and redo logs for one eventlist.
+ */
+
+class eventundo
+{
+
+private:
+
+    using deltas = std::deque<eventdelta>;
+
+    /**
+     *  The undo and redo logs.  The newest entry is at the back.
+     */
+
+    deltas m_undo;
+    deltas m_redo;
+
+    /**
+     *  A copy of the events as they were at the last push(), undo(), or
+     *  redo().  The next edit is found by comparing it to the events.  The
+     *  links of the copied events are not kept up to date; their link
+     *  indices are kept in m_pending_links instead.
+     */
+
+    event::buffer m_pending;
+    std::vector<int> m_pending_links;
+
+    /**
+     *  True if m_pending holds a copy.  It is false only until the first
+     *  push(), and after clear().
+     */
+
+    bool m_have_pending;
+
+    /**
+     *  True if the copy was made by push(), which means that an edit is
+     *  coming.  A copy made after an undo or redo only guards against
+     *  changes made without a push(), such as recording.
+     */
+
+    bool m_pending_edit;
+
+    /**
+     *  The time of the push() that made the copy, for merging edits.
+     */
+
+    long m_pending_ms;
+
+    /**
+     *  The memory held by the entries in both logs, and the most it is
+     *  allowed to hold.  A budget of 0 means no limit.
+     */
+
+    std::size_t m_bytes;
+    std::size_t m_budget;
+
+public:
+
+    eventundo (std::size_t budget = 0);
+
+    void push (eventlist & current);
+    void push (eventlist & current, const eventlist & before);
+    bool undo (eventlist & evl);
+    bool redo (eventlist & evl);
+    void clear ();
+
+    void budget (std::size_t bytes)
+    {
+        m_budget = bytes;
+    }
+
+    bool can_undo () const
+    {
+        return m_pending_edit || ! m_undo.empty();
+    }
+
+    bool can_redo () const
+    {
+        return ! m_redo.empty();
+    }
+
+    std::size_t bytes () const
+    {
+        return m_bytes;
+    }
+
+private:
+
+    void commit (eventlist & current);
+    void add (deltas & log, eventdelta && d);
+    void trim ();
+    bool restore (eventlist & evl, deltas & from, deltas & to);
+    void snapshot (eventlist & current, bool edit);
+    void update (const eventlist & current, int index, int oldcount);
+    static bool same_event (const event & e1, const event & e2);
+    static eventdelta diff
+    (
+        const event::buffer & before,
+        const std::vector<int> & beforelinks,
+        const event::buffer & after,
+        int head, int tail
+    );
+    static eventdelta apply (event::buffer & evs, eventdelta & d);
+
+};          // class eventundo
+
+}           // namespace seq66
+
+#endif      // SEQ66_EVENTUNDO_HPP
+
+/*
+ * eventundo.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2016-11-23
- * \updates       2025-05-20
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  The mastermidibase module is the base-class version of the mastermidibus
@@ -36,10 +36,13 @@
  *  PortMidi.
  */
 
+#include <atomic>                       /* std::atomic<bool> batching flag  */
+#include <thread>                       /* std::thread::id of the batcher   */
 #include <vector>                       /* for channel-filtered recording   */
 
 #include "midi/busarray.hpp"            /* seq66::busarray                  */
 #include "midi/midibase.hpp"            /* seq66::midibase::io & recmutex   */
+#include "midi/pulseclock.hpp"          /* seq66::pulseclock                */
 #include "play/clockslist.hpp"          /* list of seq66::e_clock settings  */
 #include "play/inputslist.hpp"          /* list of boolean input settings   */
 
@@ -166,6 +169,32 @@ protected:
 
     sequence * m_seq;
 
+    /**
+     *  Indicates that an output cycle is in progress, started by
+     *  begin_batch().  While it is true, play() and play_and_flush() called
+     *  from the batching thread queue the event on its buss, instead of
+     *  locking, playing, and flushing for each event.  Calls from other
+     *  threads (user-interface, MIDI control output) are not affected.
+     */
+
+    std::atomic<bool> m_batching;
+
+    /**
+     *  The thread that called begin_batch(), normally the output thread.
+     *  Atomic, since other threads read it in batching() while it is set.
+     */
+
+    std::atomic<std::thread::id> m_batch_thread;
+
+    /**
+     *  Maps the pulses of the output thread to monotonic time, so that an
+     *  API that schedules its output can stamp each event with the time of
+     *  its own pulse.  Set and used by the output thread only.  See
+     *  performer::output_func() and commit_batch().
+     */
+
+    pulseclock m_pulse_clock;
+
     /**
      *  The locking mutex.  This object is passed to an automutex object that
      *  lends exception-safety to the mutex locking.
@@ -258,12 +287,26 @@ public:
         return m_seq;
     }
 
+    pulseclock & pulse_clock ()
+    {
+        return m_pulse_clock;
+    }
+
+    const pulseclock & pulse_clock () const
+    {
+        return m_pulse_clock;
+    }
+
     void start ();
     void stop ();
     void port_start (int client, int port);
     void port_exit (int client, int port);
     void play (bussbyte bus, event * e24, midibyte channel);
     void play_and_flush (bussbyte bus, event * e24, midibyte channel);
+    void begin_batch ();
+    void commit_batch ();
+    bool try_commit_batch ();
+    bool set_engine (engine_callback f, void * arg);
     void sysex (bussbyte bus, const event * event);
     void continue_from (midipulse tick);
     void init_clock (midipulse tick);
@@ -435,6 +478,16 @@ protected:
         // no code for portmidi
     }
 
+    /**
+     *  Installs the pull-mode callback, if the MIDI engine supports it.
+     *  Only JACK does.
+     */
+
+    virtual bool api_set_engine (engine_callback /* f */, void * /* arg */)
+    {
+        return false;                   /* no code for base, alsa, portmidi */
+    }
+
     virtual bool api_get_midi_event (event * inev) = 0;
     virtual int api_poll_for_midi ();
 
@@ -451,6 +504,7 @@ protected:
 
 private:
 
+    bool batching () const;
     bool save_clock (bussbyte bus, e_clock clock);
     bool save_input (bussbyte bus, bool inputing);
 
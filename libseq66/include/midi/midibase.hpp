@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2016-11-24
- * \updates       2023-05-14
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  The midibase module is the new base class for the various implementations
@@ -35,8 +35,13 @@
  *  base class for all such classes.
  */
 
+#include <utility>                      /* std::pair<>                      */
+#include <vector>                       /* std::vector<>                    */
+
+#include "midi/event.hpp"               /* seq66::event, for batching       */
 #include "midi/midibus_common.hpp"      /* values and e_clock enumeration   */
 #include "midi/midibytes.hpp"           /* seq66::midibyte alias            */
+#include "midi/pulseclock.hpp"          /* seq66::pulseclock, for batching  */
 #include "util/automutex.hpp"           /* seq66::recmutex recursive mutex  */
 #include "util/basic_macros.h"          /* not_nullptr() macro              */
 
@@ -44,7 +49,6 @@
 
 namespace seq66
 {
-    class event;
 
 /**
  *  This class implements with ALSA version of the midibase object.
@@ -237,6 +241,15 @@ private:
 
     port m_port_type;
 
+    /**
+     *  Holds the events queued for this port during one output cycle, each
+     *  with the channel on which to play it.  Only the output thread adds
+     *  to this container (see queue()), and commit() sends them all under
+     *  one lock with one flush.  The capacity is kept between cycles.
+     */
+
+    std::vector<std::pair<event, midibyte>> m_batch;
+
     /**
      *  Locking mutex. This one is based on std:::recursive_mutex.
      */
@@ -501,11 +514,14 @@ public:
     }
 
     void play (const event * e24, midibyte channel);
+    void queue (const event * e24, midibyte channel);
+    void commit (const pulseclock & pc);
+    bool try_commit (const pulseclock & pc);
     void sysex (const event * e24);
     void flush ();
     void start ();
     void stop ();
-    void clock (midipulse tick);
+    void clock (midipulse tick, const pulseclock * pc = nullptr);
     void continue_from (midipulse tick);
     void init_clock (midipulse tick);
     void print ();
@@ -629,6 +645,20 @@ public:
 
     virtual void api_play (const event * e24, midibyte channel) = 0;
 
+    /**
+     *  Plays an event that is due at the given monotonic time, which is 0
+     *  if not known.  Only an API that schedules its output needs the time;
+     *  the rest just play the event.
+     */
+
+    virtual void api_play_at
+    (
+        const event * e24, midibyte channel, long long /* ns */
+    )
+    {
+        api_play(e24, channel);
+    }
+
     /**
      *  Handles implementation details for SysEx messages.
      *
@@ -658,6 +688,16 @@ protected:
     virtual void api_stop () = 0;
     virtual void api_clock (midipulse tick) = 0;
 
+    /**
+     *  Emits a MIDI clock due at the given monotonic time.  See
+     *  api_play_at().
+     */
+
+    virtual void api_clock_at (midipulse tick, long long /* ns */)
+    {
+        api_clock(tick);
+    }
+
 };          // class midibase
 
 }           // namespace seq66
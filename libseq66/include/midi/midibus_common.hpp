@@ -28,12 +28,14 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-07-24
- * \updates       2023-06-25
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  Defines some midibus constants and the clock_e enumeration.
  */
 
+#include "midi/midibytes.hpp"           /* seq66::midipulse alias           */
+
 namespace seq66
 {
 
@@ -112,6 +114,38 @@ enum class e_clock
 
 };          // enum class e_clock
 
+/**
+ *  Describes one process cycle of a "pull-mode" engine, currently only JACK.
+ *  In pull mode the server's process callback asks the performer for the
+ *  events due in the cycle, instead of the output thread pushing events
+ *  into the port ring-buffers ahead of time.  The MIDI engine fills in the
+ *  first four members, and the performer fills in the last two, so that the
+ *  engine can convert the time-stamp of each event played during the
+ *  callback to an exact frame offset within the cycle.
+ */
+
+class engine_cycle
+{
+
+public:
+
+    unsigned ec_frames;                 /**< Number of frames in the cycle. */
+    unsigned ec_sample_rate;            /**< Frames per second.             */
+    unsigned ec_frame;                  /**< Frame at the start of cycle.   */
+    bool ec_transport;                  /**< ec_frame is transport position.*/
+    double ec_start_tick;               /**< Pulse at the first frame.      */
+    double ec_frames_per_tick;          /**< Frames per pulse, 0 if unset.  */
+
+};
+
+/**
+ *  The function a pull-mode engine calls at the start of each cycle.  The
+ *  arg parameter is the pointer given to mastermidibase::set_engine().  The
+ *  function returns true if it played the cycle.
+ */
+
+using engine_callback = bool (*) (void * arg, engine_cycle & cycle);
+
 /*
  *  Inline free functions.
  */
@@ -0,0 +1,172 @@
+#if ! defined SEQ66_MIDICAPTURE_HPP
+#define SEQ66_MIDICAPTURE_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          midicapture.hpp
+ *
+ *  This module declares a recorder of the events sent to the output busses.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-15
+ * \updates       2026-10-15
+ * \license       GNU GPLv2 or above
+ *
+ *  Exporting a song (midifile::write_song()) rewrites the patterns and
+ *  their triggers into tracks.  That is not what the engine plays: it does
+ *  not see queueing, transposition, tempo events acted on during playback,
+ *  or the metronome.  A "bounce" instead plays the patterns and records
+ *  what comes out.
+ *
+ *  While a midicapture is handed to performer::capture(), the events that
+ *  the patterns play on the capturing thread go to it instead of the master
+ *  buss, which then need not exist.  Each event is stamped with the tick
+ *  set by the caller, and is encoded at once into the track for its buss.
+ *  The result is written as an SMF 1 file: a tempo track, then one track
+ *  per buss that played anything.
+ */
+
+#include <map>                          /* std::map<>                       */
+#include <string>                       /* std::string                      */
+
+#include "midi/midibytes.hpp"           /* seq66::midibytes, midipulse      */
+
+namespace seq66
+{
+    class event;
+
+/**
+ *  Records output events, with their ticks, into SMF tracks.
+ */
+
+class midicapture
+{
+
+private:
+
+    /**
+     *  A track being recorded, already in SMF form, minus the header and
+     *  the End-of-Track event.
+     */
+
+    class track
+    {
+    public:
+
+        midipulse t_last;               /**< The tick of the last event.    */
+        midibytes t_data;               /**< Delta times and messages.      */
+
+        track () :
+            t_last  (0),
+            t_data  ()
+        {
+            // no code
+        }
+    };
+
+    /**
+     *  The tracks for each buss that played something, in buss order.
+     */
+
+    std::map<bussbyte, track> m_tracks;
+
+    /**
+     *  Holds the tempo and time-signature events.
+     */
+
+    track m_tempo_track;
+
+    /**
+     *  The PPQN of the ticks, written to the header.
+     */
+
+    int m_ppqn;
+
+    /**
+     *  The tick given to the events recorded next.
+     */
+
+    midipulse m_tick;
+
+    /**
+     *  The last tempo recorded, so that only changes are recorded.
+     */
+
+    midibpm m_bpm;
+
+    /**
+     *  The number of events recorded, not counting the tempo track.
+     */
+
+    long m_event_count;
+
+    /**
+     *  If true, events are only counted, not recorded.  The benchmark uses
+     *  this to soak up what the patterns play, at little cost and with no
+     *  memory growth.
+     */
+
+    bool m_count_only;
+
+public:
+
+    midicapture (int ppqn, bool countonly = false);
+    midicapture (const midicapture &) = delete;
+    midicapture & operator = (const midicapture &) = delete;
+
+    void tick (midipulse t)
+    {
+        m_tick = t;
+    }
+
+    midipulse tick () const
+    {
+        return m_tick;
+    }
+
+    long event_count () const
+    {
+        return m_event_count;
+    }
+
+    void add (bussbyte bus, const event & ev, midibyte channel);
+    void add_sysex (bussbyte bus, const event & ev);
+    void tempo (midibpm bpm);
+    void time_signature (int beatsperbar, int beatwidth);
+    bool write (const std::string & filename, std::string & errmsg) const;
+
+private:
+
+    void put_delta (track & t);
+    static void put_varinum (midibytes & data, midilong value);
+
+};          // class midicapture
+
+}           // namespace seq66
+
+#endif      // SEQ66_MIDICAPTURE_HPP
+
+/*
+ * midicapture.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-07-24
- * \updates       2025-10-16
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  The Seq24 MIDI file is a standard, Format 1 MIDI file, with some extra
@@ -51,6 +51,7 @@
 #include "midi/midibytes.hpp"           /* midishort, midibyte, etc.        */
 #include "midi/midi_splitter.hpp"       /* seq66::midi_splitter             */
 #include "util/automutex.hpp"           /* seq66::recmutex, automutex       */
+#include "util/mappedfile.hpp"          /* seq66::mappedfile                */
 
 namespace seq66
 {
@@ -164,6 +165,28 @@ private:
 
     midibytes m_data;                   /* std::vector<midibyte>            */
 
+    /**
+     *  True if m_data was filled by preload(), so that parse() does not
+     *  read the file again.
+     */
+
+    bool m_preloaded;
+
+    /**
+     *  The file, mapped into memory, if mapping is supported.  The data is
+     *  then read in place, and m_data is not used.
+     */
+
+    mappedfile m_mapping;
+
+    /**
+     *  The bytes being parsed.  They are those of m_data or of m_mapping,
+     *  and there are m_file_size of them.  All reading goes through this
+     *  pointer, and is checked against m_file_size.
+     */
+
+    const midibyte * m_bytes;
+
     /**
      *  Provides a list of characters.  The class pushes each MIDI byte into
      *  this list using the write_byte() function.  Also note that the write()
@@ -247,6 +270,7 @@ public:
 
     bool write_song (performer & p);
     bool write_one_pattern (performer & p, int track);
+    void preload (midibytes && data);
 
     const std::string & error_message () const
     {
@@ -384,8 +408,19 @@ protected:
     midilong read_long ();
     midilong read_split_long (unsigned & highbytes, unsigned & lowbytes);
     midishort read_short ();
-    midibyte read_byte ();
+    midibyte read_past_end ();
     midilong read_varinum ();
+
+    /**
+     *  Reads one byte and moves past it.  This is done for every byte of
+     *  the file, so the check is inline and the error path is not.
+     */
+
+    midibyte read_byte ()
+    {
+        return m_pos < m_file_size ? m_bytes[m_pos++] : read_past_end() ;
+    }
+
     bool read_byte_array (midibyte * b, size_t len);
     bool read_byte_array (midibytes & b, size_t len);
     bool read_string (std::string & b, size_t len);
@@ -399,7 +434,8 @@ protected:
 
     midibyte peek (size_t ahead = 0) const
     {
-        return m_data[m_pos + ahead];
+        size_t p = m_pos + ahead;
+        return p < m_file_size ? m_bytes[p] : 0 ;
     }
 
     void skip (size_t sz)                       /* compare to read_gap()    */
@@ -508,7 +544,8 @@ extern bool read_midi_file
     const std::string & fn,
     int ppqn,
     std::string & errmsg,
-    bool addtorecent = true
+    bool addtorecent = true,
+    midibytes * preloaded = nullptr
 );
 extern bool write_midi_file
 (
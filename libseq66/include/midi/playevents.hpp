@@ -0,0 +1,226 @@
+#if ! defined SEQ66_PLAYEVENTS_HPP
+#define SEQ66_PLAYEVENTS_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          playevents.hpp
+ *
+ *  This module provides a compact, read-only copy of an eventlist for use
+ *  by the output thread.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-15
+ * \updates       2026-10-15
+ * \license       GNU GPLv2 or above
+ *
+ *  The seq66::event class is rich: besides the timestamp and the three MIDI
+ *  bytes, it holds a SysEx/Meta vector, a link iterator and index, and a
+ *  number of editing flags.  That is fine for editing, but sequence::play()
+ *  only needs the timestamp and the MIDI bytes, and walking full events
+ *  drags all the rest through the cache, once per armed pattern per output
+ *  cycle.
+ *
+ *  The playevents class holds one 16-byte record per event.  SysEx and Meta
+ *  events, which need their data, are copied to a side table, and their
+ *  records refer to it.  The copy is rebuilt lazily, by the output thread,
+ *  the first time it is used after the eventlist has changed.  Editing code
+ *  continues to work with the rich events.
+ */
+
+#include <atomic>                       /* std::atomic<bool>                */
+#include <vector>                       /* std::vector<>                    */
+
+#include "midi/event.hpp"               /* seq66::event, event::buffer      */
+
+namespace seq66
+{
+
+class eventlist;
+
+/**
+ *  Holds the events of a pattern in a compact form for playback.
+ */
+
+class playevents
+{
+
+public:
+
+    /**
+     *  One event as seen by the output thread.  Together with the padding,
+     *  this takes 16 bytes, so that four records fit in a cache line.
+     */
+
+    class record
+    {
+        friend class playevents;
+
+    private:
+
+        midipulse m_timestamp;      /**< The time-stamp of the event.       */
+        midibyte m_status;          /**< The status byte, with channel.     */
+        midibyte m_channel;         /**< Channel, or Meta type, of event.   */
+        midibyte m_data[2];         /**< The two MIDI data bytes.           */
+        int m_extra;                /**< Side-table index, or -1.           */
+
+    public:
+
+        midipulse timestamp () const
+        {
+            return m_timestamp;
+        }
+
+        midibyte status () const
+        {
+            return m_status;
+        }
+
+        midibyte channel () const
+        {
+            return m_channel;
+        }
+
+        midibyte d0 () const
+        {
+            return m_data[0];
+        }
+
+        midibyte d1 () const
+        {
+            return m_data[1];
+        }
+
+        bool is_note () const
+        {
+            return event::is_note_msg(m_status);
+        }
+
+        bool is_note_on () const
+        {
+            return event::mask_status(m_status) == EVENT_NOTE_ON;
+        }
+
+        bool is_note_off () const
+        {
+            return event::mask_status(m_status) == EVENT_NOTE_OFF;
+        }
+
+        /**
+         *  True for SysEx and Meta events, whose full event is kept in the
+         *  side table.
+         */
+
+        bool is_extended () const
+        {
+            return m_extra >= 0;
+        }
+
+    };          // class record
+
+    using records = std::vector<record>;
+
+private:
+
+    /**
+     *  The records, in the same (sorted) order as the eventlist.
+     */
+
+    records m_records;
+
+    /**
+     *  Holds full copies of the SysEx and Meta events.  They are rare, so
+     *  copying them whole is cheap.
+     */
+
+    event::buffer m_extras;
+
+    /**
+     *  The number of events in the eventlist when the records were built.
+     *  A mismatch catches appends that do not mark the pattern as dirty,
+     *  such as those done while reading a MIDI file.
+     */
+
+    int m_source_count;
+
+    /**
+     *  Cleared by invalidate(), which sequence::set_dirty() calls, and set
+     *  by rebuild().
+     */
+
+    std::atomic<bool> m_valid;
+
+public:
+
+    playevents ();
+    playevents (const playevents &) = delete;
+    playevents & operator = (const playevents &) = delete;
+    ~playevents () = default;
+
+    void rebuild (const eventlist & evl);
+    int lower_bound (midipulse ts) const;
+
+    void invalidate ()
+    {
+        m_valid = false;
+    }
+
+    bool stale (int sourcecount) const
+    {
+        return ! m_valid || sourcecount != m_source_count;
+    }
+
+    int count () const
+    {
+        return int(m_records.size());
+    }
+
+    bool empty () const
+    {
+        return m_records.empty();
+    }
+
+    const record & operator [] (int index) const
+    {
+        return m_records[index];
+    }
+
+    const event & extra (const record & r) const
+    {
+        return m_extras[r.m_extra];
+    }
+
+    midipulse last_timestamp () const
+    {
+        return m_records.empty() ? 0 : m_records.back().m_timestamp ;
+    }
+
+};          // class playevents
+
+}           // namespace seq66
+
+#endif      // SEQ66_PLAYEVENTS_HPP
+
+/*
+ * playevents.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,180 @@
+#if ! defined SEQ66_PULSECLOCK_HPP
+#define SEQ66_PULSECLOCK_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          pulseclock.hpp
+ *
+ *  This module declares a mapping of playback pulses to monotonic time.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-15
+ * \updates       2026-10-15
+ * \license       GNU GPLv2 or above
+ *
+ *  The output thread advances the playback tick from the monotonic clock
+ *  (see performer::output_func()), so every pulse has a time at which it is
+ *  due.  This class holds that mapping, an anchor pulse, its time in
+ *  nanoseconds (see nanotime()), and the length of a pulse.  The output
+ *  thread sets it at the start of playback, shifts it when a loop wraps,
+ *  and re-anchors it when the tempo changes, so that the time of a pulse
+ *  does not depend on when the output thread happened to wake up.  An API
+ *  that schedules its output, such as the ALSA queue, stamps each event
+ *  with the time of its own pulse.
+ *
+ *  It is only valid while the ticks follow the monotonic clock; when JACK
+ *  transport or MIDI clock drive the ticks, it is cleared.  It is used by
+ *  the output thread only, and needs no locking.
+ */
+
+#include "midi/midibytes.hpp"           /* seq66::midipulse                 */
+
+namespace seq66
+{
+
+/**
+ *  Maps pulses to monotonic nanoseconds.
+ */
+
+class pulseclock
+{
+
+private:
+
+    /**
+     *  The pulse at the anchor.  It is a double so that re-anchoring at a
+     *  tempo change does not round.
+     */
+
+    double m_anchor_tick;
+
+    /**
+     *  The monotonic time of the anchor pulse, in nanoseconds.
+     */
+
+    long long m_anchor_ns;
+
+    /**
+     *  The length of a pulse at the current tempo and PPQN.
+     */
+
+    double m_ns_per_tick;
+
+    /**
+     *  True between anchor() and clear().
+     */
+
+    bool m_valid;
+
+public:
+
+    pulseclock () :
+        m_anchor_tick   (0.0),
+        m_anchor_ns     (0),
+        m_ns_per_tick   (0.0),
+        m_valid         (false)
+    {
+        // no code
+    }
+
+    bool valid () const
+    {
+        return m_valid;
+    }
+
+    /**
+     *  Starts the mapping, normally when playback starts.
+     *
+     * \param tick
+     *      The pulse due at the given time.
+     *
+     * \param ns
+     *      The monotonic time of that pulse.
+     *
+     * \param nspertick
+     *      The length of a pulse, which must be greater than 0.
+     */
+
+    void anchor (midipulse tick, long long ns, double nspertick)
+    {
+        m_anchor_tick = double(tick);
+        m_anchor_ns = ns;
+        m_ns_per_tick = nspertick;
+        m_valid = nspertick > 0.0;
+    }
+
+    /**
+     *  Changes the length of a pulse from the given time onward.  The pulse
+     *  due at that time is unchanged, so the mapping stays continuous.
+     */
+
+    void retempo (long long ns, double nspertick)
+    {
+        if (m_valid && nspertick > 0.0)
+        {
+            m_anchor_tick += double(ns - m_anchor_ns) / m_ns_per_tick;
+            m_anchor_ns = ns;
+            m_ns_per_tick = nspertick;
+        }
+    }
+
+    /**
+     *  Moves the pulses back by the given amount, without changing their
+     *  times.  Used when playback wraps from the right loop marker to the
+     *  left one, where the pulse after the wrap is due right after the last
+     *  pulse before it.
+     */
+
+    void shift (midipulse ticks)
+    {
+        m_anchor_tick -= double(ticks);
+    }
+
+    void clear ()
+    {
+        m_valid = false;
+    }
+
+    /**
+     *  Gets the monotonic time of a pulse, or 0 if the mapping is not valid.
+     */
+
+    long long time_ns (midipulse tick) const
+    {
+        return m_valid ?
+            m_anchor_ns + (long long)
+            (
+                (double(tick) - m_anchor_tick) * m_ns_per_tick
+            ) : 0 ;
+    }
+
+};          // class pulseclock
+
+}           // namespace seq66
+
+#endif      // SEQ66_PULSECLOCK_HPP
+
+/*
+ * pulseclock.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
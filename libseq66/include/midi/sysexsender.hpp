@@ -0,0 +1,163 @@
+#if ! defined SEQ66_SYSEXSENDER_HPP
+#define SEQ66_SYSEXSENDER_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          sysexsender.hpp
+ *
+ *  This module declares a paced SysEx transmitter with its own thread.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-15
+ * \updates       2026-10-15
+ * \license       GNU GPLv2 or above
+ *
+ *  Slow devices cannot take a large SysEx dump at full speed, so the ALSA
+ *  engine sent dumps in chunks with a sleep after each chunk.  The sleep
+ *  was done by the caller, which during playback is the output thread, so a
+ *  4 KB patch dump in a pattern stopped playback for over a second.
+ *
+ *  A sysexsender belongs to one output port.  The caller hands it a dump
+ *  and returns at once.  The sender's thread sends the dump a chunk at a
+ *  time, through a function provided by the port, and paces the chunks to
+ *  a byte rate.  Between chunks, the output thread is free to send the
+ *  channel messages of the port, so they are interleaved with the dump
+ *  rather than held up by it.  Dumps are sent in the order given.  When a
+ *  dump is done, or fails, an optional function is called with its ID.
+ */
+
+#include <condition_variable>           /* std::condition_variable          */
+#include <deque>                        /* std::deque<>                     */
+#include <functional>                   /* std::function<>                  */
+#include <mutex>                        /* std::mutex, std::unique_lock<>   */
+#include <thread>                       /* std::thread                      */
+
+#include "midi/event.hpp"               /* seq66::event::sysex              */
+
+namespace seq66
+{
+
+/**
+ *  Sends SysEx dumps in paced chunks from a thread of its own.
+ */
+
+class sysexsender
+{
+
+public:
+
+    /**
+     *  Sends one chunk of a dump.  The first chunk starts with 0xF0, the
+     *  last one ends with 0xF7.  Returns false if the chunk could not be
+     *  sent, which abandons the rest of the dump.
+     */
+
+    using chunker = std::function<bool (const midibyte *, int)>;
+
+    /**
+     *  Called, on the sender's thread, when a dump has been sent or
+     *  abandoned.  The parameters are the ID returned by send() and a
+     *  success flag.
+     */
+
+    using notifier = std::function<void (unsigned, bool)>;
+
+private:
+
+    /**
+     *  A dump waiting to be sent.
+     */
+
+    class dump
+    {
+    public:
+
+        unsigned d_id;                  /**< The ID given by send().        */
+        event::sysex d_data;            /**< The whole message, F0 to F7.   */
+
+        dump (unsigned id, const event::sysex & data) :
+            d_id    (id),
+            d_data  (data)
+        {
+            // no code
+        }
+    };
+
+    chunker m_chunker;                  /**< Sends one chunk to the port.   */
+    notifier m_notifier;                /**< Reports a finished dump.       */
+    int m_chunk_size;                   /**< The largest chunk, in bytes.   */
+    int m_byte_rate;                    /**< Bytes per second, 0 = no limit.*/
+
+    /**
+     *  The dumps not yet finished.  The front one is being sent; it is
+     *  removed only when done, so that pending() counts it.
+     */
+
+    std::deque<dump> m_dumps;
+
+    /**
+     *  Guards m_dumps, m_next_id, and m_stop, and, with m_wakeup, lets the
+     *  thread sleep until there is work or until it must quit.
+     */
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    bool m_stop;
+    unsigned m_next_id;
+
+    /**
+     *  The transmission thread.  It is started by the constructor.
+     */
+
+    std::thread m_thread;
+
+public:
+
+    sysexsender
+    (
+        chunker sendchunk,
+        int chunksize,
+        int byterate,
+        notifier done = nullptr
+    );
+    sysexsender (const sysexsender &) = delete;
+    sysexsender & operator = (const sysexsender &) = delete;
+    ~sysexsender ();
+
+    unsigned send (const event::sysex & data);
+    int pending () const;
+
+private:
+
+    void run ();
+
+};          // class sysexsender
+
+}           // namespace seq66
+
+#endif      // SEQ66_SYSEXSENDER_HPP
+
+/*
+ * sysexsender.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
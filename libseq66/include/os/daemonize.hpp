@@ -23,7 +23,7 @@
  * \file          daemonize.hpp
  * \author        Chris Ahlstrom
  * \date          2005-07-03 to 2007-08-21 (from xpc-suite project)
- * \updates       2026-05-19
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *    Daemonization of POSIX C Wrapper (PSXC) library
@@ -134,6 +134,7 @@ extern bool session_setup (bool earlyexit = false);
 extern bool session_close ();
 extern bool session_save ();
 extern bool session_restart ();
+extern bool session_report ();
 
 /*
  *  Useful for the performer to flag an application exit.  Be freakin' careful
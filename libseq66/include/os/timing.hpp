@@ -23,7 +23,7 @@
  * \file          timing.hpp
  * \author        Chris Ahlstrom
  * \date          2005-07-03 to 2007-08-21 (from xpc-suite project)
- * \updates       2026-05-19
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *    Daemonization of POSIX C Wrapper (PSXC) library
@@ -50,6 +50,8 @@ extern bool millisleep (int ms);
 extern void thread_yield ();
 extern long microtime ();
 extern long millitime ();
+extern long long nanotime ();
+extern bool sleep_until (long long deadline_ns);
 extern bool set_thread_priority (std::thread & t, int p = 1);
 extern bool set_timer_services (bool on);
 
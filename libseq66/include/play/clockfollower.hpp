@@ -0,0 +1,168 @@
+#if ! defined SEQ66_CLOCKFOLLOWER_HPP
+#define SEQ66_CLOCKFOLLOWER_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          clockfollower.hpp
+ *
+ *  This module declares a follower for incoming MIDI clock.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-15
+ * \updates       2026-10-15
+ * \license       GNU GPLv2 or above
+ *
+ *  When following external MIDI clock, each 0xF8 message used to add a
+ *  clock's worth of ticks (8 at 192 PPQN) to a counter, and the output
+ *  thread handed that counter out as its delta-tick.  Playback thus moved
+ *  in clock-sized jumps, with the jitter of every arrival, and there was no
+ *  estimate of the tempo.
+ *
+ *  The clockfollower runs the arrival times of the clocks through a
+ *  second-order delay-locked loop (see F. Adriaensen, "Using a DLL to
+ *  filter time", 2005).  The loop yields a filtered time for each clock and
+ *  a filtered clock period, from which it predicts the time of the next
+ *  clock.  The output thread asks for the position at the current time,
+ *  which is interpolated between the filtered time of the last clock and
+ *  the predicted time of the next one.
+ *
+ *  The position never reaches the tick of a clock that has not arrived, so
+ *  the ticks handed out never get ahead of the master.  If the master slows
+ *  down, playback waits at the last tick before the next clock; if it
+ *  speeds up, the arrival of the clock catches the position up.
+ */
+
+#include <atomic>                       /* std::atomic<double>              */
+
+#include "midi/midibytes.hpp"           /* seq66::midipulse, midibpm        */
+#include "util/automutex.hpp"           /* seq66::recmutex, automutex       */
+
+namespace seq66
+{
+
+/**
+ *  Estimates the position and tempo of an external MIDI clock.  The input
+ *  thread calls clock() and the output thread calls advance(), so they are
+ *  locked; the work done under the lock is a few arithmetic operations.
+ *  The tempo estimate is also read by the user interface and the JACK
+ *  timebase callback, which must not block, so it is kept in an atomic.
+ */
+
+class clockfollower
+{
+
+private:
+
+    /**
+     *  Protects the members from concurrent access by the input thread,
+     *  the output thread, and the user interface.
+     */
+
+    mutable recmutex m_mutex;
+
+    /**
+     *  True between start() and stop().  Clocks that arrive while stopped
+     *  are ignored, as the MIDI specification requires.
+     */
+
+    bool m_running;
+
+    /**
+     *  True once the period is known, so that positions can be
+     *  interpolated.  It takes two clocks after the first start(); after a
+     *  restart, the period from before is reused and one clock suffices.
+     */
+
+    bool m_locked;
+
+    /**
+     *  The number of ticks in one clock, 8 at the default PPQN of 192.
+     */
+
+    int m_ticks_per_clock;
+
+    /**
+     *  The number of clocks received since the start.
+     */
+
+    long m_clocks;
+
+    /**
+     *  The whole ticks handed out by advance() since the start.
+     */
+
+    midipulse m_handed_out;
+
+    /**
+     *  The filtered time of the last clock, the predicted time of the next
+     *  clock, and the filtered clock period, all in microseconds.  These
+     *  are t0, t1, and e2 of the DLL paper.
+     */
+
+    double m_t0;
+    double m_t1;
+    double m_period;
+
+    /**
+     *  The tempo in quarter notes per minute, from m_period, or 0 if not
+     *  running or not locked.
+     */
+
+    std::atomic<double> m_bpm;
+
+public:
+
+    clockfollower ();
+    clockfollower (const clockfollower &) = delete;
+    clockfollower & operator = (const clockfollower &) = delete;
+
+    void start (int ticksperclock);
+    void stop ();
+    void clock (long arrival_us);
+    midipulse advance (long now_us);
+
+    midibpm bpm () const
+    {
+        return m_bpm.load(std::memory_order_relaxed);
+    }
+
+    bool locked () const
+    {
+        automutex locker(m_mutex);
+        return m_running && m_locked;
+    }
+
+private:
+
+    midipulse position (long now_us) const;
+
+};          // class clockfollower
+
+}           // namespace seq66
+
+#endif      // SEQ66_CLOCKFOLLOWER_HPP
+
+/*
+ * clockfollower.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
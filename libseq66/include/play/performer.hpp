@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-11-13
- * \updates       2026-05-09
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  The main player!  Coordinates sets, patterns, mutes, playlists, you name
@@ -53,6 +53,7 @@
 #include "ctrl/opcontainer.hpp"         /* class seq66::opcontainer         */
 #include "midi/jack_assistant.hpp"      /* optional seq66::jack_assistant   */
 #include "midi/mastermidibus.hpp"       /* seq66::mastermidibus ALSA/JACK   */
+#include "play/clockfollower.hpp"       /* seq66::clockfollower             */
 #include "play/metro.hpp"               /* seq66::metro metronome pattern   */
 #include "play/playlist.hpp"            /* seq66::playlist                  */
 #include "play/sequence.hpp"            /* seq66::sequence                  */
@@ -81,6 +82,7 @@ const int c_transpose_up_limit   =  60; /* -c_transpose_down_limit          */
  */
 
 class keystroke;
+class midicapture;
 class notemapper;
 class rcsettings;
 class usrsettings;
@@ -188,6 +190,36 @@ public:
 
     };
 
+    /**
+     *  Wakes the song thread when it has a request to handle, or when the
+     *  application is exiting.  See song_func().
+     */
+
+    class song_synch : public synchronizer
+    {
+
+    private:
+
+        performer & m_perf;
+
+    public:
+
+        song_synch (performer & p) : synchronizer (), m_perf (p)
+        {
+            // no code
+        }
+
+        song_synch () = delete;
+        song_synch (const song_synch &) = delete;
+        song_synch & operator =(const song_synch &) = delete;
+
+        virtual bool predicate () const override
+        {
+            return m_perf.song_requested() || m_perf.done();
+        }
+
+    };
+
     /**
      *  A nested class used for notification of group-learn and other changes.
      *  The easiest way to use this class is by inheriting from it, then
@@ -649,6 +681,35 @@ private:                            /* key, midi, and op container section  */
 
     bool m_in_thread_launched;
 
+    /**
+     *  The song thread does the playlist work that must not be done by the
+     *  output thread: it changes the song when auto-advance reaches the end
+     *  of the current one, and reads the next song file ahead.  The output
+     *  thread only posts the request.  See song_func().
+     */
+
+    std::thread m_song_thread;
+    bool m_song_thread_launched;
+
+    /**
+     *  The requests to the song thread: the move to the next song, and the
+     *  file to read ahead, which is held in m_preload_request.
+     */
+
+    std::atomic<bool> m_song_advance;
+    std::atomic<bool> m_song_preload;
+
+    /**
+     *  The song file to read ahead, and the one read, with its contents.
+     *  The lock is held only to swap them, never while the file is read.
+     *  See take_preload().
+     */
+
+    mutable recmutex m_preload_mutex;
+    std::string m_preload_request;
+    std::string m_preload_name;
+    midibytes m_preload_data;
+
     /**
      *  Indicates merely that the input and output thread functions can keep
      *  running.  Replaces m_inputing and m_outputing.
@@ -664,6 +725,81 @@ private:                            /* key, midi, and op container section  */
 
     std::atomic<bool> m_is_running;
 
+    /**
+     *  True if JACK pull mode is active.  Then the JACK process callback,
+     *  not the output thread, plays the patterns, with each event written at
+     *  its exact frame in the cycle.  See pull_cycle().  Enabled by the 'rc'
+     *  setting "jack-pull-mode".
+     */
+
+    std::atomic<bool> m_pull_mode;
+
+    /**
+     *  Set by the output thread when playback starts, once the starting tick
+     *  is settled, to tell the process callback to start from that tick.
+     */
+
+    std::atomic<bool> m_pull_rebase;
+    std::atomic<midipulse> m_pull_start_tick;
+
+    /**
+     *  Published by the process callback for the output thread: the tick at
+     *  the end of the last cycle, and the MIDI clock tick, which ignores
+     *  looping.
+     */
+
+    std::atomic<midipulse> m_pull_tick;
+    std::atomic<midipulse> m_pull_clock_tick;
+
+    /**
+     *  A tempo change met by the process callback in a tempo meta-event,
+     *  left for the output thread to apply (see post_beats_per_minute()),
+     *  as setting the tempo locks the master buss and notifies the GUIs.
+     *  It is 0 if there is none.
+     */
+
+    std::atomic<midibpm> m_pull_bpm;
+
+    /**
+     *  True while the process callback is in pull_cycle().  Together with
+     *  m_pull_holds, it lets another thread wait until the callback is out
+     *  of the patterns before replacing them.  See pull_hold().
+     */
+
+    std::atomic<bool> m_pull_in_cycle;
+    std::atomic<int> m_pull_holds;
+
+    /*
+     *  The state of the pull-mode timing, used only by the process callback.
+     */
+
+    bool m_pull_started;            /**< Playing cycles since a rebase.     */
+    bool m_pull_transport;          /**< Last cycle used transport frames.  */
+    unsigned m_pull_base_frame;     /**< Frame at which m_pull_base_tick is.*/
+    unsigned m_pull_next_frame;     /**< Expected frame of the next cycle.  */
+    double m_pull_base_tick;        /**< Tick at m_pull_base_frame.         */
+    double m_pull_ticks_per_frame;  /**< From tempo, PPQN and sample rate.  */
+    double m_pull_clock;            /**< Running MIDI clock tick.           */
+    midipulse m_pull_last_tick;     /**< Last tick played by the callback.  */
+
+    /**
+     *  If not null, the events played by the patterns on m_capture_thread
+     *  are recorded here, and the master buss, which need not exist, is not
+     *  used.  Set by bounce() and by the benchmark; see capture().  While it
+     *  is set, the patterns do not sleep when they wrap around, since
+     *  nothing waits on a clock, and MIDI input is dropped.  Not owned.
+     */
+
+    std::atomic<midicapture *> m_capture;
+
+    /**
+     *  The thread that called capture(), the only one whose events are
+     *  recorded.  It is stored before m_capture is set, and is not changed
+     *  while m_capture is set.
+     */
+
+    std::atomic<std::thread::id> m_capture_thread;
+
     /**
      *  Indicates that a pattern is playing.  It replaces rc_settings ::
      *  is_pattern_playing(), which is gone, since the performer is now
@@ -949,10 +1085,11 @@ private:                            /* key, midi, and op container section  */
     bool m_midiclockrunning;
 
     /**
-     *  More MIDI clock support.
+     *  Follows the incoming MIDI clock, smoothing its position and estimating
+     *  its tempo.  Replaces the raw count of clock ticks.
      */
 
-    int m_midiclocktick;
+    clockfollower m_clock_follower;
 
     /**
      *  We need to adjust the clock increment for the PPQN that is in force.
@@ -1006,6 +1143,12 @@ private:                            /* key, midi, and op container section  */
 
     synch m_condition_var;
 
+    /**
+     *  Signalled when a request is posted to the song thread.
+     */
+
+    song_synch m_song_var;
+
 #if SEQ66_JACK_SUPPORT
 
     /**
@@ -1240,7 +1383,8 @@ public:
     (
         const std::string & fn,
         std::string & errmsg,
-        bool addtorecent = true
+        bool addtorecent = true,
+        midibytes * preloaded = nullptr
     );
 
     const playset & play_set () const
@@ -1831,6 +1975,35 @@ public:
         return m_is_running;
     }
 
+    /**
+     *  True if the JACK process callback is playing the patterns.  Not when
+     *  following MIDI clock, which the output thread must track.
+     */
+
+    bool pull_mode () const
+    {
+        return m_pull_mode && ! m_usemidiclock;
+    }
+
+    /**
+     *  True if the output thread keeps the pulse clock of the master buss,
+     *  so that the events it plays should carry their own pulse.  See
+     *  sequence::play().
+     */
+
+    bool pulse_stamps () const
+    {
+        return m_master_bus && m_master_bus->pulse_clock().valid();
+    }
+
+    bool bouncing () const
+    {
+        return not_nullptr(m_capture.load());
+    }
+
+    void capture (midicapture * mc);
+    midicapture * capturing () const;
+
     /*
      *  Used in conjunction with user-interface control of playback (start,
      *  stop, pause).
@@ -2312,6 +2485,7 @@ public:
     void auto_play ();
     void play_all_sets (midipulse tick);
     void play (midipulse tick);
+    bool bounce (const std::string & filename, std::string & errmsg);
     void all_notes_off ();
 
     void unqueue_sequences (int hotseq)
@@ -2462,6 +2636,7 @@ public:
         return master_bus() ? master_bus()->get_beats_per_minute() : bpm() ;
     }
 
+    midibpm midi_clock_bpm () const;
     int get_ppqn_from_master_bus () const;
 
     midibpm update_tap_bpm ();
@@ -3413,6 +3588,7 @@ public:         /* GUI-support functions */
     }
 
     bool set_beats_per_minute (midibpm bp, bool user_change = false);
+    void post_beats_per_minute (midibpm bp);
     bool set_ppqn (int p);
     bool change_ppqn (int p);
     bool ui_change_set_bus (int b);
@@ -3499,6 +3675,7 @@ public:                                 /* access functions for the containers *
     bool midi_control_event (const event & ev, bool recording = false);
     void signal_save ();
     void signal_quit ();
+    bool write_timing_report ();
 
     /*
      * Looks up the slot-key (hot-key) for the given pattern number.
@@ -3641,14 +3818,32 @@ private:
 private:
 
     void output_func ();
+    static bool pull_callback (void * arg, engine_cycle & cycle);
+    bool pull_cycle (engine_cycle & cycle);
+    void pull_play (midipulse tick);
+    void pull_wrap (midipulse tick);
+    void pull_start (midipulse tick);
+    void pull_output ();
+    void pull_hold ();
+    void pull_release ();
     void input_func ();
     bool poll_cycle ();
     void launch_input_thread ();
     void launch_output_thread ();
+    void launch_song_thread ();
+    void song_func ();
+    void post_song_advance ();
+    void post_preload (const std::string & fname);
+    bool take_preload (const std::string & fname, midibytes & data);
+
+    bool song_requested () const
+    {
+        return m_song_advance || m_song_preload;
+    }
     void midi_start ();
     void midi_continue ();
     void midi_stop ();
-    void midi_clock ();
+    void midi_clock (const event & ev);
     void midi_song_pos (const event & ev);
     void midi_sysex (const event & ev);
     bool start_count_in ();
@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-08-26
- * \updates       2025-06-16
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  * \todo
@@ -528,6 +528,7 @@ private:
      */
 
     bool check_song_list (const play_list_t & plist);
+    void preload_next_song ();
     bool add_list (const play_list_t & plist);
     void show_list (const play_list_t & pl) const;
 
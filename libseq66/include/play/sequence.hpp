@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-07-30
- * \updates       2026-06-05
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  The functions add_list_var() and add_long_list() have been replaced by
@@ -39,7 +39,7 @@
  */
 
 #include <atomic>                       /* std::atomic<bool> for dirt       */
-#include <stack>                        /* std::stack<eventlist>            */
+#include <memory>                       /* std::shared_ptr<>                */
 #include <string>                       /* std::string                      */
 
 #include "seq66_features.hpp"           /* various feature #defines         */
@@ -47,6 +47,8 @@
 #include "ctrl/midimacro.hpp"           /* seq66::midimacro                 */
 #include "midi/calculations.hpp"        /* seq66::lengthfix, alteration     */
 #include "midi/eventlist.hpp"           /* seq66::eventlist                 */
+#include "midi/eventundo.hpp"           /* seq66::eventundo undo/redo log   */
+#include "midi/playevents.hpp"          /* seq66::playevents                */
 #include "play/triggers.hpp"            /* seq66::triggers, etc.            */
 #include "util/automutex.hpp"           /* seq66::recmutex, automutex       */
 
@@ -368,7 +370,7 @@ public:
            return ni_selected;
        }
 
-       bool non_note ()
+       bool non_note () const
        {
            return ni_non_note;
        }
@@ -377,14 +379,91 @@ public:
 
     };      // nested class note_info
 
-private:
+    /**
+     *  One drawable event, as found by get_next_note(): its kind, and its
+     *  note information.
+     */
+
+    class drawn_note
+    {
+        friend class sequence;
+
+    private:
+
+        draw dn_type;
+        note_info dn_info;
+
+    public:
+
+        drawn_note (draw dt, const note_info & ni) :
+            dn_type (dt),
+            dn_info (ni)
+        {
+            // no code
+        }
+
+        draw type () const
+        {
+            return dn_type;
+        }
+
+        const note_info & info () const
+        {
+            return dn_info;
+        }
+
+    };      // nested class drawn_note
 
     /**
-     *  Provides a stack of event-lists for use with the undo and redo
-     *  facility.
+     *  An immutable copy of the drawable events of the pattern, for the
+     *  user-interface.  See get_draw_snapshot().
      */
 
-    using eventstack = std::stack<eventlist>;
+    class draw_snapshot
+    {
+        friend class sequence;
+
+    public:
+
+        using notes = std::vector<drawn_note>;
+
+    private:
+
+        unsigned ds_version;        /* the m_draw_version it was built at   */
+        notes ds_notes;
+
+    public:
+
+        draw_snapshot (unsigned version) :
+            ds_version  (version),
+            ds_notes    ()
+        {
+            // no code
+        }
+
+        unsigned version () const
+        {
+            return ds_version;
+        }
+
+        notes::const_iterator begin () const
+        {
+            return ds_notes.cbegin();
+        }
+
+        notes::const_iterator end () const
+        {
+            return ds_notes.cend();
+        }
+
+        int count () const
+        {
+            return int(ds_notes.size());
+        }
+
+    };      // nested class draw_snapshot
+
+    using draw_snapshot_ptr = std::shared_ptr<const draw_snapshot>;
 
 public:
 
@@ -501,16 +580,11 @@ private:
     bool m_have_redo;
 
     /**
-     *  Provides a list of event actions to undo.
-     */
-
-    eventstack m_events_undo;
-
-    /**
-     *  Provides a list of event actions to redo.
+     *  Provides the log of event changes to undo and redo.  Each entry holds
+     *  only the events changed by one edit.  See the eventundo module.
      */
 
-    eventstack m_events_redo;
+    eventundo m_events_undo;
 
     /**
      *  A new feature for recording, based on a "stazed" feature.  If true
@@ -829,6 +903,52 @@ private:
     midipulse m_queued_tick;        /**< Provides the tick for queuing.     */
     midipulse m_trigger_offset;     /**< Provides the trigger offset.       */
 
+    /**
+     *  A loop wrap that the JACK process callback could not apply because
+     *  the pattern was locked.  See try_loop_wrap().  The tick and mode are
+     *  written by the callback before it sets the flag, and read by it
+     *  after clearing the flag; set_last_tick() drops a stale wrap.
+     */
+
+    std::atomic<bool> m_wrap_pending;
+    midipulse m_wrap_tick;          /**< The left tick of the pending wrap. */
+    bool m_wrap_songmode;           /**< The playback mode of the wrap.     */
+
+    /**
+     *  These members implement a persistent play cursor.  Rather than
+     *  walking m_events from the beginning in every output frame, play()
+     *  and live_play() resume at the event that was due next at the end of
+     *  the previous frame.  The cursor is checked against the expected
+     *  start of the frame, the pattern length, and the event count, and is
+     *  marked stale by any edit (see set_dirty()).  A stale cursor is
+     *  relocated by a binary search of the sorted event list.
+     */
+
+    int m_play_index;               /**< Index of the next event to check.  */
+    midipulse m_play_offset_base;   /**< The loop offset of that event.     */
+    midipulse m_play_next_tick;     /**< The expected next frame start.     */
+    midipulse m_play_length;        /**< The pattern length when saved.     */
+    int m_play_count;               /**< The event count when saved.        */
+    std::atomic<bool> m_play_cursor_valid;  /**< Cleared by set_dirty().    */
+
+    /**
+     *  A compact copy of m_events that play() and live_play() scan instead
+     *  of the full events.  It is marked stale along with the play cursor,
+     *  and is rebuilt by the next play() call.  The play cursor indexes it.
+     */
+
+    playevents m_play_events;
+
+    /**
+     *  The latest copy of the drawable events, shared with the user-interface
+     *  and swapped atomically; see get_draw_snapshot().  Each change to the
+     *  events or their selection increments m_draw_version, which marks the
+     *  copy as stale.
+     */
+
+    mutable draw_snapshot_ptr m_draw_snapshot;
+    std::atomic<unsigned> m_draw_version;
+
     /**
      *  This constant provides the scaling used to calculate the time position
      *  in ticks (pulses), based also on the PPQN value.  Hardwired to
@@ -1281,7 +1401,7 @@ public:
 
     void set_have_redo ()
     {
-        m_have_redo = m_events_redo.size() > 0;
+        m_have_redo = m_events_undo.can_redo();
     }
 
     bool have_redo () const
@@ -1750,6 +1870,8 @@ public:
     void play (midipulse tick, bool playback_mode, bool resume = false);
     void live_play (midipulse tick);
     void play_queue (midipulse tick, bool playbackmode, bool resume);
+    bool try_play_queue (midipulse tick, bool playbackmode, bool resume);
+    bool try_loop_wrap (midipulse tick, bool songmode);
     bool push_add_note
     (
         midipulse tick, midipulse len, int note,
@@ -1808,6 +1930,7 @@ public:
     );
     bool add_event (midipulse tick, const midibytes & dbytes);
     bool add_macro (midipulse tick, const midimacro & macro);
+    bool add_events (const event::buffer & evlist);
     bool append_event (const event & er);
     void sort_events ();
     event find_event (const event & e, bool nextmatch = false);
@@ -2032,6 +2155,7 @@ public:
     void stop (bool song_mode = false);     /* playback::live vs song   */
     void pause (bool song_mode = false);    /* playback::live vs song   */
     void reset_draw_trigger_marker ();
+    void reset_draw_trigger_marker (midipulse tick);
     bool clear_events ();
     void draw_lock () const;
     void draw_unlock () const;
@@ -2057,6 +2181,18 @@ public:
         note_info & niout,
         event::buffer::const_iterator & evi
     ) const;
+    draw_snapshot_ptr get_draw_snapshot () const;
+
+    /**
+     *  Cheap check for a change of the drawable events, for callers that
+     *  cache what they draw from the snapshot.
+     */
+
+    unsigned draw_version () const
+    {
+        return m_draw_version.load(std::memory_order_acquire);
+    }
+
     bool get_next_event_match
     (
         midibyte status, midibyte cc,
@@ -2171,6 +2307,27 @@ public:
 
 private:
 
+    int play_cursor
+    (
+        midipulse starttick, midipulse & offsetbase,
+        midipulse len, int & count
+    );
+    void save_play_cursor
+    (
+        int index, midipulse offsetbase,
+        midipulse nexttick, midipulse len
+    );
+
+    void reset_play_cursor ()
+    {
+        m_play_cursor_valid = false;
+    }
+
+    void invalidate_draw_snapshot ()
+    {
+        m_draw_version.fetch_add(1, std::memory_order_release);
+    }
+
     bool flatten (sequence & destseq, bool maketrigger = true);
     midipulse flatten_trigger
     (
@@ -2222,6 +2379,11 @@ private:
     bool quantize_notes (int divide = 1);
     bool change_ppqn (int p);
     void put_event_on_bus (const event & ev);
+    void send_on_bus (event & ev, midibyte channel, bool flush = true);
+    void put_record_on_bus
+    (
+        const playevents::record & r, midipulse tick, int transpose = 0
+    );
     void set_trigger_offset (midipulse trigger_offset);
     void adjust_trigger_offsets_to_length (midipulse newlen);
     midipulse adjust_offset (midipulse offset);
@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-10-30
- * \updates       2023-12-20
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  By segregating trigger support into its own module, the sequence class is
@@ -559,6 +559,17 @@ public:
         m_draw_iterator = m_triggers.begin();
     }
 
+    /**
+     *  Sets the draw-trigger iterator to the last trigger starting at or
+     *  before the given tick, so that drawing can skip the triggers that
+     *  end before the visible area.
+     */
+
+    void reset_draw_trigger_marker (midipulse tick)
+    {
+        m_draw_iterator = play_start(tick);
+    }
+
     void set_trigger_paste_tick (midipulse tick)
     {
         m_paste_tick = tick;
@@ -572,6 +583,7 @@ public:
 private:
 
     void sort ();
+    container::iterator play_start (midipulse tick);
     bool split (trigger & t, midipulse splittick);
     bool rescale (int oldppqn, int newppqn);
     midipulse adjust_offset (midipulse offset);
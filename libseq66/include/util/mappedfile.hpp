@@ -0,0 +1,107 @@
+#if ! defined SEQ66_MAPPEDFILE_HPP
+#define SEQ66_MAPPEDFILE_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          mappedfile.hpp
+ *
+ *  This module declares a read-only memory mapping of a whole file.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-15
+ * \updates       2026-10-15
+ * \license       GNU GPLv2 or above
+ *
+ *  The midifile class used to copy every file into a vector before parsing
+ *  it.  For a large file, that is an allocation and a copy of megabytes that
+ *  are read only once.  A mappedfile lets the parser read the bytes where
+ *  the kernel already has them.
+ *
+ *  Mapping is supported on POSIX systems only.  Elsewhere, or if mapping
+ *  fails, open() returns false and the caller reads the file as before.
+ */
+
+#include <cstddef>                      /* std::size_t                      */
+#include <string>                       /* std::string                      */
+
+#include "midi/midibytes.hpp"           /* seq66::midibyte                  */
+
+namespace seq66
+{
+
+/**
+ *  Maps a file read-only, for as long as the object lives or until close().
+ */
+
+class mappedfile
+{
+
+private:
+
+    /**
+     *  The start of the mapping, or null if nothing is mapped.
+     */
+
+    const midibyte * m_data;
+
+    /**
+     *  The size of the mapping, which is the size of the file.
+     */
+
+    std::size_t m_size;
+
+public:
+
+    mappedfile ();
+    mappedfile (const mappedfile &) = delete;
+    mappedfile & operator = (const mappedfile &) = delete;
+    ~mappedfile ();
+
+    bool open (const std::string & filename);
+    void close ();
+
+    bool mapped () const
+    {
+        return m_data != nullptr;
+    }
+
+    const midibyte * data () const
+    {
+        return m_data;
+    }
+
+    std::size_t size () const
+    {
+        return m_size;
+    }
+
+};          // class mappedfile
+
+}           // namespace seq66
+
+#endif      // SEQ66_MAPPEDFILE_HPP
+
+/*
+ * mappedfile.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
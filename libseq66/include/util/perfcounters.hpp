@@ -0,0 +1,224 @@
+#if ! defined SEQ66_PERFCOUNTERS_HPP
+#define SEQ66_PERFCOUNTERS_HPP
+
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          perfcounters.hpp
+ *
+ *  This module declares lock-free timing counters for the I/O threads.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-15
+ * \updates       2026-10-15
+ * \license       GNU GPLv2 or above
+ *
+ *  The only timing information used to be the last underrun shown in the
+ *  main window, plus some prints in debug builds.  These counters are always
+ *  compiled in.  Each one is an atomic that is updated with a relaxed
+ *  fetch-add, a few nanoseconds, so that the output thread, the input
+ *  thread, and the JACK process callback can record freely.  Any thread can
+ *  read them; a report is a snapshot, not an exact cut across all counters.
+ *
+ *  The report can be seen in the "Build Info" dialog of the main window,
+ *  is written to "timing.log" in the configuration directory upon receipt
+ *  of SIGUSR2, and is shown at exit in verbose mode.
+ */
+
+#include <atomic>                       /* std::atomic<>                    */
+#include <string>                       /* std::string                      */
+
+#include "midi/midibytes.hpp"           /* seq66::bussbyte, c_busscount_max */
+
+namespace seq66
+{
+
+/**
+ *  A histogram with power-of-two buckets.  Bucket 0 counts values below 1,
+ *  bucket n counts values from 2^(n-1) to 2^n - 1, and the last bucket
+ *  counts everything larger.  For microseconds, the buckets thus go up to
+ *  about 32 ms.
+ */
+
+class timing_histogram
+{
+
+public:
+
+    static const int c_bucket_count = 17;
+
+private:
+
+    std::atomic<unsigned> m_buckets[c_bucket_count];
+    std::atomic<unsigned> m_count;      /**< The number of values added.    */
+    std::atomic<long long> m_total;     /**< The sum of values, for mean.   */
+    std::atomic<long> m_maximum;        /**< The largest value added.       */
+
+public:
+
+    timing_histogram ();
+    timing_histogram (const timing_histogram &) = delete;
+    timing_histogram & operator = (const timing_histogram &) = delete;
+
+    void clear ();
+    void add (long value);
+    std::string report
+    (
+        const std::string & name,
+        const std::string & unit
+    ) const;
+
+    unsigned count () const
+    {
+        return m_count.load(std::memory_order_relaxed);
+    }
+
+    unsigned bucket (int index) const
+    {
+        return m_buckets[index].load(std::memory_order_relaxed);
+    }
+
+    long maximum () const
+    {
+        return m_maximum.load(std::memory_order_relaxed);
+    }
+
+    double mean () const;
+
+};          // class timing_histogram
+
+/**
+ *  Holds the counters for the output and input threads.
+ */
+
+class perfcounters
+{
+
+private:
+
+    /**
+     *  How late the output thread wakes up compared to when it asked to be
+     *  woken, in microseconds.
+     */
+
+    timing_histogram m_output_wake;
+
+    /**
+     *  How long the output thread works in each cycle, in microseconds.
+     */
+
+    timing_histogram m_output_work;
+
+    /**
+     *  The number of events sent in each output cycle.
+     */
+
+    timing_histogram m_cycle_events;
+
+    /**
+     *  The time from the arrival of an input event at a JACK port, as
+     *  given by its frame time, to its dispatch by the input thread, in
+     *  microseconds.  It includes one JACK period.  Thru
+     *  echoing is done during the dispatch, so this is also the bulk of the
+     *  input-to-output latency.
+     */
+
+    timing_histogram m_input_latency;
+
+    std::atomic<unsigned> m_cycles;         /**< Output cycles counted.     */
+    std::atomic<unsigned> m_underruns;      /**< Cycles that overran.       */
+    std::atomic<unsigned> m_events;         /**< Events since the cycle.    */
+
+    /**
+     *  Events sent per output buss, and the high-water mark and drop count
+     *  of the ring-buffer of each buss, where the MIDI engine has one.
+     */
+
+    std::atomic<unsigned> m_buss_events[c_busscount_max];
+    std::atomic<int> m_ring_max[c_busscount_max];
+    std::atomic<int> m_ring_dropped[c_busscount_max];
+
+public:
+
+    perfcounters ();
+    perfcounters (const perfcounters &) = delete;
+    perfcounters & operator = (const perfcounters &) = delete;
+
+    void clear ();
+    void end_output_cycle (long work_us);
+    void ring_usage (int buss, int maxcount, int dropped);
+    std::string report () const;
+    bool write_report (const std::string & filename) const;
+
+    void output_wake (long us)
+    {
+        m_output_wake.add(us);
+    }
+
+    void output_underrun ()
+    {
+        m_underruns.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void input_latency (long us)
+    {
+        m_input_latency.add(us);
+    }
+
+    /**
+     *  Counts an event sent to an output buss.  Called for each event, so it
+     *  must stay cheap.
+     */
+
+    void output_event (bussbyte buss)
+    {
+        m_events.fetch_add(1, std::memory_order_relaxed);
+        if (buss < c_busscount_max)
+            m_buss_events[buss].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    unsigned cycles () const
+    {
+        return m_cycles.load(std::memory_order_relaxed);
+    }
+
+    unsigned underruns () const
+    {
+        return m_underruns.load(std::memory_order_relaxed);
+    }
+
+};          // class perfcounters
+
+/*
+ *  Free functions.
+ */
+
+extern perfcounters & perf_counters ();
+
+}           // namespace seq66
+
+#endif      // SEQ66_PERFCOUNTERS_HPP
+
+/*
+ * perfcounters.hpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
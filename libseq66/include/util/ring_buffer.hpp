@@ -28,17 +28,34 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2022-09-19
- * \updates       2022-10-31
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
+ *
+ *  The ring_buffer is a single-producer/single-consumer queue.  Exactly one
+ *  thread (e.g. the output thread calling midi_jack::send_message()) may
+ *  push, and exactly one other thread (e.g. the JACK process callback) may
+ *  pop.  The tail index is written only by the producer, and the head index
+ *  only by the consumer.  Each is published with a release store and read
+ *  by the other side with an acquire load, so that the element copied into
+ *  a slot is visible before the index that hands it over.  The two indices
+ *  live on separate cache lines, along with each side's cached copy of the
+ *  other's index, so the threads do not false-share.
+ *
+ *  The indices count up without wrapping at the buffer size; the slot is
+ *  the index masked by the power-of-two size.  So all slots are usable, and
+ *  the element count is simply tail - head.
  */
 
+#include <atomic>                       /* std::atomic<>                    */
 #include <cstddef>
 #include <sys/types.h>
 #include <vector>
 
 #include "seq66_features.h"             /* SEQ66_PLATFORM_DEBUG macro       */
 
-#undef  SEQ66_USE_MEMORY_LOCK           /* TODO: needs a lot of work !      */
+#if defined SEQ66_PLATFORM_UNIX
+#define SEQ66_USE_MEMORY_LOCK           /* mlock(2) is available            */
+#endif
 
 #if defined SEQ66_USE_MEMORY_LOCK
 #include <sys/mman.h>
@@ -47,6 +64,14 @@
 namespace seq66
 {
 
+/**
+ *  A conservative cache-line size for separating the producer and consumer
+ *  indices.  std::hardware_destructive_interference_size is not provided by
+ *  all of the compilers we support.
+ */
+
+const std::size_t c_ring_cache_line = 64;
+
 template <typename TYPE>
 class ring_buffer
 {
@@ -61,19 +86,36 @@ public:
 
 private:
 
+    /*
+     *  Shared, read-only after construction.
+     */
+
     container m_buffer;         /**< Container for all push/popped items.   */
     size_type m_buffer_size;    /**< Constant power-of-two container size.  */
-    size_type m_contents_size;  /**< Number of active entries in container. */
-    volatile size_type m_tail;  /**< Index where next item is written.      */
-    volatile size_type m_head;  /**< Index where next item is read.         */
     size_type m_size_mask;      /**< Restricts index to < buffer size.      */
-    bool m_locked;              /**< Is memory locked? NOT YET SUPPORTED.   */
+    bool m_locked;              /**< Is the container memory locked?        */
+
+    /*
+     *  Producer side.  m_tail is written only by the producer.
+     */
+
+    alignas(c_ring_cache_line) std::atomic<size_type> m_tail;
+    size_type m_head_cache;     /**< Producer's last view of m_head.        */
     size_type m_contents_max;   /**< Useful in trouble-shooting.            */
-    int m_dropped;              /**< Number of items overwritten in run.    */
+    std::atomic<int> m_dropped; /**< Number of items refused when full.     */
+
+    /*
+     *  Consumer side.  m_head is written only by the consumer.
+     */
+
+    alignas(c_ring_cache_line) std::atomic<size_type> m_head;
+    size_type m_tail_cache;     /**< Consumer's last view of m_tail.        */
 
 public:
 
     explicit ring_buffer (size_type sz);
+    ring_buffer (const ring_buffer &) = delete;
+    ring_buffer & operator = (const ring_buffer &) = delete;
     ~ring_buffer ();
 
     bool mlock ();
@@ -85,24 +127,39 @@ public:
 
     void reset ()
     {
-        m_head = m_tail = 0;
+        m_head.store(0, std::memory_order_relaxed);
+        m_tail.store(0, std::memory_order_relaxed);
+        m_head_cache = m_tail_cache = 0;
     }
 
     void clear ()
     {
-        m_dropped = m_contents_size = 0;
+        m_dropped.store(0, std::memory_order_relaxed);
+        m_contents_max = 0;
         reset();
         initialize();
     }
 
+    bool locked () const
+    {
+        return m_locked;
+    }
+
     int buffer_size () const
     {
         return int(m_buffer_size);
     }
 
+    /**
+     *  The number of items in the buffer.  Exact when called by the
+     *  producer or consumer, a snapshot when called by anyone else.
+     */
+
     int count () const
     {
-        return int(m_contents_size);
+        size_type t = m_tail.load(std::memory_order_acquire);
+        size_type h = m_head.load(std::memory_order_acquire);
+        return int(t - h);
     }
 
     int count_max () const
@@ -117,7 +174,7 @@ public:
 
     int dropped () const
     {
-        return m_dropped;
+        return m_dropped.load(std::memory_order_relaxed);
     }
 
     void write_advance ();
@@ -125,36 +182,42 @@ public:
     size_type write_space () const;
     size_type read_space () const;
     size_type read (reference dest);
+    size_type read (value_type * dest, size_type n);
     size_type write (const_reference src);
+    size_type write (const value_type * src, size_type n);
     bool push_back (const value_type & value);
 
+    /**
+     *  Removes the front item.  Consumer only.
+     */
+
     void pop_front ()
     {
-        if (m_contents_size > 0)
-            increment_head();
+        if (read_space() > 0)
+            read_advance();
     }
 
     /*
      * Returns reference to the first element in the queue. This element will
      * be the first element to be removed on a call to pop().  The return
      * value might not be valid, either a default-constructed object or an
-     * old and "overwritten" value. An alternative is to call the read()
-     * function and check the return value.
+     * old value, if the buffer is empty. An alternative is to call the
+     * read() function and check the return value.  Consumer only.
      */
 
     reference front ()
     {
-        return m_buffer[m_head];
+        return m_buffer[m_head.load(std::memory_order_relaxed) & m_size_mask];
     }
 
     const_reference front () const
     {
-        return m_buffer[m_head];
+        return m_buffer[m_head.load(std::memory_order_relaxed) & m_size_mask];
     }
 
     /**
-     *  Currently there's no way to be sure that the back item is a
-     *  valid item.
+     *  Returns the item most recently pushed.  Currently there's no way to be
+     *  sure that the back item is a valid item.  Producer only.
      */
 
     reference back ()
@@ -170,12 +233,11 @@ public:
 private:    // helper functions
 
     void initialize ();
-    void increment_head ();
-    void increment_tail ();
+    void update_contents_max (size_type t);
 
-    size_t previous_tail ()
+    size_type previous_tail () const
     {
-        return m_tail > 0 ? m_tail - 1 : m_buffer_size -1  ;
+        return (m_tail.load(std::memory_order_relaxed) - 1) & m_size_mask;
     }
 
 };          // class ring_buffer<TYPE>
@@ -189,13 +251,14 @@ template<typename TYPE>
 ring_buffer<TYPE>::ring_buffer (size_type sz) :
     m_buffer        (),
     m_buffer_size   (0),
-    m_contents_size (0),
-    m_tail          (0),
-    m_head          (0),                    /* supports empty buffer case   */
     m_size_mask     (0),
     m_locked        (false),
+    m_tail          (0),
+    m_head_cache    (0),
     m_contents_max  (0),
-    m_dropped       (0)
+    m_dropped       (0),
+    m_head          (0),                    /* supports empty buffer case   */
+    m_tail_cache    (0)
 {
     int power_of_two;
     for (power_of_two = 1; 1 << power_of_two < int(sz); ++power_of_two)
@@ -208,11 +271,7 @@ ring_buffer<TYPE>::ring_buffer (size_type sz) :
 }
 
 /**
- *  Free all data associated with the ringbuffer `m_rb'.
- *
- *  Note that we will have some work to do (like writing an allocator that
- *  uses an unswappable block of memory for the vector data) if we define this
- *  macro.
+ *  Unlocks the container memory if mlock() locked it.  The vector frees it.
  */
 
 template<typename TYPE>
@@ -220,50 +279,36 @@ ring_buffer<TYPE>::~ring_buffer ()
 {
 #if defined SEQ66_USE_MEMORY_LOCK
     if (m_locked)
-        ::munlock(m_buffer, m_buffer_size);
+        (void) ::munlock(m_buffer.data(), m_buffer.size() * sizeof(TYPE));
 #endif
 }
 
-template<typename TYPE>
-void
-ring_buffer<TYPE>::initialize ()
-{
-    TYPE empty_value;
-    m_buffer.clear();
-    m_buffer.reserve(m_buffer_size);
-    for (size_t i = 0; i < m_buffer_size; ++i)
-        (void) m_buffer.push_back(empty_value); /* prepare buffer for usage */
-}
+/**
+ *  Fills the container with default-constructed items.  The container is
+ *  allocated only once, at construction, so that its address (and any page
+ *  lock) stays valid; later calls, via clear(), just overwrite the items.
+ */
 
 template<typename TYPE>
 void
-ring_buffer<TYPE>::increment_head ()
+ring_buffer<TYPE>::initialize ()
 {
-    if (m_contents_size > 0)
+    if (m_buffer.size() == m_buffer_size)
     {
-        ++m_head;
-        --m_contents_size;
-        if (m_head == m_buffer_size)
-            m_head = 0;                                 /* wrap around  */
+        for (auto & item : m_buffer)
+            item = TYPE();
     }
-}
-
-template<typename TYPE>
-void
-ring_buffer<TYPE>::increment_tail ()
-{
-    ++m_tail;
-    ++m_contents_size;
-    if (m_contents_size > m_contents_max)               /* for checking */
-        m_contents_max = m_contents_size;
-
-    if (m_tail == m_buffer_size)
-        m_tail = 0;                                     /* wrap around  */
+    else
+        m_buffer.assign(m_buffer_size, TYPE());
 }
 
 /**
- *  Lock the data block of `rb' using the system call 'mlock'.
- *  Not nearly ready for prime time!
+ *  Locks the pages of the container into memory using mlock(2), so that the
+ *  real-time thread never takes a page fault on them.  This can fail if the
+ *  RLIMIT_MEMLOCK limit is too low; the buffer still works, just unlocked.
+ *
+ * \return
+ *      Returns true if the memory is locked.
  */
 
 template<typename TYPE>
@@ -271,47 +316,77 @@ bool
 ring_buffer<TYPE>::mlock ()
 {
 #if defined SEQ66_USE_MEMORY_LOCK
-    if (::mlock(m_buffer, m_buffer_size) != 0)
-        return false;
-
-    m_locked = true;
-    return true;
-#else
-    return false;
+    if (! m_locked)
+    {
+        void * addr = m_buffer.data();
+        std::size_t len = m_buffer.size() * sizeof(TYPE);
+        m_locked = ::mlock(addr, len) == 0;
+    }
 #endif
+    return m_locked;
 }
 
 /**
- *  Return the number of elements available for writing.  This is the number
- *  of elements in front of the write/tail pointer and behind the read/head
- *  pointer.
+ *  Return the number of elements available for writing.  Producer only.
+ *  The consumer's head is reloaded only if the cached value shows the
+ *  buffer to be full, which saves touching the consumer's cache line.
  */
 
 template<typename TYPE>
 std::size_t
 ring_buffer<TYPE>::write_space () const
 {
-    size_type t = m_tail;                           /* index for writing    */
-    size_type h = m_head;                           /* index for reading    */
-    if (t > h)
-        return ((h - t + m_buffer_size) & m_size_mask) - 1;
-    else if (t < h)
-        return (h - t) - 1;
-    else
-        return m_buffer_size - m_contents_size;
+    ring_buffer<TYPE> * self = const_cast<ring_buffer<TYPE> *>(this);
+    size_type t = m_tail.load(std::memory_order_relaxed);
+    size_type space = m_buffer_size - (t - m_head_cache);
+    if (space == 0)
+    {
+        self->m_head_cache = m_head.load(std::memory_order_acquire);
+        space = m_buffer_size - (t - m_head_cache);
+    }
+    return space;
 }
 
+/**
+ *  Updates the high-water mark after the tail moved to \a t.  Producer
+ *  only.  The count from the cached head can be too high, as the consumer
+ *  may have moved on since.  So, when it would set a new mark, which is
+ *  rare, the head is reloaded to get the exact count.
+ */
+
+template<typename TYPE>
+void
+ring_buffer<TYPE>::update_contents_max (size_type t)
+{
+    if (t - m_head_cache > m_contents_max)
+    {
+        m_head_cache = m_head.load(std::memory_order_acquire);
+
+        size_type n = t - m_head_cache;
+        if (n > m_contents_max)
+            m_contents_max = n;
+    }
+}
+
+/**
+ *  Publishes the item written at the tail.  Producer only.
+ */
+
 template<typename TYPE>
 void
 ring_buffer<TYPE>::write_advance ()
 {
-    increment_tail();
+    size_type t = m_tail.load(std::memory_order_relaxed) + 1;
+    m_tail.store(t, std::memory_order_release);
+    update_contents_max(t);
 }
 
 /**
  *  Since we only push one element at a time, the return code is used to
  *  determine the number of elements currently active in the ring_buffer,
  *  unless 0 is returned, which indicates an error (no space left).
+ *  Producer only.  The count uses the producer's cached view of the head,
+ *  so it is an upper bound: the consumer may have read some items since.
  */
 
 template<typename TYPE>
@@ -319,55 +394,87 @@ std::size_t
 ring_buffer<TYPE>::write (const_reference src)
 {
     size_type result = 0;
-    size_type write_cnt = write_space();
-    if (write_cnt > 0)
+    if (push_back(src))
+        result = m_tail.load(std::memory_order_relaxed) - m_head_cache;
+
+    return result;
+}
+
+/**
+ *  Writes up to \a n items in one go, publishing them with a single store
+ *  of the tail.  Producer only.
+ *
+ * \return
+ *      Returns the number of items written, which is less than \a n if the
+ *      buffer filled up.  The rest are counted as dropped.
+ */
+
+template<typename TYPE>
+std::size_t
+ring_buffer<TYPE>::write (const value_type * src, size_type n)
+{
+    size_type space = write_space();
+    size_type count = n < space ? n : space ;
+    size_type t = m_tail.load(std::memory_order_relaxed);
+    for (size_type i = 0; i < count; ++i)
+        m_buffer[(t + i) & m_size_mask] = src[i];
+
+    if (count > 0)
     {
-        (void) push_back(src);
-        result = m_contents_size;
+        t += count;
+        m_tail.store(t, std::memory_order_release);
+        update_contents_max(t);
     }
-    return result;
+    if (count < n)
+        m_dropped.fetch_add(int(n - count), std::memory_order_relaxed);
+
+    return count;
 }
 
 /**
- *  Return the number of elements (TYPE) available for reading.  This is the
- *  number of elements in front of the read pointer and behind the write
- *  pointer.
+ *  Return the number of elements (TYPE) available for reading.  Consumer
+ *  only.  The producer's tail is reloaded only if the cached value shows the
+ *  buffer to be empty.
  */
 
 template<typename TYPE>
 std::size_t
 ring_buffer<TYPE>::read_space () const
 {
-    if (count() > 0)
+    ring_buffer<TYPE> * self = const_cast<ring_buffer<TYPE> *>(this);
+    size_type h = m_head.load(std::memory_order_relaxed);
+    size_type space = m_tail_cache - h;
+    if (space == 0)
     {
-        size_type t = m_tail;                       /* index for writing    */
-        size_type h = m_head;                       /* index for reading    */
-        if (t > h)
-            return t - h;
-        else if (t == h)
-            return m_contents_size;
-        else
-            return (t - h + m_buffer_size) & m_size_mask;
+        self->m_tail_cache = m_tail.load(std::memory_order_acquire);
+        space = m_tail_cache - h;
     }
-    else
-        return 0;
+    return space;
 }
 
+/**
+ *  Releases the front slot to the producer.  Consumer only.  The caller
+ *  must have checked read_space().
+ */
+
 template<typename TYPE>
 void
 ring_buffer<TYPE>::read_advance ()
 {
-    ++m_head;
-    m_head &= m_size_mask;
+    size_type h = m_head.load(std::memory_order_relaxed) + 1;
+    m_head.store(h, std::memory_order_release);
 }
 
 /**
  *  The copying data reader.  Unlike the original "C" version, this function
  *  does not copy `cnt' bytes from `rb'.  Instead it copies one element to
- *  the destination and returns 1 if that works.
+ *  the destination.
  *
  *  Unlike front(), this function and pop_front() "remove" the element.
- *  The result return is the number of elements still stored.
+ *  Consumer only.
+ *
+ * \return
+ *      Returns 1 if an element was read, and 0 if the buffer was empty.
  */
 
 template<typename TYPE>
@@ -375,44 +482,63 @@ std::size_t
 ring_buffer<TYPE>::read (reference dest)
 {
     size_t result = 0;
-    size_type read_cnt = read_space();
-    if (read_cnt > 0)
+    if (read_space() > 0)
     {
-        dest = m_buffer[m_head];
-        pop_front();
-        result = m_contents_size;
+        dest = front();
+        read_advance();
+        result = 1;
     }
     return result;
 }
 
 /**
- *  Increment the tail, then increment the head. This function supports the
- *  special case of an empty buffer.
+ *  Reads up to \a n items in one go, releasing their slots with a single
+ *  store of the head.  Consumer only.
+ *
+ * \return
+ *      Returns the number of items read.
+ */
+
+template<typename TYPE>
+std::size_t
+ring_buffer<TYPE>::read (value_type * dest, size_type n)
+{
+    size_type space = read_space();
+    size_type count = n < space ? n : space ;
+    size_type h = m_head.load(std::memory_order_relaxed);
+    for (size_type i = 0; i < count; ++i)
+        dest[i] = m_buffer[(h + i) & m_size_mask];
+
+    if (count > 0)
+        m_head.store(h + count, std::memory_order_release);
+
+    return count;
+}
+
+/**
+ *  Copies the item into the tail slot and publishes it.  Producer only.
+ *  A single-producer/single-consumer queue cannot discard the front item
+ *  from the producer side (it belongs to the consumer), so if the buffer
+ *  is full the new item is refused and counted as dropped.
+ *
+ * \return
+ *      Returns true if the item was queued.
  */
 
 template<typename TYPE>
 bool
 ring_buffer<TYPE>::push_back (const value_type & item)
 {
-    if (m_contents_size == 0)
-    {
-        m_tail = m_head;
-        m_buffer[m_tail] = item;
-        increment_tail();
-    }
-    else if (m_contents_size < m_buffer_size)
+    bool result = write_space() > 0;
+    if (result)
     {
-        m_buffer[m_tail] = item;
-        increment_tail();
+        m_buffer[m_tail.load(std::memory_order_relaxed) & m_size_mask] = item;
+        write_advance();
     }
-    else                                    /* accept item and drop front() */
-    {
-        increment_head();
-        m_buffer[m_tail] = item;
-        increment_tail();
-        ++m_dropped;                        /* for future use in expansion  */
-    }
-    return true;
+    else
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+
+    return result;
 }
 
 /*
@@ -422,6 +548,7 @@ ring_buffer<TYPE>::push_back (const value_type & item)
 #if defined SEQ66_PLATFORM_DEBUG
 
 extern bool run_ring_test ();
+extern bool run_ring_benchmark (int itemcount = 10000000);
 
 #endif
 
@@ -434,4 +561,3 @@ extern bool run_ring_test ();
  *
  * vim: sw=4 ts=4 wm=4 et ft=cpp
  */
-
@@ -94,16 +94,22 @@ HEADERS += include/seq66_features.h \
  include/midi/editable_events.hpp \
  include/midi/event.hpp \
  include/midi/eventlist.hpp \
+ include/midi/eventundo.hpp \
  include/midi/jack_assistant.hpp \
  include/midi/mastermidibase.hpp \
  include/midi/midibase.hpp \
  include/midi/midibytes.hpp \
+ include/midi/midicapture.hpp \
  include/midi/midifile.hpp \
  include/midi/midi_splitter.hpp \
  include/midi/midi_vector_base.hpp \
  include/midi/midi_vector.hpp \
  include/midi/patches.hpp \
+ include/midi/playevents.hpp \
+ include/midi/pulseclock.hpp \
+ include/midi/sysexsender.hpp \
  include/midi/wrkfile.hpp \
+ include/play/clockfollower.hpp \
  include/play/clockslist.hpp \
  include/play/inputslist.hpp \
  include/play/metro.hpp \
@@ -130,8 +136,10 @@ HEADERS += include/seq66_features.h \
  include/util/basic_macros.hpp \
  include/util/condition.hpp \
  include/util/filefunctions.hpp \
+ include/util/mappedfile.hpp \
  include/util/named_bools.hpp \
  include/util/palette.hpp \
+ include/util/perfcounters.hpp \
  include/util/recmutex.hpp \
  include/util/rect.hpp \
  include/util/ring_buffer.hpp \
@@ -181,16 +189,21 @@ SOURCES += src/seq66_features.cpp \
  src/midi/editable_events.cpp \
  src/midi/event.cpp \
  src/midi/eventlist.cpp \
+ src/midi/eventundo.cpp \
  src/midi/jack_assistant.cpp \
  src/midi/mastermidibase.cpp \
  src/midi/midibase.cpp \
  src/midi/midibytes.cpp \
+ src/midi/midicapture.cpp \
  src/midi/midifile.cpp \
  src/midi/midi_splitter.cpp \
  src/midi/midi_vector_base.cpp \
  src/midi/midi_vector.cpp \
  src/midi/patches.cpp \
+ src/midi/playevents.cpp \
+ src/midi/sysexsender.cpp \
  src/midi/wrkfile.cpp \
+ src/play/clockfollower.cpp \
  src/play/clockslist.cpp \
  src/play/inputslist.cpp \
  src/play/metro.cpp \
@@ -216,8 +229,10 @@ SOURCES += src/seq66_features.cpp \
  src/util/basic_macros.cpp \
  src/util/condition.cpp \
  src/util/filefunctions.cpp \
+ src/util/mappedfile.cpp \
  src/util/named_bools.cpp \
  src/util/palette.cpp \
+ src/util/perfcounters.cpp \
  src/util/recmutex.cpp \
  src/util/rect.cpp \
  src/util/ring_buffer.cpp \
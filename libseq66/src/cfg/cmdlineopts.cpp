@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-11-20
- * \updates       2026-05-09
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  The "rc" command-line options override setting that are first read from
@@ -373,6 +373,8 @@ static const std::string s_help_4b
     "      no-daemonize  Or not. These options do not apply to Windows.\n"
     "                    The application writes these options to 'usr'\n"
     "                    and exits. Subsequent runs are thus affected. Tricky!\n"
+    "      bounce=file   Render the MIDI file given on the command line to\n"
+    "                    'file', as the engine plays it, and exit.\n"
     "\n"
     "Add '--user-save' to make these options permanent.\n"
     "\n"
@@ -634,6 +636,13 @@ cmdlineopts::parse_o_options (int argc, char * argv [])
                             {
                                 result = parse_o_virtual(arg);
                             }
+                            else if (optionname == "bounce")
+                            {
+                                arg = strip_quotes(arg);
+                                result = ! arg.empty();
+                                if (result)
+                                    usr().option_bounce(arg);
+                            }
                         }
                         if (! result)
                         {
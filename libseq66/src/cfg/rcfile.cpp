@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-11-23
- * \updates       2026-05-16
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  The <code> ~/.config/seq66.rc </code> configuration file is fairly simple
@@ -221,6 +221,9 @@ rcfile::parse ()
         rc().thread_priority(priority);
     }
 
+    bool deadline = get_boolean(file, tag, "deadline-scheduler");
+    rc_ref().deadline_scheduler(deadline);
+
     /*
      * [comments] Header comments (hash-tag lead) are skipped during parsing.
      * However, we now try to read an optional comment block.
@@ -324,12 +327,24 @@ rcfile::parse ()
         rc_ref().jack_auto_connect(flag);
         flag = get_boolean(file, tag, "jack-use-offset", 0, true);
         rc_ref().jack_use_offset(flag);
+        flag = get_boolean(file, tag, "jack-pull-mode", 0, false);
+        rc_ref().jack_pull_mode(flag);
 
         int buffersize = rc().jack_buffer_size();
         buffersize = get_integer(file, tag, "jack-buffer-size", 0);
         rc().jack_buffer_size(buffersize);
     }
 
+    tag = "[alsa-midi]";
+
+    int lookahead = get_integer(file, tag, "queue-lookahead-ms");
+    if (! is_missing(lookahead))
+        rc_ref().alsa_queue_lookahead(lookahead);
+
+    int sysexrate = get_integer(file, tag, "sysex-rate");
+    if (! is_missing(sysexrate))
+        rc_ref().alsa_sysex_rate(sysexrate);
+
     tag = "[manual-ports]";
 
     bool flag = get_boolean(file, tag, "virtual-ports");
@@ -775,6 +790,10 @@ rcfile::write ()
 "#\n"
 "# 'priority' greater than 0 is meant to increase the priority of the I/O\n"
 "# threads. It needs Seq66 to run as root, or be installed as setuid 0.\n"
+"#\n"
+"# 'deadline-scheduler' makes the output thread wake at absolute times\n"
+"# computed from the start of playback and the tempo, instead of sleeping\n"
+"# for a relative time each cycle. The MIDI clock output is steadier.\n"
         ;
 
     write_seq66_header(file, "rc", version());
@@ -784,6 +803,7 @@ rcfile::write ()
     write_string(file, "port-naming", rc_ref().port_naming_string());
     write_boolean(file, "init-disabled-ports", rc_ref().init_disabled_ports());
     write_integer(file, "priority", rc_ref().thread_priority());
+    write_boolean(file, "deadline-scheduler", rc_ref().deadline_scheduler());
 
     /*
      * [comments]
@@ -1231,6 +1251,9 @@ rcfile::write ()
 "# false to have a session manager make the connections.\n"
 "# jack-use-offset attempts to calculate timestamp offsets to improve accuracy\n"
 "# at high-buffer sizes. Still a work in progress.\n"
+"# jack-pull-mode plays the patterns in the JACK process callback, writing\n"
+"# each event at its exact frame, instead of in the output thread. JACK MIDI\n"
+"# only. Default = false.\n"
 "# jack-buffer-size allows for changing the frame-count, a power of 2.\n"
 "\n[jack-transport]\n\n"
         << "transport-type = " << jacktransporttype << "\n"
@@ -1239,8 +1262,24 @@ rcfile::write ()
     write_boolean(file, "jack-midi", rc_ref().with_jack_midi());
     write_boolean(file, "jack-auto-connect", rc_ref().jack_auto_connect());
     write_boolean(file, "jack-use-offset", rc_ref().jack_use_offset());
+    write_boolean(file, "jack-pull-mode", rc_ref().jack_pull_mode());
     write_integer(file, "jack-buffer-size", rc_ref().jack_buffer_size());
     file << "\n"
+"# queue-lookahead-ms, if greater than 0 (maximum 100), schedules ALSA MIDI\n"
+"# output on the ALSA queue this many milliseconds ahead, so that the kernel,\n"
+"# not the output thread, times the events. This adds a fixed latency but\n"
+"# removes output-thread jitter. Pending notes are removed when playback\n"
+"# stops. 0 (the default) sends events directly. Not used with JACK MIDI.\n"
+"#\n"
+"# sysex-rate paces SysEx messages of 256 bytes or more, in bytes per\n"
+"# second, for slow devices. They are sent in 256-byte chunks by a thread\n"
+"# of each port, so that playback goes on meanwhile. The default is 3200;\n"
+"# 0 sends the chunks back to back.\n"
+"\n[alsa-midi]\n\n"
+        ;
+    write_integer(file, "queue-lookahead-ms", rc_ref().alsa_queue_lookahead());
+    write_integer(file, "sysex-rate", rc_ref().alsa_sysex_rate());
+    file << "\n"
 "# 'auto-save-rc' sets automatic saving of the  'rc' and other files. If set\n"
 "# (true if changes were made in Preferences), settings are saved.\n"
 "#\n"
@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Seq24 team; modifications by Chris Ahlstrom
  * \date          2015-09-22
- * \updates       2026-05-18
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  Note that this module also sets the legacy global variables, so that
@@ -82,6 +82,7 @@ rcsettings::rcsettings () :
     m_show_midi                 (false),
     m_priority                  (false),
     m_thread_priority           (0),        /* c_thread_priority            */
+    m_deadline_scheduler        (false),
     m_pass_sysex                (false),
     m_with_jack_transport       (false),
     m_with_jack_master          (false),
@@ -94,7 +95,10 @@ rcsettings::rcsettings () :
     m_with_alsa_midi            (false),    /* unless ALSA gets selected    */
     m_jack_auto_connect         (true),
     m_jack_use_offset           (true),
+    m_jack_pull_mode            (false),
     m_jack_buffer_size          (0),
+    m_alsa_queue_lookahead      (0),
+    m_alsa_sysex_rate           (c_alsa_sysex_rate_default),
     m_song_start_mode           (sequence::playback::automatic),
     m_song_start_is_auto        (true),
     m_record_by_buss            (false),
@@ -201,6 +205,7 @@ rcsettings::set_defaults ()
     m_show_midi                 = false;
     m_priority                  = false;
     m_thread_priority           = 0;        /* c_thread_priority            */
+    m_deadline_scheduler        = false;
     m_pass_sysex                = false;
     m_with_jack_transport       = false;
     m_with_jack_master          = false;
@@ -213,7 +218,10 @@ rcsettings::set_defaults ()
     m_with_alsa_midi            = false;    /* unless ALSA gets selected    */
     m_jack_auto_connect         = true;
     m_jack_use_offset           = true;
+    m_jack_pull_mode            = false;
     m_jack_buffer_size          = 0;
+    m_alsa_queue_lookahead      = 0;
+    m_alsa_sysex_rate           = c_alsa_sysex_rate_default;
     m_song_start_mode           = sequence::playback::automatic;
     m_song_start_is_auto        = true;
     m_record_by_buss            = false;
@@ -26,7 +26,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-11-23
- * \updates       2025-07-17
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  Note that the parse function has some code that is not yet enabled.
@@ -599,6 +599,12 @@ usrfile::parse ()
 
     flag = get_boolean(file, tag, "wrap-around");
     usr().pattern_wraparound(flag);
+    s = get_variable(file, tag, "undo-budget");
+    if (! is_questionable_string(s))
+    {
+        int kb = get_integer(file, tag, "undo-budget");
+        usr().undo_budget(kb);
+    }
 
     /*
      * Consider:
@@ -1137,6 +1143,9 @@ usrfile::write ()
 "# 'expand', and 'one-shot'. 'wrap-around' allows recorded notes to wrap\n"
 "# to the pattern beginning. Currently 'notemap' and quantizing are\n"
 "# are mutually exclusive.\n"
+"#\n"
+"# 'undo-budget' is the most memory, in kilobytes, that the undo/redo log\n"
+"# of each pattern can use. The oldest edits are dropped first. 0 = no limit.\n"
 "\n[pattern-editor]\n\n"
         ;
     write_boolean(file, "escape-pattern", usr().escape_pattern());
@@ -1149,6 +1158,7 @@ usrfile::write ()
     write_boolean(file, "notemap", usr().pattern_notemap());
     write_string(file, "record-style", usr().pattern_record_string());
     write_boolean(file, "wrap-around", usr().pattern_wraparound());
+    write_integer(file, "undo-budget", usr().undo_budget());
     write_seq66_footer(file);
     file.close();
     return true;
@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-09-23
- * \updates       2025-07-19
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  Note that this module also sets the remaining legacy global variables, so
@@ -296,6 +296,14 @@ static const int c_fingerprint_size_min =  32;
 static const int c_fingerprint_size     =  32;
 static const int c_fingerprint_size_max = 128;
 
+/**
+ *  Provides the default and maximum memory, in kilobytes, for the undo/redo
+ *  log of each pattern.
+ */
+
+static const int c_undo_budget          =   4096;
+static const int c_undo_budget_max      = 1048576;
+
 /**
  *  Default color names for tick/time displays.
  */
@@ -387,6 +395,7 @@ usrsettings::usrsettings () :
     m_user_save_daemonize       (false),
     m_user_use_logfile          (false),
     m_user_option_logfile       (),
+    m_user_option_bounce        (),
     m_user_pdf_viewer           (),
     m_user_browser              (),
 
@@ -424,6 +433,7 @@ usrsettings::usrsettings () :
     m_pattern_new_only          (false),
     m_pattern_record_style      (recordstyle::merge),
     m_pattern_wraparound        (false),
+    m_undo_budget               (c_undo_budget),
     m_record_alteration         (alteration::none),
     m_grid_mode                 (gridmode::loop),
     m_enable_learn_confirmation (true)
@@ -503,6 +513,7 @@ usrsettings::set_defaults ()
     m_user_save_daemonize = false;
     m_user_use_logfile = false;
     m_user_option_logfile.clear();
+    m_user_option_bounce.clear();
     m_user_pdf_viewer.clear();
     m_user_browser.clear();
     m_user_ui_key_height = c_def_key_height;
@@ -535,6 +546,7 @@ usrsettings::set_defaults ()
     m_pattern_new_only = false;
     m_pattern_record_style = recordstyle::merge;
     m_pattern_wraparound = false;
+    m_undo_budget = c_undo_budget;
     m_record_alteration = alteration::none;
     m_grid_mode = gridmode::loop;
     m_enable_learn_confirmation = true;
@@ -837,6 +849,26 @@ usrsettings::fingerprint_size (int sz)
     return result;
 }
 
+/**
+ *  Sets the memory budget of the undo/redo log of each pattern.
+ *
+ * \param kb
+ *      The budget in kilobytes, from 0 (no limit) to 1048576 (1 GB).
+ *
+ * \return
+ *      Returns true if the value was valid and was set.
+ */
+
+bool
+usrsettings::undo_budget (int kb)
+{
+    bool result = kb >= 0 && kb <= c_undo_budget_max;
+    if (result)
+        m_undo_budget = kb;
+
+    return result;
+}
+
 int
 usrsettings::scale_size (int value, bool shrinkmore) const
 {
@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2026-05-09
- * \updates       2026-05-18
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  This file provides a base-class implementation for various master MIDI
@@ -46,7 +46,9 @@ namespace seq66
  *  access than using arrays of booleans and pointers.
  */
 
-busarray::busarray () : m_container()
+busarray::busarray () :
+    m_container     (),
+    m_next_input    (0)
 {
     // Empty body
 }
@@ -186,6 +188,68 @@ busarray::play (bussbyte bb, const event * e24, midibyte channel)
 #endif
 }
 
+/**
+ *  Queues an event for output on the given buss, to be sent by commit() at
+ *  the end of the output cycle.
+ *
+ * \param bus
+ *      The MIDI buss on which to queue the event.
+ *
+ * \param e24
+ *      A pointer to the event to be queued.
+ *
+ * \param channel
+ *      The MIDI channel on which to play the event.
+ */
+
+void
+busarray::queue (bussbyte bb, const event * e24, midibyte channel)
+{
+    midibus * b { bus(bb) };
+    if (not_nullptr(b))
+        b->queue(e24, channel);
+}
+
+/**
+ *  Sends the events queued on each buss, with one flush per buss.
+ *
+ * \param pc
+ *      Provides the time at which each pulse is due.  See
+ *      midibase::commit().
+ */
+
+void
+busarray::commit (const pulseclock & pc)
+{
+    for (auto & bi : m_container)
+    {
+        midibus * b { bi.bus() };
+        if (not_nullptr(b))
+            b->commit(pc);
+    }
+}
+
+/**
+ *  Like commit(), but skips a buss whose port is busy; its events stay
+ *  queued for the next cycle.  See midibase::try_commit().
+ *
+ * \return
+ *      Returns true if every buss was committed.
+ */
+
+bool
+busarray::try_commit (const pulseclock & pc)
+{
+    bool result = true;
+    for (auto & bi : m_container)
+    {
+        midibus * b { bi.bus() };
+        if (not_nullptr(b) && ! b->try_commit(pc))
+            result = false;
+    }
+    return result;
+}
+
 /**
  *  Handles SysEx events; used for output busses.
  *
@@ -455,13 +519,16 @@ busarray::init_clock (midipulse tick)
  *
  * \param tick
  *      Provides the tick value for all busses use as the clock tick.
+ *
+ * \param pc
+ *      If not null, provides the time at which each clock is due.
  */
 
 void
-busarray::clock (midipulse tick)
+busarray::clock (midipulse tick, const pulseclock * pc)
 {
     for (auto & bi : m_container)       /* vector of businfo copies     */
-        bi.clock(tick);
+        bi.clock(tick, pc);
 }
 
 
@@ -677,12 +744,9 @@ busarray::is_port_locked (bussbyte bus) const
 
 /**
  *  Initiate a poll() on the existing poll descriptors.  This is a primitive
- *  poll, which exits when some data is obtained.  It also applies only to the
- *  input busses.
- *
- *  One issue is that we have no way of knowing here which MIDI input device
- *  has MIDI input events waiting.  Should we randomize the order of polling
- *  in order to avoid starving some input devices?
+ *  poll, which exits when some data is obtained, since polling an idle
+ *  buss can sleep (e.g. with PortMidi).  It applies only to the input
+ *  busses.  The busses are read fairly anyway; see get_midi_event().
  *
  * \return
  *      Returns the number of MIDI events detected on one of the busses.  Note
@@ -703,10 +767,11 @@ busarray::poll_for_midi ()
 }
 
 /**
- *  Gets the first MIDI event in finds on an input bus.
- *
- *  Note that this function risks starving the second input device if more
- *  than one is enabled in Seq66.  We will figure that one out later.
+ *  Gets the next MIDI event from the input busses, round-robin.  The search
+ *  starts at the buss after the one that supplied the previous event, so
+ *  that heavy traffic (e.g. a stream of CCs) on one port cannot delay the
+ *  events, such as MIDI clock, waiting on another port.  Each port's own
+ *  events stay in arrival order.
  *
  * \param inev
  *      A pointer to the event to be modified by incoming data, if any.
@@ -718,12 +783,19 @@ busarray::poll_for_midi ()
 bool
 busarray::get_midi_event (event * inev)
 {
-    for (auto & bi : m_container)               /* vector of businfo copies */
+    int busses = count();
+    if (m_next_input >= busses)
+        m_next_input = 0;
+
+    for (int i = 0; i < busses; ++i)
     {
+        int index = (m_next_input + i) % busses;
+        businfo & bi = m_container[index];
         if (bi.bus()->get_midi_event(inev))
         {
             bussbyte b = bussbyte(bi.bus()->bus_index());
             inev->set_input_bus(b);
+            m_next_input = (index + 1) % busses;
 #if defined SEQ66_PLATFORM_DEBUG_TMI
             printf("[seq66] input event on bus %d\n", int(b));
 #endif
@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2016-12-31
- * \updates       2026-05-18
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  This file provides a base-class implementation for various master MIDI
@@ -250,9 +250,9 @@ businfo::init_clock (midipulse tick)
 }
 
 void
-businfo::clock (midipulse tick)
+businfo::clock (midipulse tick, const pulseclock * pc)
 {
-    bus()->clock(tick);
+    bus()->clock(tick, pc);
 }
 
 void
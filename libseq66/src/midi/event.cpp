@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-07-24
- * \updates       2025-07-13
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  A MIDI event (i.e. "track event") is encapsulated by the seq66::event
@@ -115,6 +115,7 @@ event::event () :
     m_data          (),                         /* a two-element array      */
     m_sysex         (),                         /* an std::vector           */
     m_linked        (),                         /* uninit'd iterator #124   */
+    m_link_index    (-1),
     m_has_link      (false),
     m_selected      (false),
     m_marked        (false),
@@ -149,6 +150,7 @@ event::event (midipulse tstamp, midibyte status, midibyte d0, midibyte d1) :
     m_data          (),                     /* two-element array, midibytes */
     m_sysex         (),                     /* an std::vector of midibytes  */
     m_linked        (),                     /* removed nullptr issue #124   */
+    m_link_index    (-1),
     m_has_link      (false),
     m_selected      (false),
     m_marked        (false),
@@ -169,6 +171,7 @@ event::event (midipulse tstamp, midibpm tempo) :
     m_data          (),                     /* two-element array, midibytes */
     m_sysex         (),                     /* an std::vector of midibytes  */
     m_linked        (),                     /* removed nullptr issue #124   */
+    m_link_index    (-1),
     m_has_link      (false),
     m_selected      (false),
     m_marked        (false),
@@ -189,6 +192,7 @@ event::event (midipulse tstamp, midibyte metatype, const midibytes & data) :
     m_data          (),                     /* two-element array, midibytes */
     m_sysex         (),                     /* an std::vector of midibytes  */
     m_linked        (),                     /* removed nullptr issue #124   */
+    m_link_index    (-1),
     m_has_link      (false),
     m_selected      (false),
     m_marked        (false),
@@ -216,6 +220,7 @@ event::event
     m_data          (),                     /* two-element array, midibytes */
     m_sysex         (),                     /* an std::vector of midibytes  */
     m_linked        (),                     /* removed nullptr issue #124   */
+    m_link_index    (-1),
     m_has_link      (false),
     m_selected      (false),
     m_marked        (false),
@@ -266,6 +271,7 @@ event::event (const event & rhs) :
     m_data          (),                     /* a two-element array      */
     m_sysex         (rhs.m_sysex),          /* copies a vector of data  */
     m_linked        (rhs.m_linked),         /* for vector implemenation */
+    m_link_index    (rhs.m_link_index),     /* survives container moves */
     m_has_link      (rhs.m_has_link),       /* m_linked has 2 linkers!  */
     m_selected      (rhs.m_selected),
     m_marked        (rhs.m_marked),
@@ -308,6 +314,7 @@ event::operator = (const event & rhs)
         m_data[1]       = rhs.m_data[1];
         m_sysex         = rhs.m_sysex;
         m_linked        = rhs.m_linked;             /* vector implemenation */
+        m_link_index    = rhs.m_link_index;         /* container position   */
         m_has_link      = rhs.m_has_link;           /* two linkers!         */
         m_selected      = rhs.m_selected;           /* false instead?       */
         m_marked        = rhs.m_marked;             /* false instead?       */
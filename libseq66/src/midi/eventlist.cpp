@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-09-19
- * \updates       2025-10-22
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  This container now can indicate if certain Meta events (time-signaure or
@@ -33,6 +33,7 @@
  */
 
 #include <algorithm>                    /* std::stable_sort()               */
+#include <numeric>                      /* std::iota()                      */
 
 #include "cfg/settings.hpp"             /* seq66::usr()                     */
 #include "midi/eventlist.hpp"           /* seq66::eventlist                 */
@@ -55,7 +56,9 @@ eventlist::eventlist () :
     m_has_tempo             (false),
     m_has_time_signature    (false),
     m_has_key_signature     (false),
-    m_link_wraparound       (usr().pattern_wraparound())
+    m_link_wraparound       (usr().pattern_wraparound()),
+    m_clean_head            (0),
+    m_clean_tail            (0)
 {
     // No code needed
 }
@@ -77,9 +80,11 @@ eventlist::eventlist (const eventlist & rhs) :
     m_has_tempo             (rhs.m_has_tempo),
     m_has_time_signature    (rhs.m_has_time_signature),
     m_has_key_signature     (rhs.m_has_key_signature),
-    m_link_wraparound       (rhs.m_link_wraparound)
+    m_link_wraparound       (rhs.m_link_wraparound),
+    m_clean_head            (0),
+    m_clean_tail            (0)
 {
-    // no code
+    patch_links();                          /* point links into this copy   */
 }
 
 eventlist &
@@ -98,6 +103,8 @@ eventlist::operator = (const eventlist & rhs)
         m_has_time_signature    = rhs.m_has_time_signature;
         m_has_key_signature     = rhs.m_has_key_signature;
         m_link_wraparound       = rhs.m_link_wraparound;
+        touch();
+        patch_links();                      /* point links into this copy   */
     }
     return *this;
 }
@@ -173,7 +180,24 @@ eventlist::get_max_timestamp () const
 bool
 eventlist::append (const event & e)
 {
+    std::size_t cap = m_events.capacity();
     m_events.push_back(e);                      /* std::vector operation    */
+    touch(count() - 1, count() - 1);
+    if (m_events.capacity() != cap)
+        patch_links();                          /* vector was reallocated   */
+
+    note_flags(e);
+    return true;
+}
+
+/**
+ *  Raises the modified flag, and the tempo, time-signature, and
+ *  key-signature flags as appropriate for an event that has been added.
+ */
+
+void
+eventlist::note_flags (const event & e)
+{
     m_is_modified = true;
     if (e.is_tempo())
         m_has_tempo = true;
@@ -183,72 +207,357 @@ eventlist::append (const event & e)
 
     if (e.is_key_signature())
         m_has_key_signature = true;
+}
 
-    return true;
+/**
+ *  Compares two events, by position, according to event::operator < ().
+ *  Used to sort positions rather than the events themselves, so that the
+ *  link indices can be moved along with the events; see reorder().
+ */
+
+class event_order
+{
+
+private:
+
+    const event::buffer & m_events;
+
+public:
+
+    event_order (const event::buffer & evlist) : m_events (evlist)
+    {
+        // no code
+    }
+
+    bool operator () (int lhs, int rhs) const
+    {
+        return m_events[lhs] < m_events[rhs];
+    }
+
+};
+
+/**
+ *  Locates the sorted position for an event in an already-sorted vector.
+ *  A binary search (std::upper_bound()) locates the position after any
+ *  equivalent events, which is where std::stable_sort() would put an
+ *  appended event, so the ordering of event::operator < () is preserved.
+ *  The common case, an event that belongs at the end (e.g. live
+ *  recording), is checked first.
+ *
+ * \param evlist
+ *      The sorted vector of events.
+ *
+ * \param e
+ *      The event to be inserted.
+ *
+ * \return
+ *      Returns the iterator before which to insert the event.
+ */
+
+static event::iterator
+sorted_position (event::buffer & evlist, const event & e)
+{
+    if (evlist.empty() || ! (e < evlist.back()))
+        return evlist.end();
+    else
+        return std::upper_bound(evlist.begin(), evlist.end(), e);
 }
 
 /**
  *  An internal function to add events to a temporary list. Used in
- *  quantization and tightening operations.
+ *  quantization and tightening operations.  The list is kept sorted, so
+ *  this is O(log n) to locate plus one insertion.
  */
 
 bool
 eventlist::add (event::buffer & evlist, const event & e)
 {
-    evlist.push_back(e);                        /* std::vector operation    */
-    std::stable_sort(evlist.begin(), evlist.end());
+    (void) evlist.insert(sorted_position(evlist, e), e);
     return true;
 }
 
 /**
- *  Adds an event to the internal event list in a sorted manner.  Note
- *  that, for speed, it is better to call append() for each event, and
- *  then later sort them.
+ *  Adds an event to the internal event list in a sorted manner.  The event
+ *  list must already be sorted.  Locating the position is O(log n), rather
+ *  than the O(n log n) full sort this function used to do.  For a large
+ *  number of events, use append() followed by sort(), or add(buffer).
+ *
+ *  The note links of the events that follow are moved along with them; see
+ *  insert_links().  An append at the end, as in recording, moves nothing,
+ *  and all the links are refreshed only if the vector was reallocated, as
+ *  in append().  The new event is added unlinked.
  *
  * \param e
  *      Provides the event to be added to the list.
  *
  * \return
  *      Returns true.  We assume the insertion succeeded, and no longer
- *      care about an increment in container size.  It's a multimap, so it
- *      always inserts, and if we don't have memory left, all bets are off
- *      anyway.
+ *      care about an increment in container size.  If we don't have memory
+ *      left, all bets are off anyway.
  */
 
 bool
 eventlist::add (const event & e)
 {
-    bool result = append(e);
-    if (result)
-        sort();
+    std::size_t cap = m_events.capacity();
+    auto pos = sorted_position(m_events, e);
+    int index = int(pos - m_events.begin());
+    auto ei = m_events.insert(pos, e);
+    ei->unlink();
+    touch(index, index);
+    if (m_events.capacity() != cap)
+    {
+        insert_links(index);
+        patch_links();                          /* vector was reallocated   */
+    }
+    else if (index < count() - 1)
+        insert_links(index);
+    note_flags(e);
+    return true;
+}
+
+/**
+ *  Adds a batch of events, such as a burst of recorded events, with a
+ *  single merge.  The batch is stable-sorted by itself, appended, and then
+ *  merged with std::inplace_merge(), which is linear in the total size.
+ *  Existing events precede equivalent events from the batch, as with
+ *  repeated calls to add().  Links among the events of the batch are kept.
+ *
+ * \param evlist
+ *      The events to add.  It need not be sorted.
+ *
+ * \return
+ *      Returns true if any events were added.
+ */
 
+bool
+eventlist::add (const event::buffer & evlist)
+{
+    bool result = ! evlist.empty();
+    if (result)
+    {
+        std::size_t oldsize = m_events.size();
+        m_events.reserve(oldsize + evlist.size());
+        for (const auto & e : evlist)
+        {
+            m_events.push_back(e);
+            note_flags(e);
+        }
+        merge_tail(oldsize);
+    }
     return result;
 }
 
 /**
- *  Sorts the event list.  For the vector, equivalent elements are not
- *  guaranteed to keep their original relative order [see
- *  std::stable_sort(), which we could try at some point].
+ *  Sorts the event list.  std::stable_sort() keeps equivalent events in
+ *  their original relative order.  Since the list is now usually kept
+ *  sorted by add(), a linear check first avoids the full sort in that case,
+ *  which makes verify_and_link() cheaper.  The sort is done on positions,
+ *  so that the note links can follow their events; see reorder().
  */
 
 void
 eventlist::sort ()
 {
-    std::stable_sort(m_events.begin(), m_events.end());
+    if (! std::is_sorted(m_events.begin(), m_events.end()))
+    {
+        std::vector<int> order(m_events.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), event_order(m_events));
+        reorder(order);
+    }
 }
 
 /**
  *  An internal function to merge events from a temporary list.  Used in
- *  quantization and tightening operations.
+ *  quantization and tightening operations.  The temporary list is kept
+ *  sorted by add(buffer, event), so a single linear merge suffices.
  */
 
 void
 eventlist::merge (const event::buffer & evlist)
 {
-    std::size_t totalsize = m_events.size() + evlist.size();
-    m_events.reserve(totalsize);
+    std::size_t oldsize = m_events.size();
+    m_events.reserve(oldsize + evlist.size());
     m_events.insert(m_events.end(), evlist.begin(), evlist.end());
-    sort();
+    merge_tail(oldsize);
+}
+
+/**
+ *  Merges the events appended after the first \a oldsize events into their
+ *  sorted positions.  The appended events are taken to be a list of their
+ *  own, so their link indices are offset by \a oldsize.  Each part is
+ *  sorted first, if need be, and then std::inplace_merge() does the rest in
+ *  linear time (given the memory for a buffer).
+ *
+ * \param oldsize
+ *      The number of events that were in the list before the append.
+ */
+
+void
+eventlist::merge_tail (std::size_t oldsize)
+{
+    touch();
+    int offset = int(oldsize);
+    for (auto ei = m_events.begin() + oldsize; ei != m_events.end(); ++ei)
+    {
+        if (ei->is_linked())
+            ei->link_index(ei->link_index() + offset);
+    }
+
+    std::vector<int> order(m_events.size());
+    std::iota(order.begin(), order.end(), 0);
+
+    auto middle = order.begin() + oldsize;
+    event_order less(m_events);
+    if (! std::is_sorted(m_events.begin(), m_events.begin() + oldsize))
+        std::stable_sort(order.begin(), middle, less);
+
+    if (! std::is_sorted(m_events.begin() + oldsize, m_events.end()))
+        std::stable_sort(middle, order.end(), less);
+
+    std::inplace_merge(order.begin(), middle, order.end(), less);
+    reorder(order);
+}
+
+/**
+ *  Moves the events into a new order, and moves the link indices with
+ *  them.  The events are moved back into the same vector, so that no
+ *  iterator into it (e.g. m_match_iterator) is left dangling.
+ *
+ * \param order
+ *      Holds, for each new position, the old position of the event to be
+ *      put there.
+ */
+
+void
+eventlist::reorder (const std::vector<int> & order)
+{
+    touch();
+    int evcount = count();
+    std::vector<int> newindex(evcount);
+    event::buffer moved;
+    moved.reserve(evcount);
+    for (int i = 0; i < evcount; ++i)
+    {
+        newindex[order[i]] = i;
+        moved.push_back(std::move(m_events[order[i]]));
+    }
+    for (int i = 0; i < evcount; ++i)
+    {
+        event & e = moved[i];
+        if (e.is_linked())
+        {
+            int index = e.link_index();
+            if (index >= 0 && index < evcount)
+                e.link_index(newindex[index]);
+            else
+                e.unlink();
+        }
+        m_events[i] = std::move(e);
+    }
+    patch_links();
+}
+
+/**
+ *  Adjusts the link indices after one event has been inserted at the
+ *  given position.  Only the events at or after that position have moved,
+ *  so only the links to them are re-pointed.  An append at the end needs
+ *  no call at all.  If the vector was reallocated, the caller must also
+ *  call patch_links().
+ *
+ * \param index
+ *      The position of the new event.
+ */
+
+void
+eventlist::insert_links (int index)
+{
+    int evcount = count();
+    for (int i = 0; i < evcount; ++i)
+    {
+        event & e = m_events[i];
+        if (i != index && e.is_linked())
+        {
+            int li = e.link_index();
+            if (li >= index)
+                e.link(m_events.begin() + li + 1, li + 1);
+        }
+    }
+}
+
+/**
+ *  Adjusts the link indices after the event at the given position has been
+ *  removed.  An event that was linked to it is unlinked.  As with
+ *  insert_links(), only the links to the events that moved are re-pointed;
+ *  an erase does not reallocate.
+ *
+ * \param index
+ *      The former position of the removed event.
+ */
+
+void
+eventlist::remove_links (int index)
+{
+    for (auto & e : m_events)
+    {
+        if (e.is_linked())
+        {
+            int li = e.link_index();
+            if (li == index)
+                e.unlink();
+            else if (li > index)
+                e.link(m_events.begin() + li - 1, li - 1);
+        }
+    }
+}
+
+/**
+ *  Narrows the range of events known to be unchanged (see clean()) to
+ *  exclude the events now at the given positions.
+ *
+ * \param first
+ *      The position of the first changed or added event, or of the event
+ *      after a removed one.
+ *
+ * \param last
+ *      The position of the last changed or added event.  It is first - 1
+ *      if events were only removed.
+ */
+
+void
+eventlist::touch (int first, int last)
+{
+    if (first < m_clean_head)
+        m_clean_head = first;
+
+    int tail = count() - 1 - last;
+    if (tail < m_clean_tail)
+        m_clean_tail = tail;
+}
+
+/**
+ *  Refreshes each link iterator from its link index.  This is needed after
+ *  any change that moves events in memory: insertion, removal, sorting,
+ *  reallocation, or copying the whole list.  This is a simple linear pass,
+ *  much cheaper than unlinking and relinking all of the notes.
+ */
+
+void
+eventlist::patch_links ()
+{
+    int evcount = count();
+    for (auto & e : m_events)
+    {
+        if (e.is_linked())
+        {
+            int index = e.link_index();
+            if (index >= 0 && index < evcount)
+                e.relink(m_events.begin() + index);
+            else
+                e.unlink();
+        }
+    }
 }
 
 /**
@@ -284,18 +593,22 @@ eventlist::merge (const eventlist & el, bool presort)
         eventlist & el_nc = const_cast<eventlist &>(el);
         el_nc.sort();
     }
-    std::size_t totalsize = m_events.size() + el.m_events.size();
+    std::size_t oldsize = m_events.size();
+    std::size_t totalsize = oldsize + el.m_events.size();
     m_events.reserve(totalsize);
     m_events.insert(m_events.end(), el.m_events.begin(), el.m_events.end());
 
     /*
-     * Done via verify_and_link(): sort();
+     * The links within each list survive the merge, so only the notes left
+     * unlinked need linking, rather than a full verify_and_link().
      */
 
     bool result = m_events.size() == totalsize;
     if (result)
-        verify_and_link();
-
+    {
+        merge_tail(oldsize);
+        (void) link_new(m_link_wraparound);
+    }
     return result;
 }
 
@@ -305,6 +618,14 @@ eventlist::merge (const eventlist & el, bool presort)
  *  does not depend on any external data.  Also note that any desired
  *  thread-safety must be provided by the caller.
  *
+ *  This is done in a single pass over the events.  Each unlinked Note On is
+ *  queued, by channel and pitch, as an open note; each unlinked Note Off
+ *  closes the oldest open note with the same channel and pitch.  This gives
+ *  the same pairing as the old search forward from each Note On for its Note
+ *  Off, but in linear time instead of quadratic time.  A Note Off that finds
+ *  no open note is held for the wraparound step.  The queues are intrusive
+ *  lists of event indices, so only three small vectors are allocated.
+ *
  * Link wraparound:
  *
  *      This is a Stazed addition; not in seq24.  Not sure that we need it, it
@@ -317,6 +638,11 @@ eventlist::merge (const eventlist & el, bool presort)
  *      With it, the note extends to the end of the pattern and then wraps
  *      around to the beginning.
  *
+ *      After the pass, any Note Offs still held all precede the Note Ons
+ *      still open on the same channel and pitch, so they are paired in
+ *      order.  If wrapping is not enabled, the Note Off is moved to the end
+ *      of the pattern.
+ *
  *      For recording, to avoid issues, make the pattern length one measure
  *      longer than desired while recording.
  *
@@ -333,37 +659,82 @@ eventlist::merge (const eventlist & el, bool presort)
 bool
 eventlist::link_new (bool wrap)
 {
+    static const int s_key_count = 16 * 128;            /* channel x pitch  */
     bool result = false;
-    for (auto eon = m_events.begin(); eon != m_events.end(); ++eon)
+    int evcount = count();
+    std::vector<int> onqueue(2 * s_key_count, (-1));    /* head/tail, ons   */
+    std::vector<int> offqueue(2 * s_key_count, (-1));   /* head/tail, offs  */
+    std::vector<int> next(evcount, (-1));               /* intrusive links  */
+    auto enqueue = [&next] (std::vector<int> & q, int key, int index)
+    {
+        int & head = q[2 * key];
+        int & tail = q[2 * key + 1];
+        if (tail >= 0)
+            next[tail] = index;
+        else
+            head = index;
+
+        tail = index;
+    };
+    auto dequeue = [&next] (std::vector<int> & q, int key)
     {
-        if (eon->on_linkable())                     /* note-on, not linked  */
+        int & head = q[2 * key];
+        int index = head;
+        if (index >= 0)
         {
-            bool endfound = false;                  /* end-of-note flag     */
-            auto eoff = eon;                        /* point to note on     */
-            ++eoff;                                 /* get next element     */
-            while (eoff != m_events.end())
+            head = next[index];
+            if (head < 0)
+                q[2 * key + 1] = (-1);
+        }
+        return index;
+    };
+    auto notekey = [] (const event & e)
+    {
+        return int(e.channel() & 0x0F) * 128 + int(e.get_note() & 0x7F);
+    };
+    for (int i = 0; i < evcount; ++i)
+    {
+        const event & e = m_events[i];
+        if (e.on_linkable())                        /* note-on, not linked  */
+        {
+            enqueue(onqueue, notekey(e), i);
+        }
+        else if (e.off_linkable())                  /* note-off, not linked */
+        {
+            int key = notekey(e);
+            int on = dequeue(onqueue, key);
+            if (on >= 0)
             {
-                endfound = link_notes(eon, eoff);   /* calls off_linkable() */
-                if (endfound)
-                {
+                auto eon = m_events.begin() + on;
+                if (link_notes(eon, m_events.begin() + i))
                     result = true;
-                    break;
-                }
-                ++eoff;
             }
-            if (! endfound)
+            else
+                enqueue(offqueue, key, i);
+        }
+    }
+    for (int key = 0; key < s_key_count; ++key)
+    {
+        for (;;)
+        {
+            int off = offqueue[2 * key];            /* peek, both non-empty */
+            int on = onqueue[2 * key];
+            if (off < 0 || on < 0)
+                break;
+
+            (void) dequeue(offqueue, key);
+            (void) dequeue(onqueue, key);
+
+            auto eon = m_events.begin() + on;
+            auto eoff = m_events.begin() + off;
+            bool wrapped = eoff->timestamp() < eon->timestamp();
+            if (link_notes(eon, eoff))
             {
-                eoff = m_events.begin();
-                while (eoff != eon)
+                result = true;
+                if (wrapped && ! wrap)
                 {
-                    bool wrapped = eoff->timestamp() < eon->timestamp();
-                    if (link_notes(eon, eoff))
-                    {
-                        result = true;
-                        if (wrapped && ! wrap)
-                            eoff->set_timestamp(get_length() - 1);
-                    }
-                    ++eoff;
+                    eoff->set_timestamp(get_length() - 1);
+                    touch(off, off);
                 }
             }
         }
@@ -403,6 +774,7 @@ eventlist::link_new (bool wrap)
 void
 eventlist::link_new_note ()
 {
+    touch();
     if (count() > 1)
     {
         bool done = false;
@@ -485,13 +857,15 @@ eventlist::link_notes (event::iterator eon, event::iterator eoff)
     bool result = eon->off_linkable(eoff);
     if (result)
     {
-        eon->link(eoff);
-        eoff->link(eon);
+        eon->link(eoff, int(eoff - m_events.begin()));
+        eoff->link(eon, int(eon - m_events.begin()));
         if (eon->timestamp() == eoff->timestamp())
         {
             long ts = eon->timestamp();
+            int offindex = int(eoff - m_events.begin());
             ts += m_zero_len_correction;
             eoff->set_timestamp(ts);
+            touch(offindex, offindex);
 #if defined SEQ66_PLATFORM_DEBUG_TMI
             printf ("Zero-length note @%ld fixed\n", ts);
 #endif
@@ -564,6 +938,7 @@ eventlist::verify_and_link (midipulse slength, bool wrap)
 void
 eventlist::clear ()
 {
+    touch();
     if (! m_events.empty())
     {
         m_events.clear();
@@ -709,6 +1084,7 @@ eventlist::first_notes (midipulse & ts, int & n, midipulse snap) const
 bool
 eventlist::edge_fix (midipulse snap, midipulse seqlength)
 {
+    touch();
     bool result = false;
     for (auto & e : m_events)
     {
@@ -743,6 +1119,7 @@ eventlist::edge_fix (midipulse snap, midipulse seqlength)
 bool
 eventlist::remove_unlinked_notes ()
 {
+    touch();
     bool result = false;
     for (auto i = m_events.begin(); i != m_events.end(); /*++i*/)
     {
@@ -807,6 +1184,7 @@ eventlist::quantize_events
     int snap, int divide
 )
 {
+    touch();
     bool result = false;
     midipulse len = get_length();
     bool tight = divide == 2;
@@ -893,6 +1271,7 @@ eventlist::quantize_events
 bool
 eventlist::quantize_events (int snap, int divide, bool all)
 {
+    touch();
     bool result = false;
     bool tight = divide == 2;
     bool found_note = false;
@@ -936,6 +1315,7 @@ eventlist::quantize_events (int snap, int divide, bool all)
 bool
 eventlist::quantize_notes (int snap, int divide, bool all)
 {
+    touch();
     bool result = false;
     midipulse len = get_length();
     bool tight = divide == 2;
@@ -1007,6 +1387,7 @@ eventlist::quantize_notes (int snap, int divide, bool all)
 midipulse
 eventlist::adjust_timestamp (event & er, midipulse delta_tick)
 {
+    touch();
     static const bool s_allow_wrap = true;  /* wrap: note on after note-off */
     midipulse result = er.timestamp() + delta_tick;
     midipulse len = get_length();
@@ -1067,6 +1448,7 @@ eventlist::adjust_timestamp (event & er, midipulse delta_tick)
 bool
 eventlist::move_selected_notes (midipulse delta_tick, int delta_note)
 {
+    touch();
     bool result = false;
     for (auto & er : m_events)
     {
@@ -1097,6 +1479,7 @@ eventlist::move_selected_notes (midipulse delta_tick, int delta_note)
 bool
 eventlist::move_selected_events (midipulse delta_tick)
 {
+    touch();
     bool result = false;
     for (auto & er : m_events)
     {
@@ -1125,6 +1508,7 @@ eventlist::move_selected_events (midipulse delta_tick)
 bool
 eventlist::align_left (bool relink)
 {
+    touch();
     bool result = ! empty();
     if (result)
     {
@@ -1170,6 +1554,7 @@ eventlist::align_left (bool relink)
 bool
 eventlist::align_right (bool relink)
 {
+    touch();
     bool result = ! empty();
     if (result)
     {
@@ -1209,6 +1594,7 @@ eventlist::align_right (bool relink)
 void
 eventlist::scale_note_off (event & noteoff, double factor)
 {
+    touch();
     midipulse stamp = noteoff.timestamp();
     stamp += note_off_margin();                     /* remove the margin    */
     stamp *= factor;                                /* scale the note off   */
@@ -1247,6 +1633,7 @@ eventlist::scale_note_off (event & noteoff, double factor)
 midipulse
 eventlist::apply_time_factor (double factor, bool savenotelength, bool relink)
 {
+    touch();
     midipulse result = 0;
     bool ok = ! empty() && factor > 0.01;
     if (ok)
@@ -1309,6 +1696,7 @@ eventlist::apply_time_factor (double factor, bool savenotelength, bool relink)
 bool
 eventlist::reverse_events (bool inplace, bool relink)
 {
+    touch();
     bool result = ! empty();
     if (result)
     {
@@ -1378,6 +1766,7 @@ eventlist::reverse_events (bool inplace, bool relink)
 bool
 eventlist::randomize (midibyte astatus, int range, bool all)
 {
+    touch();
     bool result = false;
     if (range > 0)
     {
@@ -1413,6 +1802,7 @@ eventlist::randomize (midibyte astatus, int range, bool all)
 bool
 eventlist::randomize_note_velocities (int range, bool all)
 {
+    touch();
     bool result = range > 0;
     if (result)
     {
@@ -1469,6 +1859,7 @@ eventlist::randomize_note_pitches
     int range, scales s, keys keyofpattern, bool all
 )
 {
+    touch();
     bool result = range > 0;
     if (result)
     {
@@ -1577,6 +1968,7 @@ eventlist::randomize_note_pitches
 bool
 eventlist::jitter_events (int snap, int jitr)
 {
+    touch();
     bool result = false;
     if (jitr > 0)
     {
@@ -1654,6 +2046,7 @@ eventlist::jitter_events (int snap, int jitr)
 bool
 eventlist::jitter_notes (int snap, int jitr, bool all)
 {
+    touch();
     bool result = false;
     if (jitr > 0)
     {
@@ -1729,7 +2122,7 @@ eventlist::link_tempos ()
                 if (t2->is_tempo())
                 {
                     result = true;
-                    t->link(t2);
+                    t->link(t2, int(t2 - m_events.begin()));
                     break;                  /* tempos link only one way     */
                 }
                 ++t2;
@@ -1918,6 +2311,7 @@ eventlist::remove_event (event & e)
 event::iterator
 eventlist::find_first_match (const event & e, midipulse starttick)
 {
+    touch();
     event::iterator result = m_events.end();
     for (auto i = m_events.begin(); i != m_events.end(); ++i)
     {
@@ -1940,6 +2334,7 @@ eventlist::find_first_match (const event & e, midipulse starttick)
 event::iterator
 eventlist::find_next_match (const event & e)
 {
+    touch();
     event::iterator result = m_events.end();
     if (m_match_iterating)
     {
@@ -1975,6 +2370,7 @@ eventlist::find_next_match (const event & e)
 bool
 eventlist::remove_time_signature (midipulse target)
 {
+    touch();
     bool result = false;
     for (auto i = m_events.begin(); i != m_events.end(); ++i)
     {
@@ -2040,18 +2436,10 @@ eventlist::remove_first_match (const event & e, midipulse starttick)
 bool
 eventlist::remove_marked ()
 {
-    bool result = false;
-    for (auto i = m_events.begin(); i != m_events.end(); /*++i*/)
-    {
-        if (i->is_marked())
-        {
-            auto t = remove(i);
-            i = t;
-            result = true;
-        }
-        else
-            ++i;
-    }
+    bool result = remove_if
+    (
+        [] (const event & e) { return e.is_marked(); }
+    );
     if (result)
         verify_and_link();
 
@@ -2075,6 +2463,7 @@ eventlist::remove_marked ()
 bool
 eventlist::remove_trailing_events (midipulse limit)
 {
+    touch();
     bool result = false;
     for (auto i = m_events.begin(); i != m_events.end(); /*++i*/)
     {
@@ -2119,21 +2508,74 @@ eventlist::remove_trailing_events (midipulse limit)
 bool
 eventlist::remove_selected ()
 {
-    bool result = false;
-    for (auto i = m_events.begin(); i != m_events.end(); /*++i*/)
+    bool result = remove_if
+    (
+        [] (const event & e) { return e.is_selected(); }
+    );
+    if (result)
+        verify_and_link();
+
+    return result;
+}
+
+/**
+ *  Removes all of the events that satisfy the predicate in a single
+ *  compacting pass, instead of erasing them one at a time, which moves the
+ *  rest of the vector and adjusts the links for each removal.  The links of
+ *  the remaining events are kept; an event whose partner was removed is
+ *  unlinked.
+ *
+ * \param pred
+ *      Returns true for each event to remove.
+ *
+ * \return
+ *      Returns true if at least one event was removed.
+ */
+
+bool
+eventlist::remove_if (const std::function<bool (const event &)> & pred)
+{
+    int evcount = count();
+    std::vector<int> newindex(evcount, (-1));
+    int kept = 0;
+    int first = (-1), last = (-1);              /* removed range, old index */
+    for (int i = 0; i < evcount; ++i)
     {
-        if (i->is_selected())
+        if (! pred(m_events[i]))
         {
-            auto t = remove(i);
-            i = t;
-            result = true;
+            newindex[i] = kept;
+            if (kept != i)
+                m_events[kept] = std::move(m_events[i]);
+
+            ++kept;
         }
         else
-            ++i;
+        {
+            if (first < 0)
+                first = i;
+
+            last = i;
+        }
     }
+    bool result = kept < evcount;
     if (result)
-        verify_and_link();
-
+    {
+        m_events.resize(kept);
+        touch(first, last + kept - evcount);    /* events after last stay   */
+        for (auto & e : m_events)
+        {
+            if (e.is_linked())
+            {
+                int index = e.link_index();
+                if (index >= 0 && index < evcount && newindex[index] >= 0)
+                    e.link_index(newindex[index]);
+                else
+                    e.unlink();
+            }
+        }
+        patch_links();
+        m_is_modified = true;
+    }
     return result;
 }
 
@@ -2316,6 +2758,7 @@ eventlist::select_notes_by_channel (int channel)
 bool
 eventlist::set_channels (int channel)
 {
+    touch();
     bool result = false;
     midibyte target = midibyte(channel);
     for (auto & er : m_events)
@@ -2865,6 +3308,7 @@ eventlist::get_selected_events_interval
 bool
 eventlist::rescale (int newppqn, int oldppqn)
 {
+    touch();
     bool result = oldppqn > 0;
     if (result)
     {
@@ -2895,6 +3339,7 @@ eventlist::rescale (int newppqn, int oldppqn)
 bool
 eventlist::stretch_selected (midipulse delta)
 {
+    touch();
     midipulse first_ev, last_ev;
     bool result = get_selected_events_interval(first_ev, last_ev);
     if (result)
@@ -2968,6 +3413,7 @@ eventlist::stretch_selected (midipulse delta)
 bool
 eventlist::grow_selected (midipulse delta, int snap)
 {
+    touch();
     bool result = false;
     for (auto & er : m_events)
     {
@@ -3009,7 +3455,7 @@ eventlist::copy_selected (eventlist & clipbd)
     for (auto & e : m_events)
     {
         if (e.is_selected())
-            clipbd.add(e);                              /* sorts every time */
+            clipbd.add(e);                              /* sorted insertion */
     }
     if (! clipbd.empty())
     {
@@ -3035,6 +3481,7 @@ eventlist::copy_selected (eventlist & clipbd)
 bool
 eventlist::paste_selected (eventlist & clipbd, midipulse tick, int note)
 {
+    touch();
     bool result = false;
     if (! clipbd.empty())
     {
@@ -0,0 +1,618 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          eventundo.cpp
+ *
+ *  This module defines the undo/redo log of a pattern's events.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-15
+ * \updates       2026-10-15
+ * \license       GNU GPLv2 or above
+ *
+ *  See the eventundo.hpp module for the rationale.
+ */
+
+#include <algorithm>                    /* std::min(), std::copy()          */
+#include <iterator>                     /* std::make_move_iterator()        */
+
+#include "cfg/scales.hpp"               /* scales and keys for eventlist    */
+#include "midi/eventlist.hpp"           /* seq66::eventlist                 */
+#include "midi/eventundo.hpp"           /* seq66::eventundo, eventdelta     */
+#include "os/timing.hpp"                /* seq66::millitime()               */
+
+namespace seq66
+{
+
+/**
+ *  Edits announced within this many milliseconds of the previous one can be
+ *  merged with it.  This is long enough to catch the steps of a mouse drag
+ *  or a slider, and of an auto-repeating key.
+ */
+
+static const long c_undo_merge_ms = 500;
+
+/**
+ *  Marks a link that pointed into a changed range.  It cannot be derived by
+ *  shifting, so it must be recorded.
+ */
+
+static const int c_link_lost = (-2);
+
+/**
+ *  Gets the link index of an event, or -1 if it is not linked.
+ */
+
+static int
+link_of (const event & e)
+{
+    return e.is_linked() ? e.link_index() : (-1) ;
+}
+
+/**
+ *  Maps a link index across a change of the events in a range.
+ *
+ * \param li
+ *      The link index before the change.
+ *
+ * \param index
+ *      The start of the range.
+ *
+ * \param oldcount
+ *      The number of events in the range before the change.
+ *
+ * \param newcount
+ *      The number of events in the range after the change.
+ *
+ * \return
+ *      Returns the link index after the change, or c_link_lost if it
+ *      pointed into the range.  A negative index is returned as is.
+ */
+
+static int
+map_link (int li, int index, int oldcount, int newcount)
+{
+    if (li < index)
+        return li;
+    else if (li >= index + oldcount)
+        return li - oldcount + newcount;
+    else
+        return c_link_lost;
+}
+
+/*
+ * -------------------------------------------------------------------------
+ *  eventdelta
+ * -------------------------------------------------------------------------
+ */
+
+eventdelta::eventdelta () :
+    m_index     (0),
+    m_count     (0),
+    m_events    (),
+    m_links     (),
+    m_time_ms   (0)
+{
+    // no code
+}
+
+/**
+ *  Estimates the memory held by the entry, for the budget.
+ */
+
+std::size_t
+eventdelta::bytes () const
+{
+    std::size_t result = sizeof(eventdelta);
+    result += m_events.capacity() * sizeof(event);
+    result += m_links.capacity() * sizeof(linkfix);
+    for (const auto & e : m_events)
+        result += std::size_t(e.sysex_size());
+
+    return result;
+}
+
+/*
+ * -------------------------------------------------------------------------
+ *  eventundo
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ *  Constructor.
+ *
+ * \param budget
+ *      The most memory, in bytes, that the logs can hold.  If 0, there is no
+ *      limit.
+ */
+
+eventundo::eventundo (std::size_t budget) :
+    m_undo          (),
+    m_redo          (),
+    m_pending       (),
+    m_pending_links (),
+    m_have_pending  (false),
+    m_pending_edit  (false),
+    m_pending_ms    (0),
+    m_bytes         (0),
+    m_budget        (budget)
+{
+    // no code
+}
+
+/**
+ *  Announces an edit.  The previous edit, if any, is committed to the undo
+ *  log, and the events are copied so that the coming edit can be found.
+ *
+ * \param current
+ *      The events, which are about to be edited.
+ */
+
+void
+eventundo::push (eventlist & current)
+{
+    commit(current);
+    snapshot(current, true);
+}
+
+/**
+ *  Announces an edit, but the events to undo to are given.  This supports
+ *  the (unused) stazed undo-hold list.
+ *
+ * \param current
+ *      The events, which are about to be edited.
+ *
+ * \param before
+ *      The events to restore upon undo.
+ */
+
+void
+eventundo::push (eventlist & current, const eventlist & before)
+{
+    commit(current);
+    m_pending = before.m_events;
+    m_pending_links.clear();
+    for (const auto & e : m_pending)
+        m_pending_links.push_back(link_of(e));
+
+    m_have_pending = m_pending_edit = true;
+    m_pending_ms = millitime();
+    current.touch();                    /* the copy is not of the events    */
+}
+
+/**
+ *  Undoes the last edit.  An edit still pending is committed first, so that
+ *  it is the one undone.
+ *
+ * \param evl
+ *      The events to modify.
+ *
+ * \return
+ *      Returns true if an edit was undone.  The caller must unselect the
+ *      events and mark the playback copy as stale.
+ */
+
+bool
+eventundo::undo (eventlist & evl)
+{
+    return restore(evl, m_undo, m_redo);
+}
+
+/**
+ *  Redoes the last undone edit.  If the events were changed since the undo,
+ *  the redo log no longer applies, and is cleared instead.
+ */
+
+bool
+eventundo::redo (eventlist & evl)
+{
+    return restore(evl, m_redo, m_undo);
+}
+
+void
+eventundo::clear ()
+{
+    m_undo.clear();
+    m_redo.clear();
+    m_have_pending = m_pending_edit = false;
+    m_bytes = 0;
+}
+
+/**
+ *  Compares the copy made at the last push(), undo(), or redo() to the
+ *  events, and adds the difference, if any, to the undo log.  Only the
+ *  events that the eventlist does not know to be unchanged are compared,
+ *  and only those that changed are copied, to bring the copy up to date.
+ *  Any change invalidates the redo log.  An edit that closely follows the
+ *  previous one, and changes only events that the previous one changed, is
+ *  merged into it.
+ */
+
+void
+eventundo::commit (eventlist & current)
+{
+    if (m_have_pending)
+    {
+        eventdelta d = diff
+        (
+            m_pending, m_pending_links, current.m_events,
+            current.clean_head(), current.clean_tail()
+        );
+        d.m_time_ms = m_pending_ms;
+        if (! d.empty())
+        {
+            update(current, d.m_index, int(d.m_events.size()));
+            for (const auto & r : m_redo)
+                m_bytes -= r.bytes();
+
+            m_redo.clear();
+
+            bool merged = false;
+            if (m_pending_edit && ! m_undo.empty() && d.m_links.empty())
+            {
+                eventdelta & top = m_undo.back();
+                long elapsed = d.m_time_ms - top.m_time_ms;
+                int oldcount = int(d.m_events.size());
+                merged = elapsed >= 0 && elapsed <= c_undo_merge_ms &&
+                    d.m_index >= top.m_index &&
+                    d.m_index + oldcount <= top.m_index + top.m_count;
+
+                if (merged)
+                {
+                    top.m_count += d.m_count - oldcount;
+                    top.m_time_ms = d.m_time_ms;
+                }
+            }
+            if (! merged)
+                add(m_undo, std::move(d));
+        }
+        m_pending_edit = false;
+    }
+}
+
+void
+eventundo::add (deltas & log, eventdelta && d)
+{
+    m_bytes += d.bytes();
+    log.push_back(std::move(d));
+    trim();
+}
+
+/**
+ *  Drops the oldest entries, undo entries first, until the logs fit in the
+ *  budget.  The newest undo entry is always kept.
+ */
+
+void
+eventundo::trim ()
+{
+    if (m_budget > 0)
+    {
+        while (m_bytes > m_budget && m_undo.size() > 1)
+        {
+            m_bytes -= m_undo.front().bytes();
+            m_undo.pop_front();
+        }
+        while (m_bytes > m_budget && ! m_redo.empty())
+        {
+            m_bytes -= m_redo.front().bytes();
+            m_redo.pop_front();
+        }
+    }
+}
+
+/**
+ *  Applies the newest entry of one log to the events, and adds the entry
+ *  that reverses it to the other log.
+ *
+ * \param evl
+ *      The events to modify.
+ *
+ * \param from
+ *      The log to take the entry from.
+ *
+ * \param to
+ *      The log to add the reverse entry to.
+ *
+ * \return
+ *      Returns true if an entry was applied.
+ */
+
+bool
+eventundo::restore (eventlist & evl, deltas & from, deltas & to)
+{
+    commit(evl);
+
+    bool result = ! from.empty();
+    if (result)
+    {
+        eventdelta & d = from.back();
+        result = d.m_index >= 0 && d.m_index + d.m_count <= evl.count();
+        if (result)
+        {
+            m_bytes -= d.bytes();
+
+            eventdelta reverse = apply(evl.m_events, d);
+            from.pop_back();
+            for (int i = 0; i < reverse.m_count; ++i)
+                evl.note_flags(evl.m_events[reverse.m_index + i]);
+
+            evl.m_is_modified = true;
+            evl.patch_links();
+            update(evl, reverse.m_index, int(reverse.m_events.size()));
+            add(to, std::move(reverse));
+        }
+        else
+            clear();                            /* out of step, give up     */
+    }
+    snapshot(evl, false);
+    return result;
+}
+
+/**
+ *  Starts watching for the next edit.  The copy of the events was brought up
+ *  to date by commit(), so it is made in full only the first time.  The link
+ *  indices and the selection are noted, and the events are marked as
+ *  unchanged.
+ *
+ * \param current
+ *      The events, which must match the copy if there is one.
+ *
+ * \param edit
+ *      True if an edit is coming, false if the copy only guards against
+ *      changes made without announcing them.
+ */
+
+void
+eventundo::snapshot (eventlist & current, bool edit)
+{
+    if (! m_have_pending)
+    {
+        m_pending = current.m_events;
+        m_have_pending = true;
+    }
+
+    int evcount = current.count();
+    m_pending_links.resize(std::size_t(evcount));
+    for (int i = 0; i < evcount; ++i)
+    {
+        const event & e = current.m_events[i];
+        m_pending_links[i] = link_of(e);
+        if (e.is_selected())                /* a selection is not an edit   */
+            m_pending[i].select();
+        else
+            m_pending[i].unselect();
+    }
+
+    current.clean();
+    m_pending_edit = edit;
+    m_pending_ms = millitime();
+}
+
+/**
+ *  Brings the copy of the events up to date after a change to one range of
+ *  them, by copying only the events now in that range.
+ *
+ * \param current
+ *      The events after the change.
+ *
+ * \param index
+ *      The start of the range.
+ *
+ * \param oldcount
+ *      The number of events in the range in the copy.
+ */
+
+void
+eventundo::update (const eventlist & current, int index, int oldcount)
+{
+    int newcount = oldcount + current.count() - int(m_pending.size());
+    int common = std::min(oldcount, newcount);
+    auto source = current.m_events.cbegin() + index;
+    auto dest = m_pending.begin() + index;
+    std::copy(source, source + common, dest);
+    if (newcount > oldcount)
+        m_pending.insert(dest + common, source + common, source + newcount);
+    else if (oldcount > newcount)
+        m_pending.erase(dest + common, dest + oldcount);
+}
+
+/**
+ *  Compares events, ignoring the selection and other editing flags, and
+ *  the links, which are compared separately.
+ */
+
+bool
+eventundo::same_event (const event & e1, const event & e2)
+{
+    return
+        e1.timestamp() == e2.timestamp() &&
+        e1.get_status() == e2.get_status() &&
+        e1.channel() == e2.channel() &&
+        e1.d0() == e2.d0() && e1.d1() == e2.d1() &&
+        e1.get_sysex() == e2.get_sysex();
+}
+
+/**
+ *  Makes the entry that turns the events after an edit back into the events
+ *  before it.
+ *
+ * \param before
+ *      The events before the edit.
+ *
+ * \param beforelinks
+ *      The link indices of the events before the edit.
+ *
+ * \param after
+ *      The events after the edit.
+ *
+ * \param cleanhead
+ *      The number of leading events known to be unchanged, which are not
+ *      compared.  See eventlist::clean_head().
+ *
+ * \param cleantail
+ *      The number of trailing events known to be unchanged.
+ *
+ * \return
+ *      Returns the entry.  It is empty if the edit changed nothing.
+ */
+
+eventdelta
+eventundo::diff
+(
+    const event::buffer & before,
+    const std::vector<int> & beforelinks,
+    const event::buffer & after,
+    int cleanhead, int cleantail
+)
+{
+    eventdelta result;
+    int nb = int(before.size());
+    int na = int(after.size());
+    int shortest = std::min(nb, na);
+    int head = std::min(cleanhead, shortest);
+    while (head < nb && head < na && same_event(before[head], after[head]))
+        ++head;
+
+    int tail = std::min(cleantail, shortest - head);
+    while
+    (
+        tail < nb - head && tail < na - head &&
+        same_event(before[nb - 1 - tail], after[na - 1 - tail])
+    )
+    {
+        ++tail;
+    }
+
+    int bcount = nb - head - tail;
+    int acount = na - head - tail;
+    result.m_index = head;
+    result.m_count = acount;
+    result.m_events.assign
+    (
+        before.begin() + head, before.begin() + head + bcount
+    );
+    for (int k = 0; k < bcount; ++k)
+    {
+        event & e = result.m_events[k];
+        int bl = beforelinks[head + k];
+        if (bl >= 0)
+            e.link(e.link(), bl);               /* see patch_links()        */
+        else
+            e.unlink();
+    }
+    for (int i = 0; i < nb; ++i)
+    {
+        if (i == head && bcount > 0)
+        {
+            i += bcount;                        /* skip the changed range   */
+            if (i == nb)
+                break;
+        }
+
+        int j = i < head ? i : i + acount - bcount ;
+        int al = link_of(after[j]);
+        int bl = beforelinks[i];
+        if (map_link(al, head, acount, bcount) != bl)
+            result.m_links.push_back(eventdelta::linkfix(i, bl));
+    }
+    return result;
+}
+
+/**
+ *  Applies an entry to the events.  The events of the entry are moved into
+ *  place, and the events they replace are moved into the reverse entry.
+ *  The links of the other events are shifted, or restored from the entry.
+ *
+ * \param evs
+ *      The events, which must match the entry.
+ *
+ * \param d
+ *      The entry.  Its events are moved out.
+ *
+ * \return
+ *      Returns the reverse entry.
+ */
+
+eventdelta
+eventundo::apply (event::buffer & evs, eventdelta & d)
+{
+    eventdelta result;
+    int index = d.m_index;
+    int acount = d.m_count;
+    int bcount = int(d.m_events.size());
+    auto first = evs.begin() + index;
+    result.m_index = index;
+    result.m_count = bcount;
+    result.m_time_ms = d.m_time_ms;
+    result.m_events.assign
+    (
+        std::make_move_iterator(first),
+        std::make_move_iterator(first + acount)
+    );
+    first = evs.erase(first, first + acount);
+    evs.insert
+    (
+        first,
+        std::make_move_iterator(d.m_events.begin()),
+        std::make_move_iterator(d.m_events.end())
+    );
+    d.m_events.clear();
+
+    int nb = int(evs.size());
+    auto lf = d.m_links.cbegin();
+    for (int i = 0; i < nb; ++i)
+    {
+        if (i == index && bcount > 0)
+        {
+            i += bcount;                        /* skip the restored range  */
+            if (i == nb)
+                break;
+        }
+
+        event & e = evs[i];
+        int al = link_of(e);
+        int bl = map_link(al, index, acount, bcount);
+        while (lf != d.m_links.cend() && lf->first < i)
+            ++lf;
+
+        if (lf != d.m_links.cend() && lf->first == i)
+            bl = lf->second;
+
+        if (bl >= 0 && bl < nb)
+            e.link(evs.begin() + bl, bl);
+        else
+            e.unlink();
+
+        int j = i < index ? i : i + acount - bcount ;
+        if (map_link(bl, index, bcount, acount) != al)
+            result.m_links.push_back(eventdelta::linkfix(j, al));
+    }
+    return result;
+}
+
+}           // namespace seq66
+
+/*
+ * eventundo.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-09-14
- * \updates       2026-05-10
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  This module was created from code that existed in the performer object.
@@ -2137,7 +2137,9 @@ jack_timebase_callback
 )
 {
     jack_assistant * jack = static_cast<jack_assistant *>(arg);
-    pos->beats_per_minute = jack->get_beats_per_minute();   /* sooperlooper */
+    midibpm clockbpm = jack->parent().midi_clock_bpm();     /* following?   */
+    pos->beats_per_minute = clockbpm > 0.0 ?
+        clockbpm : jack->get_beats_per_minute() ;           /* sooperlooper */
     pos->beats_per_bar = jack->beats_per_measure();
     pos->beat_type = jack->beat_width();
     pos->ticks_per_beat = jack->get_ppqn() * double(c_jack_factor);
@@ -2180,7 +2182,7 @@ jack_timebase_callback
                 pos->bar_start_tick += ticks_per_bar;
             }
         }
-        if (jack->is_master())
+        if (jack->is_master() && clockbpm == 0.0)
             pos->beats_per_minute = jack->parent().get_beats_per_minute();
     }
     pos->bbt_offset = 0;
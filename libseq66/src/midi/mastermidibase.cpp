@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2016-11-23
- * \updates       2026-05-18
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  This file provides a base-class implementation for various master MIDI
@@ -40,6 +40,7 @@
 #include "midi/midibus.hpp"             /* seq66::midibus class             */
 #include "play/sequence.hpp"            /* seq66::sequence                  */
 #include "os/timing.hpp"                /* seq66::microsleep()              */
+#include "util/perfcounters.hpp"        /* seq66::perf_counters()           */
 
 namespace seq66
 {
@@ -78,6 +79,9 @@ mastermidibase::mastermidibase
     m_record_by_buss    (false),        /* set based on configuration       */
     m_record_by_channel (false),        /* ditto, but mutually exclusive    */
     m_seq               (nullptr),
+    m_batching          (false),
+    m_batch_thread      (),
+    m_pulse_clock       (),
     m_mutex             ()
 {
     // Empty body now
@@ -204,14 +208,16 @@ mastermidibase::stop ()
  * \threadsafe
  *
  * \param tick
- *      Provides the tick value with which to set the buss clock.
+ *      Provides the tick value with which to set the buss clock.  Called
+ *      by the output thread, so each clock gets the time of its pulse from
+ *      the pulse clock, if valid.
  */
 
 void
 mastermidibase::emit_clock (midipulse tick)
 {
     automutex locker(m_mutex);
-    m_outbus_array.clock(tick);
+    m_outbus_array.clock(tick, &m_pulse_clock);
 }
 
 /**
@@ -261,8 +267,11 @@ mastermidibase::set_beats_per_minute (midibpm bpm)
 void
 mastermidibase::flush ()
 {
-    automutex locker(m_mutex);
-    api_flush();
+    if (! batching())                   /* commit_batch() will flush    */
+    {
+        automutex locker(m_mutex);
+        api_flush();
+    }
 }
 
 /**
@@ -331,18 +340,129 @@ mastermidibase::sysex (bussbyte bus, const event * ev)
 void
 mastermidibase::play (bussbyte bus, event * e24, midibyte channel)
 {
-    automutex locker(m_mutex);
-    m_outbus_array.play(bus, e24, channel);
+    perf_counters().output_event(bus);
+    if (batching())
+    {
+        m_outbus_array.queue(bus, e24, channel);
+    }
+    else
+    {
+        automutex locker(m_mutex);
+        m_outbus_array.play(bus, e24, channel);
+    }
 }
 
 void
 mastermidibase::play_and_flush (bussbyte bus, event * e24, midibyte channel)
 {
+    perf_counters().output_event(bus);
+    if (batching())
+    {
+        m_outbus_array.queue(bus, e24, channel);
+    }
+    else
+    {
+        automutex locker(m_mutex);
+        m_outbus_array.play(bus, e24, channel);
+        api_flush();
+    }
+}
+
+/**
+ *  Starts an output cycle.  Until commit_batch() is called, events played
+ *  by the calling thread are queued per buss instead of being sent
+ *  immediately.  Called by performer::play() before asking each pattern to
+ *  play its events for the cycle.
+ */
+
+void
+mastermidibase::begin_batch ()
+{
+    m_batch_thread.store
+    (
+        std::this_thread::get_id(), std::memory_order_relaxed
+    );
+    m_batching = true;
+}
+
+/**
+ *  Ends the output cycle started by begin_batch().  Each buss plays its
+ *  queued events under one lock and is flushed once, and then the master
+ *  buss is flushed.  This replaces the lock/play/flush round trip made for
+ *  every event when not batching.
+ */
+
+void
+mastermidibase::commit_batch ()
+{
+    m_batching = false;
+
     automutex locker(m_mutex);
-    m_outbus_array.play(bus, e24, channel);
+    m_outbus_array.commit(m_pulse_clock);
     api_flush();
 }
 
+/**
+ *  The version of commit_batch() used by the JACK process callback (see
+ *  performer::pull_play()), which must never wait on a lock.  If the master
+ *  lock or the lock of a port is held by another thread (say, the output
+ *  thread emitting MIDI clock, or a GUI changing the ports), the events
+ *  involved stay queued, and go out at the start of the next cycle.
+ *
+ * \return
+ *      Returns true if all of the queued events were sent.
+ */
+
+bool
+mastermidibase::try_commit_batch ()
+{
+    m_batching = false;
+
+    bool result = m_mutex.try_lock();
+    if (result)
+    {
+        result = m_outbus_array.try_commit(m_pulse_clock);
+        api_flush();
+        m_mutex.unlock();
+    }
+    return result;
+}
+
+/**
+ *  Hands the pull-mode callback to the MIDI engine, which then calls it at
+ *  the start of each of its process cycles.  See performer::pull_cycle().
+ *
+ * \param f
+ *      The callback, or nullptr to go back to the output thread.
+ *
+ * \param arg
+ *      The pointer passed back to the callback.
+ *
+ * \return
+ *      Returns true if the engine supports pull mode.
+ */
+
+bool
+mastermidibase::set_engine (engine_callback f, void * arg)
+{
+    automutex locker(m_mutex);
+    return api_set_engine(f, arg);
+}
+
+/**
+ *  Indicates if the caller is the thread that started an output cycle.
+ *  The thread check is cheap (essentially pthread_self()) and is made only
+ *  while a batch is open.
+ */
+
+bool
+mastermidibase::batching () const
+{
+    return m_batching &&
+        m_batch_thread.load(std::memory_order_relaxed) ==
+            std::this_thread::get_id();
+}
+
 /**
  *  Set the clock for the given (legal) buss number.  The legality checks
  *  are a little loose, however.
@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2016-11-25
- * \updates       2025-08-18
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  This file provides a cross-platform implementation of MIDI support.
@@ -59,6 +59,14 @@ namespace seq66
 
 int midibase::m_clock_mod = 16 * 4;
 
+/**
+ *  The initial capacity of the output batch of each output port.  It is
+ *  large enough for a busy output cycle, so that the vector rarely, if ever,
+ *  needs to grow on the output thread.
+ */
+
+static const size_t c_batch_reserve = 256;
+
 /**
  *  Creates a normal MIDI port, which will correspond to an existing system
  *  MIDI port, such as one provided by Timidity or a running JACK application,
@@ -171,8 +179,12 @@ midibase::midibase
     m_lasttick          (0),
     m_io_type           (iotype),
     m_port_type         (porttype),
+    m_batch             (),
     m_mutex             ()
 {
+    if (iotype == io::output)
+        m_batch.reserve(c_batch_reserve);
+
     if (m_port_type != port::manual)
     {
         if (! busname.empty() && ! portname.empty())
@@ -451,6 +463,88 @@ midibase::play (const event * e24, midibyte channel)
     api_play(e24, channel);
 }
 
+/**
+ *  Adds an event to the output batch of this port, instead of playing it
+ *  immediately.  No locking is done, as only the thread playing the
+ *  patterns, between mastermidibase::begin_batch() and commit_batch(),
+ *  calls this function.
+ *
+ * \param e24
+ *      The event to be queued.  It is copied.
+ *
+ * \param channel
+ *      The channel of the playback.
+ */
+
+void
+midibase::queue (const event * e24, midibyte channel)
+{
+    m_batch.emplace_back(*e24, channel);
+}
+
+/**
+ *  Plays all of the events queued during the output cycle, taking the port
+ *  lock once and flushing once, rather than once per event.
+ *
+ * \param pc
+ *      Provides the time at which the pulse of each event is due, if valid.
+ *      The events of the output thread are stamped with their own pulse
+ *      (see sequence::play()), so that an API that schedules its output
+ *      can send each one at its exact time, whatever the wakeup jitter of
+ *      the output thread.
+ */
+
+void
+midibase::commit (const pulseclock & pc)
+{
+    if (! m_batch.empty())
+    {
+        automutex locker(m_mutex);
+        for (const auto & b : m_batch)
+        {
+            long long ns = pc.time_ns(b.first.timestamp());
+            api_play_at(&b.first, b.second, ns);
+        }
+
+        api_flush();
+        m_batch.clear();                    /* keeps the capacity           */
+    }
+}
+
+/**
+ *  The version of commit() used by the JACK process callback, which must not
+ *  wait.  If another thread holds the port lock, the events stay queued and
+ *  go out with those of the next cycle.
+ *
+ * \param pc
+ *      See commit().
+ *
+ * \return
+ *      Returns false if the port was busy, so that its events are deferred.
+ */
+
+bool
+midibase::try_commit (const pulseclock & pc)
+{
+    bool result = true;
+    if (! m_batch.empty())
+    {
+        result = m_mutex.try_lock();
+        if (result)
+        {
+            for (const auto & b : m_batch)
+            {
+                long long ns = pc.time_ns(b.first.timestamp());
+                api_play_at(&b.first, b.second, ns);
+            }
+            api_flush();
+            m_mutex.unlock();
+            m_batch.clear();
+        }
+    }
+    return result;
+}
+
 /**
  *  Takes a native SYSEX event, encodes it to an ALSA event, and then
  *  puts it in the queue.
@@ -615,10 +709,14 @@ midibase::stop ()
  *
  * \param tick
  *      Provides the starting tick.
+ *
+ * \param pc
+ *      If not null and valid, each clock is stamped with the time of its
+ *      own pulse.  See commit().
  */
 
 void
-midibase::clock (midipulse tick)
+midibase::clock (midipulse tick, const pulseclock * pc)
 {
     automutex locker(m_mutex);
     if (clock_enabled())
@@ -630,7 +728,12 @@ midibase::clock (midipulse tick)
             ++m_lasttick;
             done = m_lasttick >= tick;
             if ((m_lasttick % ct) == 0)                 /* tick time yet?   */
-                api_clock(tick);
+            {
+                if (not_nullptr(pc) && pc->valid())
+                    api_clock_at(m_lasttick, pc->time_ns(m_lasttick));
+                else
+                    api_clock(tick);
+            }
         }
         api_flush();                                    /* and send it out  */
     }
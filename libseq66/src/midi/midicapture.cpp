@@ -0,0 +1,284 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          midicapture.cpp
+ *
+ *  This module defines a recorder of the events sent to the output busses.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-15
+ * \updates       2026-10-15
+ * \license       GNU GPLv2 or above
+ *
+ *  See the midicapture.hpp module for the rationale.
+ */
+
+#include <fstream>                      /* std::ofstream                    */
+#include <vector>                       /* std::vector<>                    */
+
+#include "midi/calculations.hpp"        /* seq66::tempo_us_to_bytes(), etc. */
+#include "midi/event.hpp"               /* seq66::event                     */
+#include "midi/midicapture.hpp"         /* seq66::midicapture               */
+
+namespace seq66
+{
+
+/**
+ *  Appends a big-endian value of the given number of bytes.
+ */
+
+static void
+put_bytes (midibytes & data, unsigned long value, int count)
+{
+    for (int i = count - 1; i >= 0; --i)
+        data.push_back(midibyte((value >> (8 * i)) & 0xFF));
+}
+
+midicapture::midicapture (int ppqn, bool countonly) :
+    m_tracks        (),
+    m_tempo_track   (),
+    m_ppqn          (ppqn),
+    m_tick          (0),
+    m_bpm           (0.0),
+    m_event_count   (0),
+    m_count_only    (countonly)
+{
+    // no code
+}
+
+/**
+ *  Appends a MIDI variable-length value.  See midifile::write_varinum().
+ */
+
+void
+midicapture::put_varinum (midibytes & data, midilong value)
+{
+    midilong buffer = value & 0x7F;
+    while ((value >>= 7) > 0)
+    {
+        buffer <<= 8;
+        buffer |= ((value & 0x7F) | 0x80);
+    }
+    for (;;)
+    {
+        data.push_back(midibyte(buffer & 0xFF));
+        if (buffer & 0x80)
+            buffer >>= 8;
+        else
+            break;
+    }
+}
+
+/**
+ *  Appends the delta time from the last event of the track to the current
+ *  tick.  The ticks are expected to increase; one that goes back is
+ *  treated as a delta of 0.
+ */
+
+void
+midicapture::put_delta (track & t)
+{
+    midipulse delta = m_tick > t.t_last ? m_tick - t.t_last : 0 ;
+    put_varinum(t.t_data, midilong(delta));
+    if (m_tick > t.t_last)
+        t.t_last = m_tick;
+}
+
+/**
+ *  Records a channel message as it would be sent to the port.  Running
+ *  status is not used.  Other messages (the realtime messages, for
+ *  example) have no place in a MIDI file and are ignored.
+ *
+ * \param bus
+ *      The output buss.
+ *
+ * \param ev
+ *      The event.  Its status is combined with the channel, as the port
+ *      does.
+ *
+ * \param channel
+ *      The channel of the playback.
+ */
+
+void
+midicapture::add (bussbyte bus, const event & ev, midibyte channel)
+{
+    if (m_count_only)
+    {
+        ++m_event_count;
+    }
+    else if (ev.is_sysex())
+    {
+        add_sysex(bus, ev);
+    }
+    else if (event::is_channel_msg(ev.get_status()))
+    {
+        midibyte status = ev.get_status(channel);
+        midibyte d0, d1;
+        ev.get_data(d0, d1);
+
+        track & t = m_tracks[bus];
+        put_delta(t);
+        t.t_data.push_back(status);
+        t.t_data.push_back(d0);
+        if (! event::is_one_byte_msg(status))
+            t.t_data.push_back(d1);
+
+        ++m_event_count;
+    }
+}
+
+/**
+ *  Records a SysEx message.  The event holds the whole message, from F0 to
+ *  F7; the file holds F0, the length of the rest, and the rest.
+ */
+
+void
+midicapture::add_sysex (bussbyte bus, const event & ev)
+{
+    const event::sysex & data = ev.get_sysex();
+    if (m_count_only)
+    {
+        ++m_event_count;
+    }
+    else if (data.size() > 1 && data[0] == EVENT_MIDI_SYSEX)
+    {
+        track & t = m_tracks[bus];
+        put_delta(t);
+        t.t_data.push_back(EVENT_MIDI_SYSEX);
+        put_varinum(t.t_data, midilong(data.size() - 1));
+        t.t_data.insert(t.t_data.end(), data.begin() + 1, data.end());
+        ++m_event_count;
+    }
+}
+
+/**
+ *  Records a Set Tempo event in the tempo track, if the tempo differs from
+ *  the last one recorded.
+ *
+ * \param bpm
+ *      The tempo in effect at the current tick.
+ */
+
+void
+midicapture::tempo (midibpm bpm)
+{
+    if (bpm > 0.0 && bpm != m_bpm)
+    {
+        midibytes bytes;
+        if (tempo_us_to_bytes(bytes, tempo_us_from_bpm(bpm)))
+        {
+            track & t = m_tempo_track;
+            put_delta(t);
+            t.t_data.push_back(EVENT_MIDI_META);
+            t.t_data.push_back(EVENT_META_SET_TEMPO);
+            t.t_data.push_back(3);
+            t.t_data.insert(t.t_data.end(), bytes.begin(), bytes.end());
+            m_bpm = bpm;
+        }
+    }
+}
+
+/**
+ *  Records a Time Signature event in the tempo track.  The clocks per click
+ *  and 32nd notes per quarter note are 24 and 8, as elsewhere in Seq66.
+ */
+
+void
+midicapture::time_signature (int beatsperbar, int beatwidth)
+{
+    track & t = m_tempo_track;
+    put_delta(t);
+    t.t_data.push_back(EVENT_MIDI_META);
+    t.t_data.push_back(EVENT_META_TIME_SIGNATURE);
+    t.t_data.push_back(4);
+    t.t_data.push_back(midibyte(beatsperbar));
+    t.t_data.push_back(beat_log2(beatwidth));
+    t.t_data.push_back(0x18);
+    t.t_data.push_back(0x08);
+}
+
+/**
+ *  Writes the recording as an SMF 1 file.  The End-of-Track of each track
+ *  is put at the last tick given, so that all tracks have the length of the
+ *  render.
+ *
+ * \param filename
+ *      The full path to the file to be written.
+ *
+ * \param [out] errmsg
+ *      Set to a message if the file could not be written.
+ *
+ * \return
+ *      Returns true if the file was written.
+ */
+
+bool
+midicapture::write (const std::string & filename, std::string & errmsg) const
+{
+    std::ofstream file
+    (
+        filename, std::ios::out | std::ios::binary | std::ios::trunc
+    );
+    bool result = file.is_open();
+    if (result)
+    {
+        midibytes data;
+        put_bytes(data, 0x4D546864, 4);                 /* 'MThd'           */
+        put_bytes(data, 6, 4);
+        put_bytes(data, 1, 2);                          /* SMF 1            */
+        put_bytes(data, 1 + m_tracks.size(), 2);
+        put_bytes(data, unsigned(m_ppqn), 2);
+
+        std::vector<const track *> tracks;
+        tracks.push_back(&m_tempo_track);
+        for (const auto & bt : m_tracks)
+            tracks.push_back(&bt.second);
+
+        for (const track * tp : tracks)
+        {
+            midipulse delta = m_tick > tp->t_last ? m_tick - tp->t_last : 0 ;
+            midibytes eot;
+            put_varinum(eot, midilong(delta));
+            eot.push_back(EVENT_MIDI_META);
+            eot.push_back(EVENT_META_END_OF_TRACK);
+            eot.push_back(0);
+            put_bytes(data, 0x4D54726B, 4);             /* 'MTrk'           */
+            put_bytes(data, tp->t_data.size() + eot.size(), 4);
+            data.insert(data.end(), tp->t_data.begin(), tp->t_data.end());
+            data.insert(data.end(), eot.begin(), eot.end());
+        }
+        file.write((const char *)(data.data()), data.size());
+        result = bool(file);
+    }
+    if (! result)
+        errmsg = "Could not write '" + filename + "'";
+
+    return result;
+}
+
+}           // namespace seq66
+
+/*
+ * midicapture.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-07-24
- * \updates       2025-10-16
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  For a quick guide to the MIDI format, see, for example:
@@ -86,6 +86,7 @@
 
 #include <fstream>                      /* std::ifstream and std::ofstream  */
 #include <memory>                       /* std::unique_ptr<>                */
+#include <utility>                      /* std::move()                      */
 
 #include "cfg/settings.hpp"             /* seq66::rc() and choose_ppqn()    */
 #include "midi/midifile.hpp"            /* seq66::midifile                  */
@@ -299,6 +300,9 @@ midifile::midifile
     m_pos                       (0),
     m_name                      (name),
     m_data                      (),
+    m_preloaded                 (false),
+    m_mapping                   (),
+    m_bytes                     (nullptr),
     m_char_list                 (),
     m_global_bgsequence         (globalbgs),
     m_use_scaled_ppqn           (false),                /* scaled()         */
@@ -347,23 +351,17 @@ midifile::read_seek (size_t pos)
 }
 
 /**
- *  Reads 1 byte of data directly from the m_data vector, incrementing
- *  m_pos after doing so.
+ *  Called by read_byte() when there is no byte left to read.
  *
  * \return
- *      Returns the byte that was read.  Returns 0 if there was an error,
- *      though there's no way for the caller to determine if this is an error
- *      or a good value.
+ *      Returns 0, though there's no way for the caller to determine if this
+ *      is an error or a good value.
  */
 
 midibyte
-midifile::read_byte ()
+midifile::read_past_end ()
 {
-    if (m_pos < m_file_size)
-    {
-        return m_data[m_pos++];
-    }
-    else if (! m_disable_reported)
+    if (! m_disable_reported)
         (void) set_error_dump("End-of-file; aborting reading");
 
     return 0;
@@ -711,6 +709,10 @@ midifile::read_gap (size_t sz)
  *  perfect.  Also, no need to use the krufty string pointer for the
  *  file-name.
  *
+ *  If the data was handed over by preload(), the file is not touched at all.
+ *  Otherwise the file is mapped into memory, if possible, and read in
+ *  place; this saves allocating and filling a copy of a large file.
+ *
  * \param tag
  *      Basically an informative string to denote what kind of file is being
  *      opened, "MIDI" or "WRK".
@@ -723,11 +725,32 @@ midifile::read_gap (size_t sz)
 bool
 midifile::grab_input_stream (const std::string & tag)
 {
+    if (m_preloaded)
+    {
+        m_file_size = m_data.size();
+        m_bytes = m_data.data();
+        m_error_is_fatal = false;
+        if (m_file_size < c_minimum_midi_file_size)
+            return set_error("File too small.");
+
+        return true;
+    }
+
     m_file_size = file_size(m_name);
     if (m_name.empty() || m_file_size == 0)
     {
         return set_error("No MIDI file or data.");
     }
+    if (m_mapping.open(m_name))
+    {
+        m_file_size = m_mapping.size();
+        m_bytes = m_mapping.data();
+        m_error_is_fatal = false;
+        if (m_file_size < c_minimum_midi_file_size)
+            return set_error("File too small.");
+
+        return true;
+    }
 
     std::ifstream file(m_name, std::ios::in | std::ios::binary | std::ios::ate);
     bool result = file.is_open();
@@ -745,6 +768,7 @@ midifile::grab_input_stream (const std::string & tag)
             {
                 m_data.resize(m_file_size);     /* allocate the data        */
                 file.read((char *)(&m_data[0]), m_file_size);
+                m_bytes = m_data.data();
             }
             catch (const std::bad_alloc & ex)
             {
@@ -765,6 +789,22 @@ midifile::grab_input_stream (const std::string & tag)
     return result;
 }
 
+/**
+ *  Hands over the contents of the file, already read by the caller, so that
+ *  parse() works from memory.  The playlist reads the next song this way,
+ *  on a thread of its own, so that the song change does no disk I/O.
+ *
+ * \param data
+ *      The whole file.  It is moved, not copied.
+ */
+
+void
+midifile::preload (midibytes && data)
+{
+    m_data = std::move(data);
+    m_preloaded = true;
+}
+
 /**
  *  This function opens a binary MIDI file and parses it into sequences
  *  and other application objects.
@@ -1201,7 +1241,7 @@ midifile::parse_smf_1 (performer & p, int screenset, bool convert_smf0)
                 midilong len;                       /* important counter!   */
                 midibyte d0, d1;                    /* the two data bytes   */
                 midipulse delta = read_varinum();   /* time delta from prev */
-                status = m_data[m_pos];             /* current event byte   */
+                status = peek();                    /* current event byte   */
                 if (event::is_status(status))       /* is there a 0x80 bit? */
                 {
                     /*
@@ -3751,6 +3791,14 @@ midifile::set_error_dump (const std::string & msg, unsigned long value)
  * \param [out] errmsg
  *      If the function fails, this string is filled with the error message.
  *
+ * \param addtorecent
+ *      If true, the file is added to the recent-files list.
+ *
+ * \param preloaded
+ *      If not null and not empty, the contents of the file, already read.
+ *      They are moved into the midifile, so the file is not read again.
+ *      See performer::take_preload().
+ *
  * \return
  *      Returns true if reading the MIDI/WRK file succeeded. As a side-effect,
  *      the usrsettings::file_ppqn() is set to return the final PPQN to be
@@ -3764,7 +3812,8 @@ read_midi_file
     const std::string & fn,
     int ppqn,                                   /* might get altered        */
     std::string & errmsg,
-    bool addtorecent
+    bool addtorecent,
+    midibytes * preloaded
 )
 {
     bool result = file_readable(fn);            /* how to disable Save?     */
@@ -3784,7 +3833,12 @@ read_midi_file
         p.clear_all();                          /* see banner notes         */
         result = bool(f);
         if (result)
+        {
+            if (not_nullptr(preloaded) && ! preloaded->empty())
+                f->preload(std::move(*preloaded));
+
             result = f->parse(p, 0);
+        }
 
         if (result)
         {
@@ -0,0 +1,128 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          playevents.cpp
+ *
+ *  This module defines the compact playback copy of an eventlist.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-15
+ * \updates       2026-10-15
+ * \license       GNU GPLv2 or above
+ *
+ *  See the playevents.hpp module for the rationale.
+ */
+
+#include <algorithm>                    /* std::lower_bound()               */
+
+#include "cfg/scales.hpp"               /* scales and keys for eventlist    */
+#include "midi/eventlist.hpp"           /* seq66::eventlist                 */
+#include "midi/playevents.hpp"          /* seq66::playevents                */
+
+namespace seq66
+{
+
+/**
+ *  Default constructor.  The object starts out stale, so that the first
+ *  call to sequence::play() builds it.
+ */
+
+playevents::playevents () :
+    m_records       (),
+    m_extras        (),
+    m_source_count  (0),
+    m_valid         (false)
+{
+    // no code
+}
+
+/**
+ *  Rebuilds the records from the (sorted) eventlist.  The storage is kept
+ *  from one rebuild to the next, so that after the first build of a pattern
+ *  of a given size, a rebuild does not allocate.
+ *
+ * \threadunsafe
+ *      The caller must hold the sequence mutex.
+ *
+ * \param evl
+ *      The event list to copy.
+ */
+
+void
+playevents::rebuild (const eventlist & evl)
+{
+    m_records.clear();
+    m_extras.clear();
+    m_records.reserve(evl.count());
+    for (auto ei = evl.cbegin(); ei != evl.cend(); ++ei)
+    {
+        const event & ev = eventlist::cdref(ei);
+        record r;
+        r.m_timestamp = ev.timestamp();
+        r.m_status = ev.get_status();
+        r.m_channel = ev.channel();
+        r.m_data[0] = ev.d0();
+        r.m_data[1] = ev.d1();
+        if (ev.is_ex_data())
+        {
+            r.m_extra = int(m_extras.size());
+            m_extras.push_back(ev);
+        }
+        else
+            r.m_extra = (-1);
+
+        m_records.push_back(r);
+    }
+    m_source_count = evl.count();
+    m_valid = true;
+}
+
+/**
+ *  Finds the first record with a time-stamp at or after the given one.
+ *
+ * \param ts
+ *      The time-stamp to look for.
+ *
+ * \return
+ *      Returns the index of the record, or count() if there is none.
+ */
+
+int
+playevents::lower_bound (midipulse ts) const
+{
+    auto ri = std::lower_bound
+    (
+        m_records.cbegin(), m_records.cend(), ts,
+        [] (const record & r, midipulse t)
+        {
+            return r.timestamp() < t;
+        }
+    );
+    return int(ri - m_records.cbegin());
+}
+
+}           // namespace seq66
+
+/*
+ * playevents.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,215 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          sysexsender.cpp
+ *
+ *  This module defines a paced SysEx transmitter with its own thread.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-15
+ * \updates       2026-10-15
+ * \license       GNU GPLv2 or above
+ *
+ *  See the sysexsender.hpp module for the rationale.
+ */
+
+#include <chrono>                       /* std::chrono::steady_clock        */
+
+#include "midi/sysexsender.hpp"         /* seq66::sysexsender               */
+
+namespace seq66
+{
+
+/**
+ *  Principal constructor.  Starts the transmission thread, which sleeps
+ *  until there is a dump to send.
+ *
+ * \param sendchunk
+ *      Sends one chunk to the port.  It is called on the sender's thread,
+ *      so it must do its own locking.
+ *
+ * \param chunksize
+ *      The largest number of bytes sent at once.  Values below 1 are
+ *      treated as 1.
+ *
+ * \param byterate
+ *      The average bytes per second to send.  The sender waits after each
+ *      chunk for as long as the chunk takes at this rate.  If 0, chunks are
+ *      sent back to back.
+ *
+ * \param done
+ *      If not null, called when a dump is finished.
+ */
+
+sysexsender::sysexsender
+(
+    chunker sendchunk,
+    int chunksize,
+    int byterate,
+    notifier done
+) :
+    m_chunker       (sendchunk),
+    m_notifier      (done),
+    m_chunk_size    (chunksize > 0 ? chunksize : 1),
+    m_byte_rate     (byterate > 0 ? byterate : 0),
+    m_dumps         (),
+    m_mutex         (),
+    m_wakeup        (),
+    m_stop          (false),
+    m_next_id       (0),
+    m_thread        (&sysexsender::run, this)
+{
+    // no code
+}
+
+/**
+ *  Stops the thread.  The chunk being sent, if any, is finished, but the
+ *  rest of the dumps are abandoned and reported as failed.
+ */
+
+sysexsender::~sysexsender ()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wakeup.notify_one();
+    if (m_thread.joinable())
+        m_thread.join();
+}
+
+/**
+ *  Queues a dump and returns at once.  The dump is copied, which is the
+ *  only cost to the caller.
+ *
+ * \param data
+ *      The whole SysEx message, from 0xF0 to 0xF7.
+ *
+ * \return
+ *      Returns the ID of the dump, as passed later to the notifier.  IDs
+ *      start at 1.
+ */
+
+unsigned
+sysexsender::send (const event::sysex & data)
+{
+    unsigned result;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        result = ++m_next_id;
+        m_dumps.emplace_back(result, data);
+    }
+    m_wakeup.notify_one();
+    return result;
+}
+
+/**
+ *  Gets the number of dumps not yet finished, including the one being
+ *  sent.  The port uses this to send even a small SysEx message through
+ *  the queue while it is busy, so that messages go out in order.
+ */
+
+int
+sysexsender::pending () const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return int(m_dumps.size());
+}
+
+/**
+ *  The transmission thread.  The mutex is released while a chunk is sent
+ *  or the notifier is called, and is otherwise held except while waiting.
+ *  The time at which the next chunk may go is carried from one dump to the
+ *  next, so that back-to-back dumps are paced as well.  The front dump is
+ *  not moved by send(), since std::deque::emplace_back() does not
+ *  invalidate references to the elements.
+ */
+
+void
+sysexsender::run ()
+{
+    using clock = std::chrono::steady_clock;
+    clock::time_point next = clock::now();
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;)
+    {
+        m_wakeup.wait(lock, [this] { return m_stop || ! m_dumps.empty(); });
+        if (m_stop)
+            break;
+
+        const dump & d = m_dumps.front();
+        unsigned id = d.d_id;
+        const midibyte * data = d.d_data.data();
+        int size = int(d.d_data.size());
+        bool ok = true;
+        int offset = 0;
+        while (ok && offset < size)
+        {
+            if (m_wakeup.wait_until(lock, next, [this] { return m_stop; }))
+            {
+                ok = false;
+                break;
+            }
+
+            int count = size - offset;
+            if (count > m_chunk_size)
+                count = m_chunk_size;
+
+            lock.unlock();
+            ok = m_chunker(data + offset, count);
+            lock.lock();
+            offset += count;
+            if (m_byte_rate > 0)
+            {
+                clock::time_point now = clock::now();
+                if (next < now)
+                    next = now;
+
+                next += std::chrono::microseconds
+                (
+                    (long long)(count) * 1000000LL / m_byte_rate
+                );
+            }
+        }
+        m_dumps.pop_front();
+        if (m_notifier)
+        {
+            lock.unlock();
+            m_notifier(id, ok);
+            lock.lock();
+        }
+    }
+    while (! m_dumps.empty())
+    {
+        unsigned id = m_dumps.front().d_id;
+        m_dumps.pop_front();
+        if (m_notifier)
+            m_notifier(id, false);
+    }
+}
+
+}           // namespace seq66
+
+/*
+ * sysexsender.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -21,7 +21,7 @@
  * \library       seq66 application (from PSXC library)
  * \author        Chris Ahlstrom
  * \date          2005-07-03 to 2007-08-21 (pre-Sequencer24/64)
- * \updates       2026-05-19
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  Daemonization module of the POSIX C Wrapper (PSXC) library
@@ -535,6 +535,7 @@ reroute_stdio (const std::string & logfile)
 static std::atomic<bool> sg_needs_close {};
 static std::atomic<bool> sg_needs_save {};
 static std::atomic<bool> sg_restart {};
+static std::atomic<bool> sg_needs_report {};
 
 bool
 session_restart ()
@@ -577,6 +578,19 @@ session_save ()
     return result;
 }
 
+/**
+ *  Returns the boolean to indicate a request to write the timing report
+ *  (see the perfcounters module).
+ */
+
+bool
+session_report ()
+{
+    bool result = sg_needs_report;
+    sg_needs_report = false;
+    return result;
+}
+
 void signal_for_save ()
 {
     sg_needs_save = true;
@@ -638,11 +652,17 @@ session_handler (int sig)
 
         sg_needs_save = true;
         break;
+
+    case SIGUSR2:                       /* 12: "user-defined signal 2       */
+
+        sg_needs_report = true;
+        break;
     }
 }
 
 /**
- *  Sets up the application to intercept SIGINT, SIGTERM, and SIGUSR1.
+ *  Sets up the application to intercept SIGINT, SIGTERM, SIGUSR1, and
+ *  SIGUSR2.
  *
  * \param earlyexit
  *      It turns out that the test for the need to remap ports occurs
@@ -666,6 +686,7 @@ session_setup (bool earlyexit)
         sigaction(SIGINT, &action, NULL);               /* SIGINT is 2      */
         sigaction(SIGTERM, &action, NULL);              /* SIGTERM is 15    */
         sigaction(SIGUSR1, &action, NULL);              /* SIGUSR1 is 10    */
+        sigaction(SIGUSR2, &action, NULL);              /* SIGUSR2 is 12    */
     }
     return result;
 }
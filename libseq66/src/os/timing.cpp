@@ -21,7 +21,7 @@
  * \library       seq66 application (from PSXC library)
  * \author        Chris Ahlstrom
  * \date          2005-07-03 to 2007-08-21 (pre-Sequencer24/64)
- * \updates       2023-12-22
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  Provides support for cross-platform time-related functions.
@@ -337,6 +337,136 @@ millitime ()
 
 #endif
 
+/*
+ * --------------------------------------------------------------------------
+ *  nanotime() and sleep_until()
+ * --------------------------------------------------------------------------
+ */
+
+#if defined SEQ66_PLATFORM_UNIX         // _LINUX
+
+/**
+ *  Gets the current monotonic time in nanoseconds.  Unlike microtime(), the
+ *  result is exact, so that deadlines computed from it do not accumulate
+ *  rounding errors.
+ */
+
+long long
+nanotime ()
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (t.tv_sec * 1000000000LL) + t.tv_nsec;
+}
+
+#if defined SEQ66_PLATFORM_MACOSX
+
+/**
+ *  macOS has no clock_nanosleep(), so, as for Windows, we sleep for the
+ *  time remaining until the deadline.  The remainder is measured again
+ *  after a wakeup by a signal, so that the deadline is not overshot.
+ *
+ * \param deadline_ns
+ *      The monotonic time at which to wake up.  If already past, the
+ *      function returns at once.
+ *
+ * \return
+ *      Returns true if the sleep succeeded.
+ */
+
+bool
+sleep_until (long long deadline_ns)
+{
+    bool result = true;
+    for (;;)
+    {
+        long long remaining = deadline_ns - nanotime();
+        if (remaining <= 0)
+            break;
+
+        struct timespec t;
+        t.tv_sec = time_t(remaining / 1000000000LL);
+        t.tv_nsec = long(remaining % 1000000000LL);
+        if (nanosleep(&t, NULL) != 0 && errno != EINTR)
+        {
+            result = false;
+            break;
+        }
+    }
+    return result;
+}
+
+#else
+
+/**
+ *  Sleeps until the given absolute time, as returned by nanotime().  Uses
+ *  clock_nanosleep(2) with TIMER_ABSTIME, so that the time spent by the
+ *  caller before sleeping is not added to the sleep, and a wakeup by a
+ *  signal simply sleeps again to the same deadline.
+ *
+ * \param deadline_ns
+ *      The monotonic time at which to wake up.  If already past, the
+ *      function returns at once.
+ *
+ * \return
+ *      Returns true if the sleep succeeded.
+ */
+
+bool
+sleep_until (long long deadline_ns)
+{
+    struct timespec t;
+    t.tv_sec = time_t(deadline_ns / 1000000000LL);
+    t.tv_nsec = long(deadline_ns % 1000000000LL);
+
+    int rc;
+    do
+    {
+        rc = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &t, NULL);
+    } while (rc == EINTR);
+    return rc == 0;
+}
+
+#endif  // SEQ66_PLATFORM_MACOSX
+
+#elif defined SEQ66_PLATFORM_WINDOWS
+
+/**
+ *  Gets the current time in nanoseconds, using the performance counter.
+ */
+
+long long
+nanotime ()
+{
+    static LARGE_INTEGER s_frequency;
+    static bool s_have_frequency = false;
+    if (! s_have_frequency)
+    {
+        (void) QueryPerformanceFrequency(&s_frequency);
+        s_have_frequency = true;
+    }
+
+    LARGE_INTEGER count;
+    (void) QueryPerformanceCounter(&count);
+    long long secs = count.QuadPart / s_frequency.QuadPart;
+    long long rem = count.QuadPart % s_frequency.QuadPart;
+    return secs * 1000000000LL + rem * 1000000000LL / s_frequency.QuadPart;
+}
+
+/**
+ *  Windows has no absolute sleep, so we sleep for the time remaining until
+ *  the deadline.
+ */
+
+bool
+sleep_until (long long deadline_ns)
+{
+    long long us = (deadline_ns - nanotime()) / 1000;
+    return us > 0 ? microsleep(int(us)) : true ;
+}
+
+#endif
+
 /*
  * --------------------------------------------------------------------------
  *  set_thread_priority() and set_timer_services()
@@ -0,0 +1,261 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          clockfollower.cpp
+ *
+ *  This module defines a follower for incoming MIDI clock.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-15
+ * \updates       2026-10-15
+ * \license       GNU GPLv2 or above
+ *
+ *  See the clockfollower.hpp module for the rationale.
+ */
+
+#include <cmath>                        /* std::fabs(), std::floor(), etc.  */
+
+#include "midi/calculations.hpp"        /* seq66::midi_clock_beats_per_qn() */
+#include "play/clockfollower.hpp"       /* seq66::clockfollower             */
+
+namespace seq66
+{
+
+/**
+ *  The bandwidth of the loop, in Hz.  A clock comes every 20 ms at 125 BPM,
+ *  so the loop averages the jitter over about 50 clocks, while following a
+ *  tempo change within a second or two.
+ */
+
+static const double c_clock_bandwidth = 1.0;
+
+/**
+ *  The range of clock periods accepted, in microseconds.  This is 2.5 to
+ *  1250 BPM; anything outside is a glitch.
+ */
+
+static const double c_period_min_us = 2000.0;
+static const double c_period_max_us = 1000000.0;
+
+/**
+ *  A clock that is off from its predicted time by more than this many
+ *  periods means that clocks were lost, or that the master jumped.  The
+ *  phase is then re-anchored at the clock, rather than slewed toward it.
+ */
+
+static const double c_clock_gap_periods = 4.0;
+
+/**
+ *  M_PI is not standard C++, and needs _USE_MATH_DEFINES on Windows.
+ */
+
+static const double c_two_pi = 6.283185307179586;
+
+clockfollower::clockfollower () :
+    m_mutex             (),
+    m_running           (false),
+    m_locked            (false),
+    m_ticks_per_clock   (1),
+    m_clocks            (0),
+    m_handed_out        (0),
+    m_t0                (0.0),
+    m_t1                (0.0),
+    m_period            (0.0),
+    m_bpm               (0.0)
+{
+    // no code
+}
+
+/**
+ *  Called for MIDI Start and MIDI Continue.  The position starts over at 0,
+ *  and the phase is set by the first clock to come.  The period estimated
+ *  before is kept, on the assumption that the tempo has not changed much.
+ *
+ * \param ticksperclock
+ *      The number of ticks in one clock at the PPQN in force.
+ */
+
+void
+clockfollower::start (int ticksperclock)
+{
+    automutex locker(m_mutex);
+    m_running = true;
+    m_locked = false;
+    m_ticks_per_clock = ticksperclock > 0 ? ticksperclock : 1 ;
+    m_clocks = 0;
+    m_handed_out = 0;
+    m_t0 = m_t1 = 0.0;
+    m_bpm.store(0.0, std::memory_order_relaxed);
+}
+
+void
+clockfollower::stop ()
+{
+    automutex locker(m_mutex);
+    m_running = false;
+    m_bpm.store(0.0, std::memory_order_relaxed);
+}
+
+/**
+ *  Feeds the arrival time of a clock to the loop.  The first clock after a
+ *  start anchors the phase.  The second one, if the period is not yet
+ *  known, gives the first period.  Each later clock is compared to its
+ *  predicted time, and the error nudges both the phase and the period.
+ *
+ * \param arrival_us
+ *      The time at which the clock arrived, on the microtime() clock.  The
+ *      closer this is to the arrival at the port, the less jitter the loop
+ *      has to filter out.
+ */
+
+void
+clockfollower::clock (long arrival_us)
+{
+    automutex locker(m_mutex);
+    if (m_running)
+    {
+        double t = double(arrival_us);
+        ++m_clocks;
+        if (m_locked)
+        {
+            double e = t - m_t1;
+            if (std::fabs(e) > c_clock_gap_periods * m_period)
+            {
+                m_t0 = t;
+                m_t1 = t + m_period;
+            }
+            else
+            {
+                double w = c_two_pi * c_clock_bandwidth * m_period * 1.0e-6;
+                m_t0 = m_t1;
+                m_t1 += std::sqrt(2.0) * w * e + m_period;
+                m_period += w * w * e;
+                if (m_period < c_period_min_us)
+                    m_period = c_period_min_us;
+                else if (m_period > c_period_max_us)
+                    m_period = c_period_max_us;
+            }
+        }
+        else if (m_clocks == 1)
+        {
+            m_t0 = t;
+            if (m_period > 0.0)
+            {
+                m_t1 = t + m_period;
+                m_locked = true;
+            }
+        }
+        else
+        {
+            double p = t - m_t0;
+            m_t0 = t;
+            if (p >= c_period_min_us && p <= c_period_max_us)
+            {
+                m_period = p;
+                m_t1 = t + p;
+                m_locked = true;
+            }
+        }
+        if (m_locked)
+        {
+            double clocksperminute = 60000000.0 / m_period;
+            m_bpm.store
+            (
+                clocksperminute / midi_clock_beats_per_qn(),
+                std::memory_order_relaxed
+            );
+        }
+    }
+}
+
+/**
+ *  Gets the position, in ticks since the start, at the given time.  Until
+ *  the loop is locked, this is the tick of the last clock, as before.
+ *  After that, the ticks up to the next clock are spread evenly over the
+ *  time until that clock is predicted to come, but stop one short of it.
+ *  A clock that comes early is filtered to a time that is still ahead, so
+ *  until then the position is that of the previous interval; playback does
+ *  not jump forward at each early clock.  Must be called with the mutex
+ *  held.
+ */
+
+midipulse
+clockfollower::position (long now_us) const
+{
+    midipulse result = midipulse(m_clocks) * m_ticks_per_clock;
+    if (m_locked && m_clocks > 0)
+    {
+        double span = m_t1 - m_t0;
+        if (span > 0.0)
+        {
+            double elapsed = double(now_us) - m_t0;
+            midipulse extra = midipulse
+            (
+                std::floor(elapsed / span * m_ticks_per_clock)
+            );
+            if (extra >= m_ticks_per_clock)
+                extra = m_ticks_per_clock - 1;
+            else if (extra < -m_ticks_per_clock)
+                extra = -m_ticks_per_clock;
+
+            result += extra;
+        }
+    }
+    return result;
+}
+
+/**
+ *  Called by the output thread in each cycle to get the ticks to advance.
+ *  The position can fall back a little when a clock comes later than
+ *  predicted, so the ticks handed out never decrease; playback simply
+ *  holds until the position passes them again.
+ *
+ * \param now_us
+ *      The current time, on the microtime() clock.
+ *
+ * \return
+ *      Returns the whole ticks that have passed since the previous call.
+ */
+
+midipulse
+clockfollower::advance (long now_us)
+{
+    automutex locker(m_mutex);
+    midipulse result = 0;
+    if (m_running)
+    {
+        midipulse pos = position(now_us);
+        if (pos > m_handed_out)
+        {
+            result = pos - m_handed_out;
+            m_handed_out = pos;
+        }
+    }
+    return result;
+}
+
+}           // namespace seq66
+
+/*
+ * clockfollower.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
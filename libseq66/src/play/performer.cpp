@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom and others
  * \date          2018-11-12
- * \updates       2026-05-09
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  Also read the comments in the Seq64 version of this module, perform.
@@ -104,21 +104,23 @@
  *    -   It is set to false in pause_playing().
  *    -   It is set to the midiclock parameter of inner_stop().
  *    -   If m_usemidiclock is true:
- *        -   It affects m_midiclocktick in output.
+ *        -   The output thread gets its delta-tick from m_clock_follower.
  *        -   The position in output cannot be repositioned.
  *        -   The tick location cannot be changed.
  *
  *    On input:
  *
  *    -   If MIDI Start is received, m_midiclockrunning and m_usemidiclock
- *        become true, and m_midiclocktick and m_midiclockpos become 0.
+ *        become true, m_midiclockpos becomes 0, and m_clock_follower is
+ *        started.
  *    -   If MIDI Continue is received, m_midiclockrunning is set to true and
  *        we start according to song-mode.
  *    -   If MIDI Stop is received, m_midiclockrunning is set to false,
  *        m_midiclockpos is set to the current tick (!), all_notes_off(), and
  *        inner_stop(true) [sets m_usemidiclock = true].
  *    -   If MIDI Clock is received, and m_midiclockrunning is true, then
- *        m_midiclocktick += m_midiclockincrement.
+ *        its arrival time is fed to m_clock_follower, which smooths the
+ *        position and estimates the tempo.  See the clockfollower module.
  *    -   If MIDI Song Position is received, then m_midiclockpos is set as per
  *        in data in this event.
  *    -   MIDI Active Sense and MIDI Reset are currently filtered by the JACK
@@ -241,6 +243,7 @@
 
 #include <algorithm>                    /* std::find() for std::vector      */
 #include <cmath>                        /* std::round()                     */
+#include <fstream>                      /* std::ifstream                    */
 #include <iostream>                     /* std::cout                        */
 #include <sstream>                      /* std::ostringstream               */
 
@@ -250,12 +253,14 @@
 #include "cfg/playlistfile.hpp"         /* seq66::playlistfile              */
 #include "cfg/settings.hpp"             /* seq66::rcsettings rc(), etc.     */
 #include "ctrl/keystroke.hpp"           /* seq66::keystroke class           */
+#include "midi/midicapture.hpp"         /* seq66::midicapture for bounce()  */
 #include "midi/midifile.hpp"            /* seq66::read_midi_file()          */
 #include "play/notemapper.hpp"          /* seq66::notemapper                */
 #include "play/performer.hpp"           /* seq66::performer, this class     */
 #include "os/daemonize.hpp"             /* seq66::signal_for_exit()         */
 #include "os/timing.hpp"                /* seq66::microsleep(), microtime() */
 #include "util/filefunctions.hpp"       /* seq66::filename_base(), etc.     */
+#include "util/perfcounters.hpp"        /* seq66::perf_counters()           */
 
 namespace seq66
 {
@@ -267,6 +272,24 @@ namespace seq66
 
 static const int c_thread_trigger_width_us = 4 * 1000;
 
+/**
+ *  With the deadline scheduler, the tick position at a deadline computed for
+ *  a MIDI clock can come out a hair short of the whole tick because of
+ *  floating-point rounding.  This nudge keeps the clock from slipping to the
+ *  next wakeup.
+ */
+
+static const double c_deadline_tick_epsilon = 1.0e-6;
+
+/**
+ *  The oldest arrival stamp of a MIDI Clock that is believed, in
+ *  microseconds.  The JACK engine stamps a clock with its arrival time on
+ *  the microtime() clock.  The ALSA engine stamps it with its queue tick,
+ *  which is no use here, and is older than this limit or in the future.
+ */
+
+static const long c_clock_stamp_limit_us = 100 * 1000;
+
 /**
  *  When operating a playlist, especially from a headless seq66cli run, and
  *  with JACK transport active, the change from a playing tune to the next
@@ -331,8 +354,34 @@ performer::performer (int ppq, int rows, int columns) :
     m_in_thread             (),
     m_out_thread_launched   (false),
     m_in_thread_launched    (false),
+    m_song_thread           (),
+    m_song_thread_launched  (false),
+    m_song_advance          (false),
+    m_song_preload          (false),
+    m_preload_mutex         (),
+    m_preload_request       (),
+    m_preload_name          (),
+    m_preload_data          (),
     m_io_active             (false),            /* !done(), set in launch() */
     m_is_running            (false),
+    m_pull_mode             (false),            /* set in launch()          */
+    m_pull_rebase           (false),
+    m_pull_start_tick       (0),
+    m_pull_tick             (0),
+    m_pull_clock_tick       (0),
+    m_pull_bpm              (0.0),
+    m_pull_in_cycle         (false),
+    m_pull_holds            (0),
+    m_pull_started          (false),
+    m_pull_transport        (false),
+    m_pull_base_frame       (0),
+    m_pull_next_frame       (0),
+    m_pull_base_tick        (0.0),
+    m_pull_ticks_per_frame  (0.0),
+    m_pull_clock            (0.0),
+    m_pull_last_tick        (0),
+    m_capture               (nullptr),
+    m_capture_thread        (),
     m_is_pattern_playing    (false),
     m_needs_update          (true),
     m_is_busy               (false),            /* try this flag for now    */
@@ -370,7 +419,7 @@ performer::performer (int ppq, int rows, int columns) :
     m_jack_tick             (0),
     m_usemidiclock          (false),            /* MIDI Clock support       */
     m_midiclockrunning      (false),
-    m_midiclocktick         (0),
+    m_clock_follower        (),
     m_midiclockincrement    (clock_ticks_from_ppqn(m_ppqn)),
     m_midiclockpos          (0),
     m_dont_reset_ticks      (false),            /* support for pausing      */
@@ -379,6 +428,7 @@ performer::performer (int ppq, int rows, int columns) :
     m_selected_seqs         (),
 #endif
     m_condition_var         (*this),            /* private access via cv()  */
+    m_song_var              (*this),
 #if SEQ66_JACK_SUPPORT
     m_jack_asst
     (
@@ -1097,7 +1147,7 @@ bussbyte
 performer::true_input_bus (bussbyte nominalbuss) const
 {
     bussbyte result = nominalbuss;
-    if (! is_null_buss(result))
+    if (! is_null_buss(result) && m_master_bus)     /* no ports to map      */
     {
         result = seq66::true_input_bus(m_inputs, nominalbuss);
         if (is_null_buss(result))
@@ -1435,7 +1485,7 @@ bussbyte
 performer::true_output_bus (bussbyte nominalbuss) const
 {
     bussbyte result = nominalbuss;
-    if (! is_null_buss(result))
+    if (! is_null_buss(result) && m_master_bus)     /* no ports to map      */
     {
         result = seq66::true_output_bus(m_clocks, nominalbuss);
         if (is_null_buss(result))
@@ -2502,6 +2552,7 @@ performer::set_ppqn (int ppq)
         {
             m_ppqn = ppq;
             m_one_measure = m_fast_ticks = 0;
+            m_midiclockincrement = clock_ticks_from_ppqn(ppq);
             (void) jack_set_ppqn(ppq);
             m_master_bus->set_ppqn(ppq);
             notify_resolution_change                    /* ca 2023-10-30    */
@@ -2523,6 +2574,25 @@ performer::set_ppqn (int ppq)
     return result;
 }
 
+/**
+ *  Gets the tempo of the external MIDI clock being followed, in the units
+ *  of the beats-per-minute setting, which depend on the beat width.
+ *
+ * \return
+ *      Returns 0 if no MIDI clock is being followed, or if the clock
+ *      follower has not locked onto it yet.
+ */
+
+midibpm
+performer::midi_clock_bpm () const
+{
+    midibpm result = 0.0;
+    if (m_usemidiclock)
+        result = m_clock_follower.bpm() * get_beat_width() / 4.0;
+
+    return result;
+}
+
 int
 performer::get_ppqn_from_master_bus () const
 {
@@ -2857,6 +2927,26 @@ performer::set_beats_per_minute (midibpm bp, bool user_change)
     return result;
 }
 
+/**
+ *  Sets the tempo from a tempo event being played.  In pull mode, the
+ *  patterns are played by the JACK process callback, which must not lock
+ *  the master buss or call the GUI callbacks, so the tempo is left for the
+ *  output thread, which applies it in pull_output() within a millisecond
+ *  or so.  Otherwise the tempo is set right away.
+ *
+ * \param bp
+ *      Provides the beats/minute value to be set.
+ */
+
+void
+performer::post_beats_per_minute (midibpm bp)
+{
+    if (pull_mode() && ! bouncing())
+        m_pull_bpm = bp;
+    else
+        (void) set_beats_per_minute(bp);
+}
+
 /**
  *  This is a faster version, meant for jack_assistant to call.  This logic
  *  matches the original seq24, but is it really correct?  Well, we fixed it
@@ -3269,6 +3359,7 @@ performer::clear_song ()
     bool result = ! set_mapper().any_in_edit() && ! m_is_busy;
     if (result)
     {
+        pull_hold();                    /* keep JACK callback out       */
         m_is_busy = true;               /* { */
         reset_sequences();
         rc().clear_midi_filename();
@@ -3278,6 +3369,7 @@ performer::clear_song ()
         m_redo_vect.clear();
         set_mapper().reset();               /* clears and recreates empty set   */
         m_is_busy = false;              /* } */
+        pull_release();
         unmodify();                     /* new, we start afresh             */
         set_tick(0);                    /* force a "rewind"                 */
         pad().set_current_tick(0);      /* another necessary rewind         */
@@ -3624,6 +3716,18 @@ performer::launch (int ppqn)
                 m_midi_control_out.true_buss(truebus);
             }
             m_io_active = true;                     /* set done()           */
+            if (rc().jack_pull_mode())
+            {
+                m_pull_mode = m_master_bus->set_engine
+                (
+                    &performer::pull_callback, this
+                );
+                if (m_pull_mode)
+                    session_message("JACK pull mode active");
+                else
+                    warn_message("JACK pull mode unsupported by MIDI engine");
+            }
+            launch_song_thread();           /* before the output thread */
             launch_input_thread();
             launch_output_thread();
             midi_control_out().send_macro(midimacros::startup);
@@ -4093,6 +4197,22 @@ performer::launch_input_thread ()
     }
 }
 
+/**
+ *  Creates the song thread, which runs song_func().  It is not given the
+ *  priority of the MIDI threads, as it reads files and parses songs.
+ */
+
+void
+performer::launch_song_thread ()
+{
+    if (! m_song_thread_launched)
+    {
+        m_song_thread = std::thread(&performer::song_func, this);
+        m_song_thread_launched = true;
+        debug_message("Song thread launched");
+    }
+}
+
 /**
  *  The rough opposite of launch(); it doesn't stop the threads.  A minor
  *  simplification for the main() routine, hides the JACK support macro.
@@ -4124,6 +4244,11 @@ performer::finish ()
         midi_control_out().send_macro(midimacros::shutdown);
         m_io_active = false;                /* set done() for predicate     */
         m_is_running = false;               /* set is_running() off         */
+        if (m_pull_mode)
+        {
+            (void) m_master_bus->set_engine(nullptr, nullptr);
+            m_pull_mode = false;
+        }
         cv().signal();                      /* signal the end of play       */
         if (m_out_thread_launched && m_out_thread.joinable())
         {
@@ -4135,7 +4260,15 @@ performer::finish ()
             m_in_thread.join();
             m_in_thread_launched = false;
         }
+        m_song_var.signal();                /* done() ends the song thread  */
+        if (m_song_thread_launched && m_song_thread.joinable())
+        {
+            m_song_thread.join();
+            m_song_thread_launched = false;
+        }
         result = deinit_jack_transport();
+        if (rc().verbose())
+            std::cout << perf_counters().report();
 
         /*
          * Will be done externally (by smanager::close_session) in
@@ -4776,6 +4909,20 @@ performer::jack_reposition (midipulse tick, midipulse stoptick)
  *
  *          if (next_clock_delta_us < (c_thread_trigger_width_us * 2.0))
  *
+ * Deadline scheduler:
+ *
+ *      The relative sleep above drifts: the time spent between reading the
+ *      clock and going to sleep, and the sleep overshoot, are lost each
+ *      cycle, and the tick fraction is carried in microseconds.  If the
+ *      "deadline-scheduler" option is set, the tick position is instead
+ *      computed from the absolute time of each wakeup, anchored at the start
+ *      of playback and re-anchored at each tempo or PPQN change.  The
+ *      thread sleeps with sleep_until() to the next deadline, which is one
+ *      trigger width later, or the time of the next MIDI clock if that comes
+ *      sooner.  Thus the clock goes out when due, and rounding never
+ *      accumulates.  If a cycle runs late, the next one starts at once, but
+ *      the deadlines are not made up in a burst.
+ *
  * Stazed code (when ready):
  *
  *      If we reposition key-p, FF, rewind, adjust delta_tick for change then
@@ -4835,6 +4982,8 @@ performer::output_func ()
 
         pad().set_current_tick(startpoint);
         set_last_ticks(startpoint);
+        if (pull_mode())
+            pull_start(startpoint);             /* the JACK cycle takes over */
 
         /*
          * We still need to make sure the BPM and PPQN changes are airtight!
@@ -4850,37 +4999,100 @@ performer::output_func ()
         long current;                           /* current time             */
         long elapsed_us, delta_us;              /* current - last           */
         long last = microtime();                /* beginning time           */
+        bool usedeadline = rc().deadline_scheduler();
+        long long period_ns = c_thread_trigger_width_us * 1000LL;
+        double ns_per_tick = pus * 1000.0;
+        long long anchor_ns = nanotime();       /* time of the tempo anchor */
+        long long wake_ns = anchor_ns;          /* the current deadline     */
+        long long woke_ns = anchor_ns;          /* the actual wakeup time   */
+        double anchor_ticks = 0.0;              /* ticks at the anchor      */
+        double sched_ticks = 0.0;               /* ticks at the deadline    */
+        midipulse sched_whole = 0;              /* whole ticks handed out   */
         m_resolution_change = false;            /* BPM/PPQN                 */
+
+        /*
+         * With ALSA queue scheduling, publish when each pulse is due, so that
+         * each event can be queued at the time of its own pulse.  Only valid
+         * while the ticks follow the monotonic clock.
+         */
+
+        pulseclock & pclock = m_master_bus->pulse_clock();
+        bool pulsestamps = rc().with_alsa_midi() &&
+            rc().alsa_queue_scheduling() && ! m_usemidiclock &&
+            ! pull_mode() && ! is_jack_running();
+
+        if (pulsestamps)
+            pclock.anchor(startpoint, anchor_ns, ns_per_tick);
+        else
+            pclock.clear();
+
         while (is_running())
         {
             if (m_resolution_change)            /* an atomic boolean        */
             {
+                if (usedeadline)                /* re-anchor at the change  */
+                {
+                    anchor_ticks = sched_ticks;
+                    anchor_ns = wake_ns;
+                }
                 bwdenom = 4.0 / get_beat_width();
                 bpmfactor = m_master_bus->get_beats_per_minute() * bwdenom;
                 ppqn = m_master_bus->get_ppqn();
                 bpm_times_ppqn = bpmfactor * ppqn;
                 dct = double_ticks_from_ppqn(ppqn);
                 pus = pulse_length_us(bpmfactor, ppqn);
+                ns_per_tick = pus * 1000.0;
+                pclock.retempo(usedeadline ? wake_ns : nanotime(), ns_per_tick);
                 m_resolution_change = false;
             }
 
+            if (pull_mode())                    /* JACK plays the patterns  */
+            {
+                pull_output();
+                (void) microsleep(c_thread_trigger_width_us);
+                if (pad().js_jack_stopped)
+                    inner_stop();
+
+                continue;
+            }
+
             /**
              *  See note 2 and the microsleep() note in the function banner.
              *  See note 3 in the function banner.
              */
 
+            long delta_tick;
             current = microtime();
-            delta_us = elapsed_us = current - last;
+            if (usedeadline)
+            {
+                /*
+                 * See "deadline scheduler" in the banner.
+                 */
 
-            long long delta_tick_num = bpm_times_ppqn * delta_us +
-                pad().js_delta_tick_frac;
+                sched_ticks = anchor_ticks +
+                    double(wake_ns - anchor_ns) / ns_per_tick;
+
+                midipulse whole = midipulse
+                (
+                    sched_ticks + c_deadline_tick_epsilon
+                );
+                delta_tick = long(whole - sched_whole);
+                sched_whole = whole;
+            }
+            else
+            {
+                delta_us = elapsed_us = current - last;
 
-            long delta_tick = long(delta_tick_num / 60000000LL);
-            pad().js_delta_tick_frac = long(delta_tick_num % 60000000LL);
+                long long delta_tick_num = bpm_times_ppqn * delta_us +
+                    pad().js_delta_tick_frac;
+
+                delta_tick = long(delta_tick_num / 60000000LL);
+                pad().js_delta_tick_frac = long(delta_tick_num % 60000000LL);
+            }
             if (m_usemidiclock)
             {
-                delta_tick = m_midiclocktick;       /* int to long          */
-                m_midiclocktick = 0;
+                pclock.clear();                     /* the clock drives     */
+                delta_tick = long(m_clock_follower.advance(current));
                 if (m_midiclockpos >= 0)            /* was after this if    */
                 {
                     delta_tick = 0;
@@ -4892,7 +5104,7 @@ performer::output_func ()
             bool jackrunning = jack_output(pad());
             if (jackrunning)
             {
-                // No additional code needed besides the output() call above.
+                pclock.clear();                     /* JACK drives ticks    */
             }
             else
                 pad().add_delta_tick(delta_tick);   /* add to current ticks */
@@ -4936,6 +5148,7 @@ performer::output_func ()
                         midipulse ltick = get_left_tick();
                         set_last_ticks(ltick);
                         pad().js_current_tick = double(ltick) + leftover_tick;
+                        pclock.shift(rtick - ltick);        /* same times   */
                     }
                     else
                         jack_position_once = false;
@@ -4960,6 +5173,44 @@ performer::output_func ()
                 m_master_bus->emit_clock(midipulse(pad().js_clock_tick));
             }
 
+            if (usedeadline)
+            {
+                long long next_ns = wake_ns + period_ns;
+                double clocktick = pad().js_clock_tick;
+                double nextclock = (std::floor(clocktick / dct) + 1.0) * dct;
+                double frac = sched_ticks - double(sched_whole);
+                long long clock_ns = wake_ns + static_cast<long long>
+                (
+                    (nextclock - clocktick - frac) * ns_per_tick
+                );
+                if (clock_ns > wake_ns && clock_ns < next_ns)
+                    next_ns = clock_ns;             /* wake for MIDI clock  */
+
+                long long now_ns = nanotime();
+                long work_us = long((now_ns - woke_ns) / 1000);
+                perf_counters().end_output_cycle(work_us);
+                if (now_ns < next_ns)
+                {
+                    (void) sleep_until(next_ns);    /* timing.hpp           */
+                    woke_ns = nanotime();
+
+                    long late_us = long((woke_ns - next_ns) / 1000);
+                    perf_counters().output_wake(late_us);
+                    wake_ns = next_ns;
+                    m_delta_us = 0;
+                }
+                else
+                {
+                    wake_ns = woke_ns = now_ns;     /* late, do not burst   */
+                    m_delta_us = long((next_ns - now_ns) / 1000);
+                    perf_counters().output_underrun();
+                }
+                if (pad().js_jack_stopped)
+                    inner_stop();
+
+                continue;
+            }
+
             /*
              *  See "microsleep() call" in banner.  Code is similar to line
              *  3096 above.
@@ -4975,13 +5226,18 @@ performer::output_func ()
             if (next_clock_delta_us < (c_thread_trigger_width_us * 2.0))
                 delta_us = long(next_clock_delta_us);
 
+            perf_counters().end_output_cycle(elapsed_us);
             if (delta_us > 0)
             {
                 (void) microsleep(int(delta_us));           /* timing.hpp   */
+                perf_counters().output_wake(microtime() - current - delta_us);
                 m_delta_us = 0;
             }
             else
             {
+                if (delta_us < 0)
+                    perf_counters().output_underrun();
+
 #if defined SEQ66_PLATFORM_DEBUG && ! defined SEQ66_PLATFORM_WINDOWS
                 if (seq_app_cli())
                 {
@@ -5001,6 +5257,7 @@ performer::output_func ()
             if (pad().js_jack_stopped)
                 inner_stop();
         }
+        pclock.clear();
 
         /*
          * Disabling this setting allows all of the progress bars (seqroll,
@@ -5030,6 +5287,282 @@ performer::output_func ()
     (void) set_timer_services(false);
 }
 
+/**
+ *  The pull-mode callback given to the MIDI engine.  See pull_cycle().
+ *  While another thread holds the callback off (see pull_hold()), the
+ *  cycle is skipped.  The callback is flagged as in the cycle before the
+ *  holds are checked, and pull_hold() does the reverse, so one of them
+ *  always sees the other.
+ *
+ * \param arg
+ *      The performer, passed to mastermidibase::set_engine() in launch().
+ *
+ * \param cycle
+ *      The timing of the JACK cycle.
+ *
+ * \return
+ *      Returns true if the cycle was played.
+ */
+
+bool
+performer::pull_callback (void * arg, engine_cycle & cycle)
+{
+    performer * self = reinterpret_cast<performer *>(arg);
+    bool result = false;
+    if (not_nullptr(self))
+    {
+        self->m_pull_in_cycle = true;
+        if (self->m_pull_holds == 0)
+            result = self->pull_cycle(cycle);
+
+        self->m_pull_in_cycle = false;
+    }
+    return result;
+}
+
+/**
+ *  Keeps the JACK process callback out of the patterns, and waits for it to
+ *  leave a cycle already under way.  Called before the song is cleared or
+ *  replaced, as the callback walks the play-set without locking it.  The
+ *  cycles are skipped until pull_release(); the holds nest.
+ */
+
+void
+performer::pull_hold ()
+{
+    ++m_pull_holds;
+    while (m_pull_in_cycle)
+        (void) microsleep(100);
+}
+
+void
+performer::pull_release ()
+{
+    --m_pull_holds;
+}
+
+/**
+ *  Plays the patterns for one JACK process cycle, in the process callback.
+ *  This replaces the timing and play() calls of output_func() in pull mode.
+ *
+ *  The tick range of the cycle is computed from frames, not from the wall
+ *  clock: the tick at a frame is m_pull_base_tick plus the frames since
+ *  m_pull_base_frame times the ticks per frame.  The frames are those of
+ *  the JACK transport if it is rolling, and otherwise the JACK frame time.
+ *  The base is moved when playback starts, when the tempo changes, when the
+ *  transport is relocated, and when the loop wraps.  So there is no
+ *  accumulated drift, and the cycle's start tick and frames per tick are
+ *  passed back to the engine, which turns each event's tick into an exact
+ *  frame offset.
+ *
+ *  Nothing here waits for a lock held by another thread.  A pattern that is
+ *  busy (say, being edited) is skipped and catches up in the next cycle
+ *  (see sequence::try_play_queue()), and so is a loop wrap that it misses
+ *  (see pull_wrap()).  The events of a busy port stay queued for the next
+ *  cycle (see mastermidibase::try_commit_batch()), and tempo events are
+ *  passed to the output thread (see post_beats_per_minute()).
+ *
+ * \param cycle
+ *      The timing of the JACK cycle.  The ec_start_tick and
+ *      ec_frames_per_tick members are filled in here.
+ *
+ * \return
+ *      Returns true if the cycle was played.
+ */
+
+bool
+performer::pull_cycle (engine_cycle & cycle)
+{
+    if (! pull_mode() || ! is_running())
+    {
+        m_pull_started = false;                 /* wait for next rebase     */
+        return false;
+    }
+
+    double bwdenom = 4.0 / get_beat_width();
+    double bpmfactor = m_master_bus->get_beats_per_minute() * bwdenom;
+    double tpf = bpmfactor * m_master_bus->get_ppqn() /
+        (60.0 * double(cycle.ec_sample_rate));
+
+    if (m_pull_rebase.exchange(false))          /* playback just started    */
+    {
+        m_pull_started = true;
+        m_pull_base_tick = double(m_pull_start_tick);
+        m_pull_base_frame = cycle.ec_frame;
+        m_pull_clock = m_pull_base_tick;
+        m_pull_last_tick = midipulse(m_pull_base_tick) - 1;
+        m_pull_ticks_per_frame = tpf;
+    }
+    else if (! m_pull_started)
+    {
+        return false;
+    }
+    else if
+    (
+        cycle.ec_transport != m_pull_transport ||
+        (cycle.ec_transport && cycle.ec_frame != m_pull_next_frame)
+    )
+    {
+        /*
+         * The transport started, stopped, or was relocated.  While the
+         * transport rolls, the tick follows its frame.
+         */
+
+        m_pull_base_tick = cycle.ec_transport ?
+            double(cycle.ec_frame) * tpf : double(m_pull_tick) ;
+
+        m_pull_base_frame = cycle.ec_frame;
+        m_pull_ticks_per_frame = tpf;
+    }
+
+    unsigned frames = cycle.ec_frame - m_pull_base_frame;  /* can wrap  */
+    double t0 = m_pull_base_tick + double(frames) * m_pull_ticks_per_frame;
+    if (tpf != m_pull_ticks_per_frame)          /* tempo change             */
+    {
+        m_pull_base_tick = t0;
+        m_pull_base_frame = cycle.ec_frame;
+        m_pull_ticks_per_frame = tpf;
+    }
+
+    double t1 = t0 + double(cycle.ec_frames) * tpf;
+    cycle.ec_start_tick = t0;
+    cycle.ec_frames_per_tick = 1.0 / tpf;
+    if (looping())
+    {
+        double rtick = double(get_right_tick());
+        if (t1 > rtick)
+        {
+            midipulse ltick = get_left_tick();
+            if (t0 < rtick)
+                pull_play(midipulse(rtick) - 1);
+
+            pull_wrap(ltick);
+
+            /*
+             * After the wrap, frame 0 of this cycle maps to the tick it
+             * would have had before the left marker.
+             */
+
+            double leftover = t1 - rtick;
+            cycle.ec_start_tick = double(ltick) - (rtick - t0);
+            t1 = double(ltick) + leftover;
+            m_pull_base_tick = t1;
+            m_pull_base_frame = cycle.ec_frame + cycle.ec_frames;
+            m_pull_last_tick = ltick - 1;
+        }
+    }
+
+    midipulse endtick = midipulse(std::ceil(t1)) - 1;  /* ticks before t1  */
+    if (endtick > m_pull_last_tick)
+    {
+        pull_play(endtick);
+        m_pull_last_tick = endtick;
+    }
+    m_pull_clock += double(cycle.ec_frames) * tpf;
+    m_pull_tick = midipulse(t1);
+    m_pull_clock_tick = midipulse(m_pull_clock);
+    m_pull_next_frame = cycle.ec_frame + cycle.ec_frames;
+    m_pull_transport = cycle.ec_transport;
+    return true;
+}
+
+/**
+ *  The pull-mode version of play().  It does not block on the pattern
+ *  locks, and leaves the auto-stop check to pull_output().
+ *
+ * \param tick
+ *      The last tick to play in this cycle.
+ */
+
+void
+performer::pull_play (midipulse tick)
+{
+    bool songmode = song_mode();
+    set_tick(tick);
+    m_master_bus->begin_batch();                    /* queue per buss       */
+    for (auto seqi : play_set().seq_container())
+    {
+        if (seqi)
+            (void) seqi->try_play_queue(tick, songmode, resume_note_ons());
+    }
+    (void) m_master_bus->try_commit_batch();        /* into the JACK cycle  */
+}
+
+/**
+ *  The pull-mode version of the reset_sequences() and set_last_ticks()
+ *  calls made at a loop wrap.  Each pattern of the play-set turns off its
+ *  notes and resumes at the left tick, unless it is locked, in which case
+ *  it does so when next played.  See sequence::try_loop_wrap().  The notes
+ *  turned off are sent with the current cycle.
+ *
+ * \param tick
+ *      The left tick.
+ */
+
+void
+performer::pull_wrap (midipulse tick)
+{
+    bool songmode = song_mode();
+    m_master_bus->begin_batch();
+    for (auto seqi : play_set().seq_container())
+    {
+        if (seqi)
+            (void) seqi->try_loop_wrap(tick, songmode);
+    }
+    (void) m_master_bus->try_commit_batch();
+}
+
+/**
+ *  Called by the output thread when playback starts in pull mode, after the
+ *  starting tick is set.  The next JACK cycle starts playing from there.
+ *
+ * \param tick
+ *      The starting tick.
+ */
+
+void
+performer::pull_start (midipulse tick)
+{
+    m_pull_start_tick = tick;
+    m_pull_tick = tick;
+    m_pull_clock_tick = tick;
+    m_pull_rebase = true;                           /* after the ticks      */
+}
+
+/**
+ *  What is left of the output thread's job in pull mode: following the
+ *  JACK transport state, the auto-stop at the end of the song, the progress
+ *  tick, and the MIDI clock, which goes out through the port ring-buffers.
+ */
+
+void
+performer::pull_output ()
+{
+    (void) jack_output(pad());                      /* transport stop, etc. */
+
+    midibpm bpm = m_pull_bpm.exchange(0.0);
+    if (bpm > 0.0)
+        (void) set_beats_per_minute(bpm);           /* from a tempo event   */
+
+    midipulse tick = m_pull_tick;
+    pad().js_current_tick = double(tick);
+    pad().js_clock_tick = double(m_pull_clock_tick);
+    if (pad().js_init_clock)
+    {
+        m_master_bus->init_clock(midipulse(pad().js_clock_tick));
+        pad().js_init_clock = false;
+    }
+    if (auto_play_stop(tick))
+    {
+        post_song_advance();                        /* see song_func()      */
+    }
+    else
+    {
+        set_jack_tick(tick);
+        m_master_bus->emit_clock(midipulse(pad().js_clock_tick));
+    }
+}
+
 /**
  *  Trying to prevent seqfaults when stopping playback and starting the next
  *  song, as in play-lists.
@@ -5108,7 +5641,7 @@ performer::poll_cycle ()
             }
 
             event ev;
-            if (m_master_bus->get_midi_event(&ev))
+            if (m_master_bus->get_midi_event(&ev) && ! bouncing())
             {
 #if defined USE_EXPERIMENTAL_CODE
 
@@ -5187,7 +5720,7 @@ performer::poll_cycle ()
                 }
                 else if (ev.is_midi_clock())
                 {
-                    midi_clock();
+                    midi_clock(ev);
                 }
                 else if (ev.is_midi_song_pos())
                 {
@@ -5290,7 +5823,8 @@ performer::midi_start ()
 {
     start_playing();
     m_midiclockrunning = m_usemidiclock = true;
-    m_midiclocktick = m_midiclockpos = 0;
+    m_midiclockpos = 0;
+    m_clock_follower.start(m_midiclockincrement);
     if (rc().verbose())
         infoprint("MIDI Start");
 }
@@ -5317,6 +5851,7 @@ performer::midi_continue ()
     m_midiclockpos = get_tick();
     m_dont_reset_ticks = true;
     m_midiclockrunning = m_usemidiclock = true;
+    m_clock_follower.start(m_midiclockincrement);
     start_playing();
     if (rc().verbose())
         infoprint("MIDI Continue");
@@ -5344,6 +5879,7 @@ performer::midi_stop ()
     all_notes_off();
     m_usemidiclock = true;
     m_midiclockrunning = false;
+    m_clock_follower.stop();
     m_midiclockpos = get_tick();
     m_dont_reset_ticks = false;
     auto_stop();
@@ -5363,24 +5899,36 @@ performer::midi_stop ()
  *      arpeggiator synchronization.  Location information can be specified
  *      using MIDI Song Position Pointer.  Many simple MIDI devices ignore
  *      this message.
+ *
+ *      The clock follower is given the time at which the clock arrived at
+ *      the port, if the engine provides it, so that the time the clock
+ *      spent in the input queue does not add to its jitter.  Otherwise the
+ *      time of dispatch is used.
+ *
+ * \param ev
+ *      The clock event.  Its timestamp, if recent, is the arrival time.
  */
 
 void
-performer::midi_clock ()
+performer::midi_clock (const event & ev)
 {
 #if defined SEQ66_PLATFORM_DEBUG_TMI
     if (rc().verbose())
     {
         infoprint("MIDI Clock");
-        if (m_midiclockrunning)
-            m_midiclocktick += m_midiclockincrement;
-        else
+        if (! m_midiclockrunning)
             infoprint("Clock not running");
     }
-    else
 #endif
     if (m_midiclockrunning)
-        m_midiclocktick += m_midiclockincrement;
+    {
+        long now = microtime();
+        long arrival = long(ev.timestamp());
+        if (arrival > now || now - arrival > c_clock_stamp_limit_us)
+            arrival = now;
+
+        m_clock_follower.clock(arrival);
+    }
 }
 
 /**
@@ -5735,6 +6283,168 @@ performer::auto_play_start ()
     return result;
 }
 
+/**
+ *  Reads a whole song file into memory.  This is the disk access done by
+ *  midifile::grab_input_stream(), done ahead by the song thread.
+ *
+ * \param fname
+ *      The full path to the song file.
+ *
+ * \return
+ *      Returns the contents of the file, or an empty vector if the file
+ *      could not be read.  The midifile then reads the file itself, and
+ *      reports the error if there is one.
+ */
+
+static midibytes
+read_song_bytes (const std::string & fname)
+{
+    midibytes result;
+    std::ifstream file(fname, std::ios::in | std::ios::binary | std::ios::ate);
+    if (file.is_open())
+    {
+        std::streamoff size = file.tellg();
+        if (size > 0)
+        {
+            try
+            {
+                result.resize(size_t(size));
+                file.seekg(0, std::ios::beg);
+                file.read((char *)(&result[0]), size);
+                if (! file)
+                    result.clear();
+            }
+            catch (const std::bad_alloc &)
+            {
+                result.clear();
+            }
+        }
+    }
+    return result;
+}
+
+/**
+ *  The song thread.  It waits for a request from post_song_advance() or
+ *  post_preload(), and handles it.  The change of song, which clears the
+ *  current song, parses the next one into the performer, and restarts
+ *  playback, thus never runs on the output thread, nor on the JACK process
+ *  callback, which is held off by open_next_song() while the patterns are
+ *  replaced.  The read-ahead happens here as well, so that no thread is
+ *  created on the output path, and no future is waited on.
+ */
+
+void
+performer::song_func ()
+{
+    while (! done())
+    {
+        if (! m_song_var.wait())
+            break;
+
+        if (done())
+            break;
+
+        if (m_song_advance.exchange(false))
+        {
+            if (playlist_active())
+                (void) clear_song();            /* get ready for next song  */
+
+            (void) open_next_song();
+            (void) auto_play_start();
+        }
+        if (m_song_preload.exchange(false))
+        {
+            std::string fname;
+            {
+                automutex locker(m_preload_mutex);
+                fname.swap(m_preload_request);
+            }
+            if (! fname.empty())
+            {
+                midibytes data = read_song_bytes(fname);
+                automutex locker(m_preload_mutex);
+                m_preload_name = fname;
+                m_preload_data.swap(data);
+            }
+        }
+    }
+}
+
+/**
+ *  Called by the output thread when auto-advance reaches the end of the
+ *  song, after playback has stopped.  The song thread changes the song.  If
+ *  there is no song thread, the song is changed here, as before.
+ */
+
+void
+performer::post_song_advance ()
+{
+    if (m_song_thread_launched)
+    {
+        m_song_advance = true;
+        m_song_var.signal();
+    }
+    else
+    {
+        if (playlist_active())
+            (void) clear_song();
+
+        (void) open_next_song();
+        (void) auto_play_start();
+    }
+}
+
+/**
+ *  Asks the song thread to read a song file ahead.  A request that has not
+ *  been started yet is replaced.
+ *
+ * \param fname
+ *      The full path to the song file.
+ */
+
+void
+performer::post_preload (const std::string & fname)
+{
+    if (m_song_thread_launched)
+    {
+        {
+            automutex locker(m_preload_mutex);
+            m_preload_request = fname;
+        }
+        m_song_preload = true;
+        m_song_var.signal();
+    }
+}
+
+/**
+ *  Gets the bytes read ahead for a song, if they are for that song.  It
+ *  does not wait: if the read has not finished, the song must be read from
+ *  disk as usual.
+ *
+ * \param fname
+ *      The full path to the song file about to be opened.
+ *
+ * \param [out] data
+ *      Receives the file contents.
+ *
+ * \return
+ *      Returns true if the data is available.
+ */
+
+bool
+performer::take_preload (const std::string & fname, midibytes & data)
+{
+    automutex locker(m_preload_mutex);
+    bool result = fname == m_preload_name && ! m_preload_data.empty();
+    if (result)
+    {
+        data.swap(m_preload_data);
+        m_preload_data.clear();
+        m_preload_name.clear();
+    }
+    return result;
+}
+
 /**
  *  auto_stop() disengages auto-play. Instead we just stop with rewind.
  *
@@ -5757,11 +6467,7 @@ performer::auto_play_stop (midipulse tick)
         {
             result = m_play_list->auto_advance_engaged();
             if (result)
-            {
-                stop_playing(true);
-                if (playlist_active())
-                    (void) clear_song();        /* get ready for the next song  */
-            }
+                stop_playing(true);     /* song_func() changes the song     */
         }
         else
         {
@@ -5791,6 +6497,10 @@ performer::auto_play_stop (midipulse tick)
  *  notes twice when the tick changes by a small amount.  Not yet sure what to
  *  do about this.
  *
+ *  The events played by all of the patterns are collected in a per-buss
+ *  batch by the master buss, and sent at the end of the cycle with one flush
+ *  per buss, rather than with a lock/play/flush for every event.
+ *
  * \param tick
  *      Provides the tick at which to start playing.  This value is also
  *      copied to m_tick.
@@ -5803,13 +6513,13 @@ performer::play (midipulse tick)
     {
         if (auto_play_stop(tick))
         {
-            (void) open_next_song();
-            auto_play_start();
+            post_song_advance();                        /* see song_func()  */
         }
         else
         {
             bool songmode = song_mode();
             set_tick(tick);
+            m_master_bus->begin_batch();                /* queue per buss   */
             for (auto seqi : play_set().seq_container())
             {
                 if (seqi)
@@ -5819,9 +6529,127 @@ performer::play (midipulse tick)
                 else
                     append_error_message("play on null sequence");
             }
-            m_master_bus->flush();                      /* flush MIDI buss  */
+            m_master_bus->commit_batch();               /* send, flush once */
+        }
+    }
+}
+
+/**
+ *  Starts or stops recording the events played by the patterns on the
+ *  calling thread, instead of sending them to the master buss.  The thread
+ *  is stored before the recorder is published, and a second recorder is
+ *  not installed over the first.
+ *
+ * \param mc
+ *      The recorder, or nullptr to stop recording.  The caller keeps
+ *      ownership, and must not destroy it before calling capture(nullptr).
+ */
+
+void
+performer::capture (midicapture * mc)
+{
+    if (is_nullptr(mc))
+    {
+        m_capture = nullptr;
+    }
+    else if (is_nullptr(m_capture.load()))
+    {
+        m_capture_thread = std::this_thread::get_id();
+        m_capture = mc;
+    }
+}
+
+/**
+ *  Gets the recorder, if there is one and the caller is the thread that
+ *  installed it.  The check costs one atomic load when not capturing.
+ */
+
+midicapture *
+performer::capturing () const
+{
+    midicapture * result = m_capture;
+    if (not_nullptr(result) && m_capture_thread != std::this_thread::get_id())
+        result = nullptr;
+
+    return result;
+}
+
+/**
+ *  Renders the song offline ("bounce") into a MIDI file.  The patterns are
+ *  played as by the output thread, but one tick at a time and as fast as
+ *  they can go, and whatever they send to the busses is recorded with its
+ *  tick instead of being sent.  The file thus holds what the engine plays:
+ *  queueing, transposition, tempo events, and the metronome, if armed.
+ *  It has a tempo track, and one track per buss.
+ *
+ *  Song mode renders the triggers; Live mode renders the armed patterns.
+ *  Either way the render runs to the end of the song, as given by
+ *  get_max_extent(), and the notes still on are turned off there.  The
+ *  count-in is not rendered; it is a cue for the player, and is started and
+ *  stopped by the output thread.
+ *
+ *  Playback must be stopped.  The master buss is not used, so the render
+ *  needs no MIDI engine (see smanager::create_performer()).  If there is
+ *  one, the MIDI input is dropped during the render, so that no MIDI thru
+ *  reaches the ports, and the events that other threads play, such as a
+ *  note previewed in an editor, are not recorded.  The tempo is set back
+ *  to its starting value afterward.
+ *
+ * \param filename
+ *      The full path to the MIDI file to be written.
+ *
+ * \param [out] errmsg
+ *      Set to a message if the render fails.
+ *
+ * \return
+ *      Returns true if the file was written.
+ */
+
+bool
+performer::bounce (const std::string & filename, std::string & errmsg)
+{
+    bool result = false;
+    midipulse endtick = get_max_extent();
+    if (is_running())
+        errmsg = "Stop playback before rendering";
+    else if (endtick <= 0)
+        errmsg = "Nothing to render";
+    else
+    {
+        midicapture cap(ppqn());
+        bool songmode = song_mode();
+        midibpm startbpm = get_beats_per_minute();
+        if (songmode)
+            off_sequences();                    /* as inner_start() does    */
+
+        reset_sequences();                      /* rewind all the patterns  */
+        capture(&cap);                          /* also drops MIDI input    */
+        cap.time_signature(get_beats_per_bar(), get_beat_width());
+        cap.tempo(startbpm);
+        for (midipulse tick = 0; tick <= endtick; ++tick)
+        {
+            cap.tick(tick);
+            set_tick(tick);
+            for (auto seqi : play_set().seq_container())
+            {
+                if (seqi)
+                    seqi->play_queue(tick, songmode, resume_note_ons());
+            }
+            cap.tempo(get_beats_per_minute());  /* tempo events just played */
+        }
+        reset_sequences();                      /* final Note Offs          */
+        capture(nullptr);
+        set_tick(0);
+        (void) set_beats_per_minute(startbpm);
+        result = cap.write(filename, errmsg);
+        if (result)
+        {
+            std::string msg = std::to_string(cap.event_count());
+            msg += " events rendered to";
+            file_message(msg, filename);
         }
     }
+    return result;
 }
 
 void
@@ -5831,8 +6659,9 @@ performer::play_all_sets (midipulse tick)
     {
         set_tick(tick);
         sequence::playback songmode = song_start_mode();
+        m_master_bus->begin_batch();                    /* queue per buss   */
         set_mapper().play_all_sets(tick, songmode, resume_note_ons());
-        m_master_bus->flush();                          /* flush MIDI buss  */
+        m_master_bus->commit_batch();                   /* send, flush once */
     }
 }
 
@@ -7774,6 +8603,26 @@ performer::signal_quit ()
     signal_for_exit();                  /* provided by the daemonize module */
 }
 
+/**
+ *  Appends the timing counters (see the perfcounters module) to the file
+ *  "timing.log" in the configuration directory.  Called by the main loop of
+ *  the application when the session_report() flag is raised by SIGUSR2.
+ *
+ * \return
+ *      Returns true if the report could be written.
+ */
+
+bool
+performer::write_timing_report ()
+{
+    std::string filename = rc().make_config_filespec("timing.log");
+    bool result = perf_counters().write_report(filename);
+    if (result)
+        file_message("Timing report", filename);
+
+    return result;
+}
+
 /**
  *  Adds a member function to an automation slot.
  */
@@ -9225,6 +10074,13 @@ performer::automation_playlist
  * \param [out] errmsg
  *      Provides the destination for an error message, if any.
  *
+ * \param addtorecent
+ *      If true, the file is added to the recent-files list.
+ *
+ * \param preloaded
+ *      If not null, the contents of the file as read ahead by the song thread.
+ *      They are moved from.
+ *
  * \return
  *      Returns true if the function succeeded.  If false is returned, there
  *      should be an errmsg to display.
@@ -9235,7 +10091,8 @@ performer::read_midi_file
 (
     const std::string & fn,
     std::string & errmsg,
-    bool addtorecent
+    bool addtorecent,
+    midibytes * preloaded
 )
 {
     errmsg.clear();
@@ -9247,7 +10104,10 @@ performer::read_midi_file
     usr().clear_global_seq_features();
     m_song_info.clear();
 
-    bool result = seq66::read_midi_file(*this, fn, ppqn(), errmsg, addtorecent);
+    bool result = seq66::read_midi_file
+    (
+        *this, fn, ppqn(), errmsg, addtorecent, preloaded
+    );
     if (result)
     {
         mutegroup::number mg = mutegroup::unassigned();         /* not 0    */
@@ -9498,7 +10358,9 @@ performer::open_next_song (bool opensong)
     bool result = bool(m_play_list);
     if (result)
     {
+        pull_hold();                            /* the song is replaced     */
         result = m_play_list->open_next_song(opensong);
+        pull_release();
         if (result)
             handle_song_change(opensong);
     }
@@ -9517,7 +10379,9 @@ performer::open_previous_song (bool opensong)
     bool result = bool(m_play_list);
     if (result)
     {
+        pull_hold();                            /* the song is replaced     */
         result = m_play_list->open_previous_song(opensong);
+        pull_release();
         if (result)
             handle_song_change(opensong);
     }
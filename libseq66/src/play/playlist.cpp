@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-08-26
- * \updates       2026-05-10
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  See the playlistfile class for information on the file format.
@@ -33,6 +33,7 @@
 
 #include <cctype>                       /* std::toupper() function          */
 #include <iostream>                     /* std::cout                        */
+#include <iterator>                     /* std::next()                      */
 #include <utility>                      /* std::make_pair()                 */
 #include <string.h>                     /* memset()                         */
 
@@ -273,7 +274,9 @@ playlist::open_song (const std::string & fname, bool verifymode)
     if (result)
     {
         std::string errmsg_dummy;
-        result = m_performer->read_midi_file(fname, errmsg_dummy, false);
+        midibytes data;
+        (void) m_performer->take_preload(fname, data);
+        result = m_performer->read_midi_file(fname, errmsg_dummy, false, &data);
         if (result && verifymode)
         {
             /* nothing to do yet */
@@ -282,6 +285,38 @@ playlist::open_song (const std::string & fname, bool verifymode)
     return result;
 }
 
+/**
+ *  Asks the performer's song thread to read the song after the current
+ *  one, the one that next_song() would select, while the current one plays.
+ *  When the playlist moves to that song, it is parsed from memory, rather
+ *  than read from the disk.  See performer::song_func().
+ *
+ *  Parsing ahead into a detached song is not possible, because the
+ *  midifile parses straight into the performer, and sets global settings
+ *  (such as the PPQN and the song features in usr()) as it goes.  The
+ *  change of song is therefore done by the song thread, and not by the
+ *  output thread, which only asks for it.
+ */
+
+void
+playlist::preload_next_song ()
+{
+    if (m_current_list != m_play_lists.end())
+    {
+        song_list & slist = m_current_list->second.ls_song_list;
+        if (m_current_song != slist.end())
+        {
+            song_list::iterator s = std::next(m_current_song);
+            if (s == slist.end())
+                s = slist.begin();
+
+            std::string fname = song_filepath(s->second);
+            if (! fname.empty())
+                m_performer->post_preload(fname);
+        }
+    }
+}
+
 /**
  *  Selects the song based on the index (row) value, and optionally opens it.
  *
@@ -549,7 +584,11 @@ playlist::open_current_song ()
                 if (! fname.empty())
                 {
                     result = open_song(fname);
-                    if (! result)
+                    if (result)
+                    {
+                        preload_next_song();
+                    }
+                    else
                     {
                         (void) set_file_error_message
                         (
@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-07-24
- * \updates       2026-06-05
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  The functionality of this class also includes handling some of the
@@ -57,12 +57,14 @@
 
 #define _USE_MATH_DEFINES
 
+#include <algorithm>                    /* std::lower_bound()               */
 #include <cstring>                      /* std::memset()                    */
 #include <cmath>                        /* std::trunc()                     */
 
 #include "cfg/settings.hpp"             /* seq66::rc() and usr()            */
 #include "cfg/scales.hpp"               /* key and scale constants          */
 #include "midi/mastermidibus.hpp"       /* seq66::mastermidibus             */
+#include "midi/midicapture.hpp"         /* seq66::midicapture for bounce()  */
 #include "midi/midibus.hpp"             /* seq66::midibus                   */
 #include "play/notemapper.hpp"          /* seq66::notemapper                */
 #include "play/performer.hpp"           /* seq66::performer                 */
@@ -168,8 +170,7 @@ sequence::sequence (int ppqn) :
     m_events_undo_hold          (),
     m_have_undo                 (false),
     m_have_redo                 (false),
-    m_events_undo               (),
-    m_events_redo               (),
+    m_events_undo               (usr().undo_budget_bytes()),
     m_channel_match             (false),
     m_midi_channel              (0),            /* null_channel() better?   */
     m_free_channel              (false),
@@ -212,6 +213,18 @@ sequence::sequence (int ppqn) :
     m_last_tick                 (0),
     m_queued_tick               (0),
     m_trigger_offset            (0),
+    m_wrap_pending              (false),
+    m_wrap_tick                 (0),
+    m_wrap_songmode             (false),
+    m_play_index                (0),
+    m_play_offset_base          (0),
+    m_play_next_tick            (0),
+    m_play_length               (0),
+    m_play_count                (0),
+    m_play_cursor_valid         (false),
+    m_play_events               (),
+    m_draw_snapshot             (),
+    m_draw_version              (0),
     m_maxbeats                  (c_maxbeats),
     m_ppqn                      (choose_ppqn(ppqn)),
     m_seq_number                (unassigned()),
@@ -335,7 +348,6 @@ sequence::partial_assign (const sequence & rhs, bool domodify)
          *  m_have_undo
          *  m_have_redo
          *  m_events_undo
-         *  m_events_redo
          */
 
         m_channel_match             = rhs.m_channel_match;
@@ -387,6 +399,9 @@ sequence::partial_assign (const sequence & rhs, bool domodify)
         m_cc                        = 0;
         m_name                      = rhs.m_name;
         m_last_tick = m_queued_tick = m_trigger_offset = 0;
+        reset_play_cursor();
+        m_play_events.invalidate();
+        invalidate_draw_snapshot();
 
         /*
          * Read-only:    m_maxbeats = rhs.m_maxbeats;
@@ -1049,13 +1064,14 @@ sequence::apply_time_factor
  *-------------------------------------------------------------------------*/
 
 /**
- *  Pushes the event-list into the undo-list or the upcoming undo-hold-list.
+ *  Announces an edit to the undo log.  The log records only the events that
+ *  the edit changes, which it finds at the next push or undo.
  *
  * \threadsafe
  *
  * \param hold
  *      A new parameter for the stazed undo/redo support, not yet used.
- *      If true (the default is false), then the events go into the
+ *      If true (the default is false), then undoing the edit restores the
  *      undo-hold-list.
  */
 
@@ -1064,7 +1080,7 @@ sequence::push_undo (bool hold)
 {
     automutex locker(m_mutex);
     if (hold)
-        m_events_undo.push(m_events_undo_hold);     /* stazed   */
+        m_events_undo.push(m_events, m_events_undo_hold);   /* stazed   */
     else
         m_events_undo.push(m_events);
 
@@ -1081,13 +1097,14 @@ sequence::push_undo (bool hold)
 void
 sequence::set_have_undo ()
 {
-    m_have_undo = m_events_undo.size() > 0;
+    m_have_undo = m_events_undo.can_undo();
 }
 
 /**
- *  If there are items on the undo list, this function pushes the event-list
- *  into the redo-list, puts the top of the undo-list into the event-list, pops
- *  from the undo-list, calls verify_and_link(), and then calls unselect().
+ *  If there is an edit to undo, this function restores the events it
+ *  changed, moves the edit to the redo log, and then calls unselect().  The
+ *  note links are restored along with the events, so no verify_and_link() is
+ *  needed.
  *
  *  We would like to be able to set performer's modify flag to false here, but
  *  other sequences might still be in a modified state.  We could add a modify
@@ -1100,23 +1117,19 @@ void
 sequence::pop_undo ()
 {
     automutex locker(m_mutex);
-    if (! m_events_undo.empty())
+    if (m_events_undo.undo(m_events))
     {
-        m_events_redo.push(m_events);
-        m_events = m_events_undo.top();
-        m_events_undo.pop();
-        (void) verify_and_link();
         unselect();
+        m_play_events.invalidate();
     }
     set_have_undo();
     set_have_redo();
 }
 
 /**
- *  If there are items on the redo list, this function pushes the
- *  event-list into the undo-list, puts the top of the redo-list into the
- *  event-list, pops from the redo-list, calls verify_and_link(), and then
- *  calls unselect.
+ *  If there is an edit to redo, this function reapplies it, moves it back
+ *  to the undo log, and then calls unselect.  As with pop_undo(), the links
+ *  come along with the events.
  *
  * \threadsafe
  */
@@ -1125,13 +1138,10 @@ void
 sequence::pop_redo ()
 {
     automutex locker(m_mutex);
-    if (! m_events_redo.empty())                // move to triggers module?
+    if (m_events_undo.redo(m_events))
     {
-        m_events_undo.push(m_events);
-        m_events = m_events_redo.top();
-        m_events_redo.pop();
-        (void) verify_and_link();
         unselect();
+        m_play_events.invalidate();
     }
     set_have_undo();
     set_have_redo();
@@ -1736,55 +1746,45 @@ sequence::play
         if (transpose == 0)
             transpose = transposable() ? perf()->get_transpose() : 0 ;
 
-        auto e = m_events.begin();
-        while (e != m_events.end())
-        {
-#if defined USE_NULL_EVENT_DETECTION
-
-            /*
-             * This doesn't solve the problem of hiccups when moving to the
-             * next song in the playlist.
-             */
+        /*
+         * In JACK pull mode, each event is stamped with its own tick, so that
+         * it gets an exact frame offset, and we must not sleep, as we are in
+         * the JACK process callback.  With ALSA queue scheduling, the tick
+         * gives the time at which the event is queued.
+         */
 
-            if (is_nullptr(e))
-                return;
-#endif
-            event & er = eventlist::dref(e);
-            midipulse ts = er.timestamp();
-            midipulse stamp = ts + offset_base;
+        bool pulling = perf()->pull_mode();
+        bool stamping = pulling || perf()->pulse_stamps();
+        int count = 0;
+        int e = play_cursor(start_tick_offset, offset_base, len, count);
+        while (e < count)
+        {
+            const playevents::record & r = m_play_events[e];
+            midipulse stamp = r.timestamp() + offset_base;
             if (stamp >= start_tick_offset && stamp <= end_tick_offset)
             {
-                if (transpose != 0 && er.is_note()) /* includes Aftertouch  */
+                if (r.is_extended())
                 {
-                    event trans_event = er;         /* assign ALL members   */
-                    trans_event.transpose_note(transpose);
-                    put_event_on_bus(trans_event);
+                    const event & er = m_play_events.extra(r);
+                    if (er.is_tempo())
+                        perf()->post_beats_per_minute(er.tempo());
+                    else if (er.is_sysex())
+                        put_event_on_bus(er);       /* ca 2024-05-22        */
                 }
                 else
                 {
-                    if (er.is_tempo())
-                    {
-                        perf()->set_beats_per_minute(er.tempo());
-                    }
-                    else
-                    {
-                        if (er.is_ex_data())
-                        {
-                            if (er.is_sysex())
-                                put_event_on_bus(er);   /* ca 2024-05-22    */
-                        }
-                        else
-                            put_event_on_bus(er);   /* frame still going    */
-                    }
+                    midipulse t = stamping ?
+                        stamp - offset : perf()->get_tick() ;
+                    put_record_on_bus(r, t, transpose); /* frame going      */
                 }
             }
             else if (stamp > end_tick_offset)
                 break;                              /* frame is done        */
 
             ++e;                                    /* go to next event     */
-            if (e == m_events.end())                /* did we hit the end ? */
+            if (e == count)                         /* did we hit the end ? */
             {
-                e = m_events.begin();               /* yes, start over      */
+                e = 0;                              /* yes, start over      */
                 offset_base += len;                 /* for another go at it */
 
                 /*
@@ -1794,9 +1794,11 @@ sequence::play
                  * unmuting shorter patterns, which play() relentlessly.
                  */
 
-                (void) microsleep(1);
+                if (! pulling && ! perf()->bouncing())
+                    (void) microsleep(1);
             }
         }
+        save_play_cursor(e, offset_base, end_tick_offset + 1, len);
     }
     else
     {
@@ -1859,36 +1861,148 @@ sequence::live_play (midipulse tick)
             }
         }
 
-        auto e = m_events.begin();
-        while (e != m_events.end())
+        bool pulling = perf()->pull_mode();         /* see play()           */
+        bool stamping = pulling || perf()->pulse_stamps();
+        int count = 0;
+        int e = play_cursor(start_tick_offset, offset_base, len, count);
+        while (e < count)
         {
-            event & er = eventlist::dref(e);
-            midipulse stamp = er.timestamp() + offset_base;
+            const playevents::record & r = m_play_events[e];
+            midipulse stamp = r.timestamp() + offset_base;
             if (stamp >= start_tick_offset && stamp <= end_tick_offset)
             {
+                if (r.is_extended())
+                {
+                    const event & er = m_play_events.extra(r);
 #if defined SUPPORT_TEMPO_IN_LIVE_PLAY
-                if (er.is_tempo())
+                    if (er.is_tempo())
+                    {
+                        perf()->post_beats_per_minute(er.tempo());
+                    }
+#endif
+                    put_event_on_bus(er);           /* frame still going    */
+                }
+                else
                 {
-                    perf()->set_beats_per_minute(er.tempo());
+                    midipulse t = stamping ?
+                        stamp - len : perf()->get_tick() ;
+                    put_record_on_bus(r, t);        /* frame still going    */
                 }
-#endif
-                put_event_on_bus(er);               /* frame still going    */
             }
             else if (stamp > end_tick_offset)
                 break;                              /* frame is done        */
 
             ++e;                                    /* go to next event     */
-            if (e == m_events.end())                /* did we hit the end ? */
+            if (e == count)                         /* did we hit the end ? */
             {
-                e = m_events.begin();               /* yes, start over      */
+                e = 0;                              /* yes, start over      */
                 offset_base += len;                 /* for another go at it */
-                (void) microsleep(1);
+                if (! pulling && ! perf()->bouncing())
+                    (void) microsleep(1);
             }
         }
+        save_play_cursor(e, offset_base, end_tick_offset + 1, len);
     }
     m_last_tick = end_tick + 1;                     /* for next frame       */
 }
 
+/**
+ *  Provides the event at which play() or live_play() start scanning the
+ *  current frame.  If the cursor saved at the end of the previous frame is
+ *  still good, scanning resumes there, so that the work done per frame
+ *  depends only on the number of events due in the frame, not on the size
+ *  of the pattern.
+ *
+ *  Otherwise (first frame, reposition, loop or trigger change, length change,
+ *  or edit), the whole passes through the pattern that end before the
+ *  frame are skipped arithmetically, and the first event in the remaining
+ *  pass at or after the start of the frame is found by binary search.
+ *
+ *  The scan is done over the compact playback copy of the events, which is
+ *  rebuilt here if the events have changed since it was last built.
+ *
+ * \threadunsafe
+ *      The caller must hold m_mutex.
+ *
+ * \param starttick
+ *      The start of the frame, offset as done in play().
+ *
+ * \param [inout] offsetbase
+ *      On input, the loop offset based on the current tick.  On output, the
+ *      loop offset of the event returned.
+ *
+ * \param len
+ *      The length of the pattern, guaranteed to be greater than 0.
+ *
+ * \param [out] count
+ *      Set to the number of playback records.
+ *
+ * \return
+ *      Returns the index of the first record to examine, or \a count if
+ *      there are no events.
+ */
+
+int
+sequence::play_cursor
+(
+    midipulse starttick, midipulse & offsetbase, midipulse len, int & count
+)
+{
+    bool valid = m_play_cursor_valid.exchange(true);
+    if (m_play_events.stale(m_events.count()))
+    {
+        m_play_events.rebuild(m_events);
+        valid = false;
+    }
+    count = m_play_events.count();
+    if (valid)
+    {
+        valid = m_play_next_tick == starttick && m_play_length == len &&
+            m_play_count == count && m_play_index < count;
+    }
+    if (valid)
+    {
+        offsetbase = m_play_offset_base;
+        return m_play_index;
+    }
+    if (count == 0)
+        return count;
+
+    midipulse lastts = m_play_events.last_timestamp();
+    midipulse behind = starttick - (offsetbase + lastts);
+    if (behind > 0)
+        offsetbase += ((behind + len - 1) / len) * len;
+
+    return m_play_events.lower_bound(starttick - offsetbase);
+}
+
+/**
+ *  Saves the position at which play() or live_play() stopped, for use by
+ *  play_cursor() in the next frame.
+ *
+ * \threadunsafe
+ *      The caller must hold m_mutex.
+ */
+
+void
+sequence::save_play_cursor
+(
+    int index, midipulse offsetbase,
+    midipulse nexttick, midipulse len
+)
+{
+    if (index < m_play_events.count())
+    {
+        m_play_index = index;
+        m_play_offset_base = offsetbase;
+        m_play_next_tick = nexttick;
+        m_play_length = len;
+        m_play_count = m_play_events.count();
+    }
+    else
+        reset_play_cursor();
+}
+
 /**
  *  This function verifies state: all note-ons have a note-off, and it links
  *  note-offs with their note-ons and vice-versa.
@@ -1905,6 +2019,7 @@ sequence::verify_and_link (bool wrap)
 {
     automutex locker(m_mutex);
     midipulse len = expanded_recording() ? 0 : get_length() ;
+    invalidate_draw_snapshot();
     return m_events.verify_and_link(len, wrap);
 }
 
@@ -1968,7 +2083,7 @@ sequence::remove (event::buffer::iterator evi)
         event & er = eventlist::dref(evi);
         if (er.is_note_off() && m_playing_notes[er.get_note()] > 0)
         {
-            master_bus()->play_and_flush(m_true_bus, &er, midi_channel(er));
+            send_on_bus(er, midi_channel(er));
             --m_playing_notes[er.get_note()];
         }
         if (m_events.remove(evi))
@@ -2094,6 +2209,7 @@ bool
 sequence::mark_selected ()
 {
     automutex locker(m_mutex);
+    invalidate_draw_snapshot();
     return m_events.mark_selected();
 }
 
@@ -2405,6 +2521,7 @@ sequence::select_note_events
 )
 {
     automutex locker(m_mutex);
+    invalidate_draw_snapshot();
     return m_events.select_note_events(tick_s, note_h, tick_f, note_l, action);
 }
 
@@ -2427,6 +2544,7 @@ sequence::select_notes_by_pitch (int note_h, int note_l)
     midipulse t0 = 0;
     midipulse t1 = get_length();
     eventlist::select seltype = eventlist::select::selecting;
+    invalidate_draw_snapshot();
     return m_events.select_note_events(t0, note_h, t1, note_l, seltype);
 }
 
@@ -2467,6 +2585,7 @@ sequence::select_events
 )
 {
     automutex locker(m_mutex);
+    invalidate_draw_snapshot();
     return m_events.select_events(tick_s, tick_f, status, cc, action);
 }
 
@@ -2522,6 +2641,7 @@ sequence::select_events (midibyte status, midibyte cc, bool inverse)
                 er.select();
         }
     }
+    invalidate_draw_snapshot();
     return 0;
 }
 
@@ -2552,6 +2672,7 @@ sequence::select_all ()
 {
     automutex locker(m_mutex);
     m_events.select_all();
+    invalidate_draw_snapshot();
 }
 
 void
@@ -2561,6 +2682,7 @@ sequence::select_by_channel (int channel)
     {
         automutex locker(m_mutex);
         m_events.select_by_channel(channel);
+        invalidate_draw_snapshot();
     }
 }
 
@@ -2571,6 +2693,7 @@ sequence::select_notes_by_channel (int channel)
     {
         automutex locker(m_mutex);
         m_events.select_notes_by_channel(channel);
+        invalidate_draw_snapshot();
     }
 }
 
@@ -2585,6 +2708,7 @@ sequence::unselect ()
 {
     automutex locker(m_mutex);
     m_events.unselect_all();
+    invalidate_draw_snapshot();
 }
 
 /**
@@ -4577,11 +4701,11 @@ bool
 sequence::add_event (const event & er)
 {
     automutex locker(m_mutex);
-    bool result = m_events.append(er);  /* no-sort insertion of event       */
+    bool result = m_events.add(er);     /* O(log n) sorted insertion        */
     if (result)
     {
         if (er.is_note_off())
-            (void) verify_and_link();   /* for proper seqroll draw; sorts   */
+            (void) m_events.link_unlinked();    /* existing links survive   */
 
         /*
          * Is this change safe? No. Do not allow it to call notify_change(),
@@ -4613,6 +4737,7 @@ bool
 sequence::append_event (const event & er)
 {
     automutex locker(m_mutex);
+    invalidate_draw_snapshot();
     return m_events.append(er);     /* does *not* sort, too time-consuming  */
 }
 
@@ -4621,6 +4746,8 @@ sequence::sort_events ()
 {
     automutex locker(m_mutex);
     m_events.sort();
+    m_play_events.invalidate();         /* the order may have changed       */
+    invalidate_draw_snapshot();
 }
 
 event
@@ -4684,25 +4811,28 @@ sequence::remove_duplicate_events (midipulse tick, int note)
 {
     automutex locker(m_mutex);
     bool result { false };
-    bool marked { false };
-    for (auto & er : m_events)
+    if (note != (-1))                       /* read-only, see eventundo     */
     {
-        bool evpresent { er.is_painted() && er.timestamp() == tick };
-        if (evpresent)
+        for (auto ei = m_events.cbegin(); ei != m_events.cend(); ++ei)
         {
-            if (note != (-1))
+            bool evmatch
             {
-                bool evmatch
-                {
-                    er.is_note_on() && note == er.get_note()
-                };
-                if (evmatch)
-                {
-                    result = true;          /* ignore (don't add) the note  */
-                    break;
-                }
+                ei->is_painted() && ei->timestamp() == tick &&
+                ei->is_note_on() && note == ei->get_note()
+            };
+            if (evmatch)
+            {
+                result = true;              /* ignore (don't add) the note  */
+                break;
             }
-            else                            /* not a note event, mark it    */
+        }
+    }
+    else                                    /* not a note event, mark it    */
+    {
+        bool marked { false };
+        for (auto & er : m_events)
+        {
+            if (er.is_painted() && er.timestamp() == tick)
             {
                 er.mark();
                 if (er.is_linked())
@@ -4712,10 +4842,9 @@ sequence::remove_duplicate_events (midipulse tick, int note)
                 set_dirty();
             }
         }
+        if (marked)
+            (void) remove_marked();
     }
-    if (marked)
-        (void) remove_marked();
-
     return result;
 }
 
@@ -4796,13 +4925,51 @@ sequence::add_macro (midipulse tick, const midimacro & macro)
     bool result = macro.is_valid();
     if (result)
     {
+        event::buffer evlist;
         for (int i = 0; i < macro.event_count(); ++i)
         {
             const midibytes & dbytes = macro.bytes(i);
-            result = add_event(tick, dbytes);
-            if (! result)
+            evlist.push_back(create_event(tick, dbytes));
+        }
+        result = add_events(evlist);
+    }
+    return result;
+}
+
+/**
+ *  Adds a batch of events, such as a burst of recorded events, with one
+ *  lock, one merge (see eventlist::add(const event::buffer &)), and at most
+ *  one note-linking pass, instead of doing each for every event.
+ *
+ * \threadsafe
+ *
+ * \param evlist
+ *      The events to add.  They need not be sorted.
+ *
+ * \return
+ *      Returns true if any events were added.
+ */
+
+bool
+sequence::add_events (const event::buffer & evlist)
+{
+    automutex locker(m_mutex);
+    bool result = m_events.add(evlist);
+    if (result)
+    {
+        bool hasnotes = false;
+        for (const auto & e : evlist)
+        {
+            if (e.is_note())
+            {
+                hasnotes = true;
                 break;
+            }
         }
+        if (hasnotes)
+            (void) verify_and_link();
+
+        modify(false);
     }
     return result;
 }
@@ -5080,7 +5247,10 @@ sequence::stream_event (event & ev)
          */
 
         if (ev.is_note_off())
+        {
             (void) m_events.verify_and_link();
+            invalidate_draw_snapshot();
+        }
     }
     return result;
 }
@@ -5105,7 +5275,9 @@ sequence::set_dirty_mp ()
 
 /**
  *  Call set_dirty_mp() and then sets the dirty flag for editing. Note that it
- *  does not call performer::modify().
+ *  does not call performer::modify().  Since an edit can move events, the
+ *  play cursor is also marked as stale, as are the compact playback copy of
+ *  the events and the drawing snapshot.
  */
 
 void
@@ -5113,6 +5285,9 @@ sequence::set_dirty ()
 {
     set_dirty_mp();
     m_dirty_edit = true;
+    reset_play_cursor();
+    m_play_events.invalidate();
+    invalidate_draw_snapshot();
 }
 
 /**
@@ -6008,6 +6183,23 @@ sequence::reset_draw_trigger_marker ()
     m_triggers.reset_draw_trigger_marker();
 }
 
+/**
+ *  Sets the draw-trigger iterator to the last trigger starting at or before
+ *  the given tick, found by a binary search.
+ *
+ * \threadsafe
+ *
+ * \param tick
+ *      The first tick of the area to be drawn.
+ */
+
+void
+sequence::reset_draw_trigger_marker (midipulse tick)
+{
+    automutex locker(m_mutex);
+    m_triggers.reset_draw_trigger_marker(tick);
+}
+
 /**
  *  A new function provided so that we can find the minimum and maximum notes
  *  with only one (not two) traversal of the event list.
@@ -6114,6 +6306,48 @@ sequence::get_next_note
     return draw::finish;
 }
 
+/**
+ *  Provides the drawable events of the pattern, as get_next_note() would
+ *  find them, in an immutable copy.  The user-interface can paint from it
+ *  without touching m_mutex, which sequence::play() holds on the output
+ *  thread, and without locking it again for every note.
+ *
+ *  The copy is kept until a change to the events, or to their selection,
+ *  increments m_draw_version.  Then the next caller rebuilds it, locking the
+ *  mutex once for the whole pattern, and publishes it.  The pointer is
+ *  loaded and stored atomically, and a reader keeps its copy alive for as
+ *  long as it holds the pointer, so a rebuild never disturbs a paint in
+ *  progress.
+ *
+ * \return
+ *      Returns a pointer to the current snapshot.  It is never null.
+ */
+
+sequence::draw_snapshot_ptr
+sequence::get_draw_snapshot () const
+{
+    draw_snapshot_ptr result = std::atomic_load(&m_draw_snapshot);
+    unsigned version = m_draw_version.load(std::memory_order_acquire);
+    if (! result || result->version() != version)
+    {
+        automutex locker(m_mutex);
+        version = m_draw_version.load(std::memory_order_acquire);
+
+        auto snap = std::make_shared<draw_snapshot>(version);
+        snap->ds_notes.reserve(std::size_t(m_events.count()));
+        for (auto evi = m_events.cbegin(); evi != m_events.cend(); ++evi)
+        {
+            note_info ni;
+            draw dt = get_note_info(ni, evi);
+            if (dt != draw::none)
+                snap->ds_notes.emplace_back(dt, ni);
+        }
+        result = snap;
+        std::atomic_store(&m_draw_snapshot, result);
+    }
+    return result;
+}
+
 /**
  *  Copies important information for drawing a note event.
  *
@@ -6459,6 +6693,7 @@ sequence::set_last_tick (midipulse tick)
         tick = m_length;
 
     m_last_tick = tick;
+    m_wrap_pending = false;                 /* superseded                   */
 }
 
 /**
@@ -7335,10 +7570,91 @@ sequence::put_event_on_bus (const event & ev)
     {
         event evout;
         evout.prep_for_send(perf()->get_tick(), ev);      /* issue #100   */
-        master_bus()->play_and_flush(m_true_bus, &evout, midi_channel(ev));
+        send_on_bus(evout, midi_channel(ev));
+    }
+}
+
+/**
+ *  The playback counterpart of put_event_on_bus(), taking a compact record
+ *  and applying the transposition, if any.  It builds the outgoing event
+ *  directly from the record, without copying a full event first.
+ *
+ * \param r
+ *      The playback record, which is not SysEx or Meta.
+ *
+ * \param tick
+ *      The time-stamp for the outgoing event.  This is the current tick of
+ *      the performer, except in JACK pull mode, where it is the exact tick
+ *      of the event.
+ *
+ * \param transpose
+ *      The transposition to apply to note events.  Defaults to 0.
+ */
+
+void
+sequence::put_record_on_bus
+(
+    const playevents::record & r, midipulse tick, int transpose
+)
+{
+    midibyte note = r.d0();
+    bool skip = false;
+    if (transpose != 0 && r.is_note())              /* includes Aftertouch  */
+    {
+        int tnote = int(note) + transpose;
+        if (tnote >= 0 && tnote < c_midibyte_data_max)
+            note = midibyte(tnote);
+    }
+    if (r.is_note_on())
+    {
+        ++m_playing_notes[note];
+    }
+    else if (r.is_note_off())
+    {
+        if (m_playing_notes[note] == 0)
+            skip = true;
+        else
+            --m_playing_notes[note];
+    }
+    if (! skip)
+    {
+        midibyte channel = m_free_channel ? r.channel() : m_midi_channel ;
+        event evout(tick, r.status(), note, r.d1());
+        send_on_bus(evout, channel);
     }
 }
 
+/**
+ *  Sends an event to the buss of this pattern.  While the performer
+ *  renders offline (see performer::capture()), the events played by the
+ *  rendering thread are recorded instead, and no master buss is needed.
+ *  Otherwise, this function does not bother checking if m_master_bus is a
+ *  null pointer.
+ *
+ * \param ev
+ *      The event to send.
+ *
+ * \param channel
+ *      The channel on which to send the event.
+ *
+ * \param flush
+ *      If true (the default), the buss is flushed after the event.
+ */
+
+void
+sequence::send_on_bus (event & ev, midibyte channel, bool flush)
+{
+    midicapture * mc = is_nullptr(m_parent) ?
+        nullptr : m_parent->capturing() ;
+
+    if (not_nullptr(mc))
+        mc->add(m_true_bus, ev, channel);
+    else if (flush)
+        master_bus()->play_and_flush(m_true_bus, &ev, channel);
+    else
+        master_bus()->play(m_true_bus, &ev, channel);
+}
+
 /**
  *  Sends a note-off event for all active notes.  This function does not
  *  bother checking if m_master_bus is a null pointer.
@@ -7357,7 +7673,7 @@ sequence::off_playing_notes ()
         while (m_playing_notes[x] > 0)
         {
             e.set_data(x);
-            master_bus()->play(m_true_bus, &e, channel);
+            send_on_bus(e, channel, false);
             --m_playing_notes[x];
         }
     }
@@ -7705,6 +8021,8 @@ sequence::copy_events (const eventlist & newevents)
     bool result = false;
     m_events.clear();
     m_events = newevents;
+    m_play_events.invalidate();
+    invalidate_draw_snapshot();
     if (m_events.empty())
     {
         m_events.unmodify();
@@ -7849,6 +8167,82 @@ sequence::play_queue (midipulse tick, bool playbackmode, bool resumenoteons)
     }
 }
 
+/**
+ *  The non-blocking version of play_queue(), used by the JACK process
+ *  callback in pull mode.  If the pattern is locked (for example, while it
+ *  is being edited), it is skipped.  Since m_last_tick is not updated, the
+ *  events skipped are played in the next cycle, a little late, rather than
+ *  lost.
+ *
+ * \param tick
+ *      Provides the current active pulse position.
+ *
+ * \param playbackmode
+ *      If true, we are in Song mode.  Otherwise, Live mode.
+ *
+ * \param resumenoteons
+ *      Indicates if we are to resume Note Ons.
+ *
+ * \return
+ *      Returns true if the pattern was played.
+ */
+
+bool
+sequence::try_play_queue
+(
+    midipulse tick, bool playbackmode, bool resumenoteons
+)
+{
+    bool result = m_mutex.try_lock();
+    if (result)
+    {
+        if (m_wrap_pending.exchange(false))
+        {
+            stop(m_wrap_songmode);                      /* see try_loop_wrap */
+            set_last_tick(m_wrap_tick);
+        }
+        play_queue(tick, playbackmode, resumenoteons);  /* relocks; it's ok */
+        m_mutex.unlock();
+    }
+    return result;
+}
+
+/**
+ *  The non-blocking version of the stop() and set_last_tick() calls made
+ *  when playback wraps from the right loop marker to the left one.  Used by
+ *  the JACK process callback in pull mode.  If the pattern is locked, the
+ *  wrap is recorded, and is applied by the next try_play_queue() that gets
+ *  the lock, before the pattern plays.
+ *
+ * \param tick
+ *      The left tick, from which the pattern resumes.
+ *
+ * \param songmode
+ *      If true, we are in Song mode.  Otherwise, Live mode.
+ *
+ * \return
+ *      Returns true if the wrap was applied now, and false if deferred.
+ */
+
+bool
+sequence::try_loop_wrap (midipulse tick, bool songmode)
+{
+    bool result = m_mutex.try_lock();
+    if (result)
+    {
+        stop(songmode);
+        set_last_tick(tick);                            /* clears pending   */
+        m_mutex.unlock();
+    }
+    else
+    {
+        m_wrap_tick = tick;
+        m_wrap_songmode = songmode;
+        m_wrap_pending = true;
+    }
+    return result;
+}
+
 /**
  *  Actually, useful mainly for the user-interface, this function calculates
  *  the size of the left and right handles of a note.
@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-10-30
- * \updates       2022-10-03
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  Man, we need to learn a lot more about triggers.  One important thing to
@@ -371,8 +371,10 @@ triggers::play
     midipulse trigger_tick = 0;
     int tp = 0;
     transpose = 0;
-    for (auto & t : m_triggers)
+    for (auto ti = play_start(start_tick); ti != m_triggers.end(); ++ti)
     {
+        trigger & t = *ti;
+
         /*
          *  See the song_playback_block() function note in the banner.
          */
@@ -453,6 +455,40 @@ triggers::play
     return result;
 }
 
+/**
+ *  Finds the first trigger that play() needs to examine.  Triggers are
+ *  sorted by starting tick and do not overlap (see add()), so every trigger
+ *  before the last one starting at or before the given tick has already
+ *  ended.  Such triggers would only set the trigger state to "off", and that
+ *  state is overwritten by the trigger found here.  Skipping them with a
+ *  binary search makes song-mode playback independent of the number of
+ *  triggers in the song.
+ *
+ * \param tick
+ *      The start tick of the current frame.
+ *
+ * \return
+ *      Returns the iterator of the last trigger starting at or before the
+ *      tick, or the first trigger if there is none.
+ */
+
+triggers::container::iterator
+triggers::play_start (midipulse tick)
+{
+    auto result = std::upper_bound
+    (
+        m_triggers.begin(), m_triggers.end(), tick,
+        [] (midipulse t, const trigger & trig)
+        {
+            return t < trig.tick_start();
+        }
+    );
+    if (result != m_triggers.begin())
+        --result;
+
+    return result;
+}
+
 /**
  *  Adjusts the given offset by mod'ing it with m_length and adding
  *  m_length if needed, and returning the result.
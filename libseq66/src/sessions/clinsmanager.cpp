@@ -25,7 +25,7 @@
  * \library       clinsmanager application
  * \author        Chris Ahlstrom
  * \date          2020-08-31
- * \updates       2025-05-20
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  This object also works if there is no session manager in the build.  It
@@ -337,12 +337,29 @@ clinsmanager::save_session (std::string & msg, bool ok)
  *  This function is useful in the command-line version of the application.
  *  For the Qt version, see the qt5nsmanager class, which runs the Qt exec()
  *  function..
+ *
+ *  If "-o bounce=filename" was given, the song is rendered to that file
+ *  instead, and the function returns at once.  This allows batch rendering,
+ *  for example on a build server.
  */
 
 bool
 clinsmanager::run ()
 {
     bool result = false;
+    const std::string & bouncefile = usr().option_bounce();
+    if (! bouncefile.empty())
+    {
+        std::string errmsg;
+        if (not_nullptr(perf()))
+            result = perf()->bounce(bouncefile, errmsg);
+
+        if (! result)
+            file_error(errmsg.empty() ? "Render failed" : errmsg, bouncefile);
+
+        return result;
+    }
+
     session_setup();
     while (! session_close())
     {
@@ -356,6 +373,9 @@ clinsmanager::run ()
                 file_error(msg, "CLI");
             }
         }
+        if (session_report() && not_nullptr(perf()))
+            (void) perf()->write_timing_report();
+
         millisleep(m_poll_period_ms);
     }
     return true;
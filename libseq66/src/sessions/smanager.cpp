@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2020-03-22
- * \updates       2025-05-18
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  Note that this module is part of the libseq66 library, not the libsessions
@@ -450,7 +450,9 @@ smanager::main_settings (int argc, char * argv [])
  *          Most of this work is in the non-GUI-specific clinsmanager
  *          derived class.
  *      -#  create_performer().  This sets up the ports and launches the
- *          threads.
+ *          threads.  For an offline render ("-o bounce=file"), neither is
+ *          done, so that seq66cli can render with no ALSA sequencer or JACK
+ *          server; see performer::bounce().
  *      -#  open_playist().  If applicable.  Probably better as part of the
  *          session.
  *      -#  open_midi_file().  If applicable.  Probably better as part of the
@@ -482,15 +484,20 @@ smanager::create_performer ()
     {
         m_perf_pointer = std::move(p);              /* change the ownership */
         (void) perf()->get_settings(rc(), usr());
-        result = perf()->launch(ppqn);              // std::string perfmsgs;
-        if (result)
+        if (usr().option_bounce().empty() || ! seq_app_cli())
         {
-            // Anything to do?
+            result = perf()->launch(ppqn);          // std::string perfmsgs;
+            if (result)
+            {
+                // Anything to do?
+            }
+            else
+            {
+                errprint("performer launch failed");
+            }
         }
         else
-        {
-            errprint("performer launch failed");
-        }
+            session_message("Rendering, MIDI engine not started");
     }
     else
     {
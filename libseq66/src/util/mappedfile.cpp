@@ -0,0 +1,121 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          mappedfile.cpp
+ *
+ *  This module defines a read-only memory mapping of a whole file.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-15
+ * \updates       2026-10-15
+ * \license       GNU GPLv2 or above
+ *
+ *  See the mappedfile.hpp module for the rationale.
+ */
+
+#include "util/basic_macros.hpp"        /* support and platform macros      */
+#include "util/mappedfile.hpp"          /* seq66::mappedfile                */
+
+#if defined SEQ66_PLATFORM_POSIX_API
+#include <fcntl.h>                      /* ::open()                         */
+#include <sys/mman.h>                   /* ::mmap(), ::munmap()             */
+#include <sys/stat.h>                   /* ::fstat()                        */
+#include <unistd.h>                     /* ::close()                        */
+#endif
+
+namespace seq66
+{
+
+mappedfile::mappedfile () :
+    m_data  (nullptr),
+    m_size  (0)
+{
+    // no code
+}
+
+mappedfile::~mappedfile ()
+{
+    close();
+}
+
+/**
+ *  Maps the whole file.  The file descriptor is closed at once, since the
+ *  mapping keeps the file open.  The kernel is told that the file will be
+ *  read straight through, so that it reads ahead aggressively.
+ *
+ * \param filename
+ *      The full path to the file.
+ *
+ * \return
+ *      Returns true if the file is mapped.  An empty file is not mapped.
+ */
+
+bool
+mappedfile::open (const std::string & filename)
+{
+    bool result = false;
+    close();
+
+#if defined SEQ66_PLATFORM_POSIX_API
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd >= 0)
+    {
+        struct stat st;
+        if (::fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            std::size_t sz = std::size_t(st.st_size);
+            void * p = ::mmap(nullptr, sz, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED)
+            {
+                (void) ::posix_madvise(p, sz, POSIX_MADV_SEQUENTIAL);
+                m_data = static_cast<const midibyte *>(p);
+                m_size = sz;
+                result = true;
+            }
+        }
+        (void) ::close(fd);
+    }
+#else
+    (void) filename;
+#endif
+
+    return result;
+}
+
+void
+mappedfile::close ()
+{
+#if defined SEQ66_PLATFORM_POSIX_API
+    if (not_nullptr(m_data))
+        (void) ::munmap(const_cast<midibyte *>(m_data), m_size);
+#endif
+
+    m_data = nullptr;
+    m_size = 0;
+}
+
+}           // namespace seq66
+
+/*
+ * mappedfile.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
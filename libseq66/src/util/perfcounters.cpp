@@ -0,0 +1,300 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          perfcounters.cpp
+ *
+ *  This module defines the lock-free timing counters for the I/O threads.
+ *
+ * \library       seq66 application
+ * \author        Chris Ahlstrom
+ * \date          2026-10-15
+ * \updates       2026-10-15
+ * \license       GNU GPLv2 or above
+ *
+ *  See the perfcounters.hpp module for the rationale.
+ */
+
+#include <sstream>                      /* std::ostringstream               */
+
+#include "util/filefunctions.hpp"       /* seq66::file_append_log()         */
+#include "util/perfcounters.hpp"        /* seq66::perfcounters              */
+
+namespace seq66
+{
+
+/*
+ * -------------------------------------------------------------------------
+ *  timing_histogram
+ * -------------------------------------------------------------------------
+ */
+
+timing_histogram::timing_histogram () :
+    m_buckets   (),
+    m_count     (0),
+    m_total     (0),
+    m_maximum   (0)
+{
+    clear();
+}
+
+void
+timing_histogram::clear ()
+{
+    for (auto & b : m_buckets)
+        b.store(0, std::memory_order_relaxed);
+
+    m_count.store(0, std::memory_order_relaxed);
+    m_total.store(0, std::memory_order_relaxed);
+    m_maximum.store(0, std::memory_order_relaxed);
+}
+
+/**
+ *  Adds a value.  Negative values, such as a wakeup that comes a hair early,
+ *  count as 0.
+ *
+ * \param value
+ *      The value to add, usually in microseconds.
+ */
+
+void
+timing_histogram::add (long value)
+{
+    if (value < 0)
+        value = 0;
+
+    int index = 0;
+    for (long v = value; v > 0 && index < c_bucket_count - 1; v >>= 1)
+        ++index;
+
+    m_buckets[index].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_total.fetch_add(value, std::memory_order_relaxed);
+
+    long oldmax = m_maximum.load(std::memory_order_relaxed);
+    while (value > oldmax)
+    {
+        if (m_maximum.compare_exchange_weak(oldmax, value))
+            break;
+    }
+}
+
+double
+timing_histogram::mean () const
+{
+    unsigned n = count();
+    long long total = m_total.load(std::memory_order_relaxed);
+    return n > 0 ? double(total) / double(n) : 0.0 ;
+}
+
+/**
+ *  Shows the count, mean, and maximum on one line, and the non-empty buckets
+ *  on the next.  Each bucket is shown by its upper limit, e.g. "<4:" for the
+ *  values 2 and 3.
+ *
+ * \param name
+ *      The name of the histogram.
+ *
+ * \param unit
+ *      The unit of the values, such as "us".
+ *
+ * \return
+ *      Returns the two lines, or one line if nothing has been counted.
+ */
+
+std::string
+timing_histogram::report
+(
+    const std::string & name,
+    const std::string & unit
+) const
+{
+    std::ostringstream os;
+    os << name << " (" << unit << "): count " << count();
+    if (count() > 0)
+    {
+        os.setf(std::ios::fixed);
+        os.precision(1);
+        os << ", mean " << mean() << ", max " << maximum() << "\n   ";
+        for (int i = 0; i < c_bucket_count; ++i)
+        {
+            unsigned n = bucket(i);
+            if (n > 0)
+            {
+                if (i < c_bucket_count - 1)
+                    os << " <" << (1L << i) << ": " << n;
+                else
+                    os << " >=" << (1L << (i - 1)) << ": " << n;
+            }
+        }
+    }
+    os << "\n";
+    return os.str();
+}
+
+/*
+ * -------------------------------------------------------------------------
+ *  perfcounters
+ * -------------------------------------------------------------------------
+ */
+
+perfcounters::perfcounters () :
+    m_output_wake       (),
+    m_output_work       (),
+    m_cycle_events      (),
+    m_input_latency     (),
+    m_cycles            (0),
+    m_underruns         (0),
+    m_events            (0),
+    m_buss_events       (),
+    m_ring_max          (),
+    m_ring_dropped      ()
+{
+    clear();
+}
+
+void
+perfcounters::clear ()
+{
+    m_output_wake.clear();
+    m_output_work.clear();
+    m_cycle_events.clear();
+    m_input_latency.clear();
+    m_cycles.store(0, std::memory_order_relaxed);
+    m_underruns.store(0, std::memory_order_relaxed);
+    m_events.store(0, std::memory_order_relaxed);
+    for (int b = 0; b < c_busscount_max; ++b)
+    {
+        m_buss_events[b].store(0, std::memory_order_relaxed);
+        m_ring_max[b].store(0, std::memory_order_relaxed);
+        m_ring_dropped[b].store(0, std::memory_order_relaxed);
+    }
+}
+
+/**
+ *  Called by the output thread at the end of each cycle, before it sleeps.
+ *  The events counted since the previous call are charged to this cycle.
+ *  Events echoed by the input thread are counted too, which is good enough
+ *  for seeing how busy a cycle is.
+ *
+ * \param work_us
+ *      The time spent in the cycle, in microseconds.
+ */
+
+void
+perfcounters::end_output_cycle (long work_us)
+{
+    unsigned events = m_events.exchange(0, std::memory_order_relaxed);
+    m_cycle_events.add(long(events));
+    m_output_work.add(work_us);
+    m_cycles.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ *  Records the state of a ring-buffer.  Called by the producer, which owns
+ *  the high-water mark and the drop count of the ring, after each write.
+ *
+ * \param buss
+ *      The output buss that owns the ring.
+ *
+ * \param maxcount
+ *      The largest number of items held by the ring so far.
+ *
+ * \param dropped
+ *      The number of items refused because the ring was full.
+ */
+
+void
+perfcounters::ring_usage (int buss, int maxcount, int dropped)
+{
+    if (buss >= 0 && buss < c_busscount_max)
+    {
+        m_ring_max[buss].store(maxcount, std::memory_order_relaxed);
+        m_ring_dropped[buss].store(dropped, std::memory_order_relaxed);
+    }
+}
+
+/**
+ *  Builds a readable report of all counters.  Busses with no activity are
+ *  not shown.
+ */
+
+std::string
+perfcounters::report () const
+{
+    std::ostringstream os;
+    os
+        << "Output cycles: " << cycles()
+        << ", underruns: " << underruns() << "\n"
+        << m_output_wake.report("Output wake latency", "us")
+        << m_output_work.report("Output cycle work", "us")
+        << m_cycle_events.report("Events per cycle", "events")
+        << m_input_latency.report("Input latency", "us")
+        ;
+    for (int b = 0; b < c_busscount_max; ++b)
+    {
+        unsigned events = m_buss_events[b].load(std::memory_order_relaxed);
+        int ringmax = m_ring_max[b].load(std::memory_order_relaxed);
+        int dropped = m_ring_dropped[b].load(std::memory_order_relaxed);
+        if (events > 0 || ringmax > 0 || dropped > 0)
+        {
+            os
+                << "Buss " << b << ": events " << events
+                << ", ring high-water " << ringmax
+                << ", ring dropped " << dropped << "\n"
+                ;
+        }
+    }
+    return os.str();
+}
+
+/**
+ *  Appends the report, with a date/time stamp, to the given file.
+ */
+
+bool
+perfcounters::write_report (const std::string & filename) const
+{
+    return file_append_log(filename, report());
+}
+
+/*
+ * -------------------------------------------------------------------------
+ *  Free functions
+ * -------------------------------------------------------------------------
+ */
+
+/**
+ *  Provides the one set of counters for the application.
+ */
+
+perfcounters &
+perf_counters ()
+{
+    static perfcounters s_perf_counters;
+    return s_perf_counters;
+}
+
+}           // namespace seq66
+
+/*
+ * perfcounters.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
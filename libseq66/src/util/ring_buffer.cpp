@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2022-09-19
- * \updates       2023-12-08
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  A lock-free ring buffer.
@@ -111,7 +111,9 @@
 #include "util/ring_buffer.hpp"
 
 #if defined SEQ66_PLATFORM_DEBUG
+#include <chrono>                       /* std::chrono::steady_clock        */
 #include <iostream>
+#include <thread>                       /* std::thread for the benchmark    */
 #endif
 
 namespace seq66
@@ -232,7 +234,7 @@ run_ring_test ()
     {
         ring_test rt;
         sz = rb.read(rt);
-        if (sz > 0)
+        if (sz == 0)
         {
             show_error("ring_buffer::read() failed");
             result = false;
@@ -250,9 +252,9 @@ run_ring_test ()
     }
 
     /*
-     * Full buffer test. Ultimately 10 items entered. Only 8 should remain.
+     * Full buffer test. Ultimately 10 items offered. Only the first 8 are
+     * accepted; the producer cannot discard the consumer's front items.
      * Then we pop all items in the ring_buffer and show them.
-     * (Should compare counters at some point.)
      */
 
     if (result)
@@ -303,17 +305,20 @@ run_ring_test ()
     if (result)
     {
         /*
-         * Here, rt_a and rt_b should be dropped.
+         * Here, rt_i and rt_j should be refused.
          */
 
-        rb.push_back(rt_i);
-        rb.push_back(rt_j);
+        if (rb.push_back(rt_i) || rb.push_back(rt_j))
+        {
+            show_error("full ring_buffer accepted an object");
+            result = false;
+        }
 
         std::size_t rspace = rb.read_space();
         std::size_t wspace = rb.write_space();
         if (rb.count() != 8 || rspace != 8 || wspace != 0)
         {
-            show_error("objects not overwritten");
+            show_error("full ring_buffer changed");
             result = false;
         }
         if (rb.dropped() != 2)
@@ -329,7 +334,7 @@ run_ring_test ()
                 ring_test::cref item = rb.front();
                 std::string values = item.to_string();
                 printf("[%d] %s\n", i, values.c_str());
-                if (item.test_counter() != (i + 3))
+                if (item.test_counter() != (i + 1))
                     result = false;
 
                 rb.pop_front();
@@ -339,7 +344,7 @@ run_ring_test ()
 
             if (rb.empty())
             {
-                show_message("Should see rt_c through rt_j values");
+                show_message("Should see rt_a through rt_h values");
             }
             else
             {
@@ -396,6 +401,108 @@ run_ring_test ()
     return result;
 }
 
+/**
+ *  A throughput and ordering stress test.  One thread pushes increasing
+ *  sequence numbers, in single items and in batches, and the calling thread
+ *  pops them, checking that none is lost, repeated, or out of order.  This
+ *  exercises the acquire/release hand-off between the two indices.
+ *
+ * \param itemcount
+ *      The number of items to pass through a 1024-slot buffer.
+ *
+ * \return
+ *      Returns true if every item arrived in order.
+ */
+
+bool
+run_ring_benchmark (int itemcount)
+{
+    const int batchsize = 32;
+    ring_buffer<long> rb(1024);
+    bool locked = rb.mlock();
+    bool result = true;
+    auto start = std::chrono::steady_clock::now();
+    std::thread producer
+    (
+        [&rb, itemcount, batchsize] ()
+        {
+            long batch[batchsize];
+            long next = 0;
+            while (next < itemcount)
+            {
+                if ((next / batchsize) % 2 == 0)
+                {
+                    if (rb.write_space() > 0)
+                    {
+                        (void) rb.push_back(next);
+                        ++next;
+                    }
+                    else
+                        std::this_thread::yield();
+                }
+                else
+                {
+                    int n = 0;
+                    while (n < batchsize && next + n < itemcount)
+                    {
+                        batch[n] = next + n;
+                        ++n;
+                    }
+
+                    std::size_t space = rb.write_space();
+                    std::size_t count = std::size_t(n) < space ? n : space ;
+                    if (count > 0)
+                        next += long(rb.write(batch, count));
+                    else
+                        std::this_thread::yield();
+                }
+            }
+        }
+    );
+
+    long batch[batchsize];
+    long expected = 0;
+    while (expected < itemcount)        /* keep draining even after error */
+    {
+        std::size_t count = rb.read(batch, batchsize);
+        if (count == 0)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        for (std::size_t i = 0; i < count; ++i, ++expected)
+        {
+            if (result && batch[i] != expected)
+            {
+                std::cerr
+                    << "ring_buffer order error: got " << batch[i]
+                    << ", expected " << expected << std::endl
+                    ;
+                result = false;
+            }
+        }
+    }
+    producer.join();
+
+    auto stop = std::chrono::steady_clock::now();
+    double secs = std::chrono::duration<double>(stop - start).count();
+    if (secs > 0.0)
+    {
+        std::cout
+            << "ring_buffer: " << itemcount << " items in " << secs
+            << " s (" << (itemcount / secs / 1.0e6) << " M items/s), "
+            << "max count " << rb.count_max() << ", memory "
+            << (locked ? "locked" : "not locked") << std::endl
+            ;
+    }
+    if (rb.dropped() > 0)
+    {
+        show_error("ring_buffer dropped items in the benchmark");
+        result = false;
+    }
+    return result;
+}
+
 #endif
 
 }           // namespace seq66
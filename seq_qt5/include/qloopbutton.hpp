@@ -28,12 +28,14 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2019-06-28
- * \updates       2025-04-27
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  */
 
 #include <QFont>
+#include <QPixmap>
+#include <QRect>
 
 #include "qslotbutton.hpp"              /* seq66::qslotbutton base class    */
 
@@ -163,6 +165,20 @@ private:
     int m_note_min;
     int m_note_max;
 
+    /**
+     *  The notes (or fingerprint) of the pattern, drawn once into a pixmap
+     *  the size of the event box, and copied to the button on each paint.
+     *  Only the progress bar is drawn anew.  The pixmap is redrawn when the
+     *  sequence::draw_version() changes, or when the event box, the length,
+     *  or the transposability of the pattern changes.
+     */
+
+    QPixmap m_thumbnail;
+    QRect m_thumbnail_box;
+    unsigned m_thumbnail_version;
+    midipulse m_thumbnail_length;
+    bool m_thumbnail_transposable;
+
     /**
      *  Provides a pointer to the sequence displayed by this button.  Note that
      *  we do not want to use a shared pointer.  First, semantically this button
@@ -269,6 +285,9 @@ protected:
     void draw_progress (QPainter & p, midipulse tick, bool tiny = false);
     void draw_progress_box (QPainter & painter);
     void draw_pattern (QPainter & painter);
+    void paint_pattern (QPainter & painter);
+    bool thumbnail_stale () const;
+    void update_thumbnail ();
     void initialize_fingerprint ();
 
 private:
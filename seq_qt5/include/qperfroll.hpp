@@ -28,15 +28,18 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-01-01
- * \updates       2025-06-15
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  This class represents the central piano-roll user-interface area of the
  *  performance/song editor.
  */
 
+#include <map>                          /* std::map<> for note strips       */
+#include <QPixmap>
 #include <QWidget>
 
+#include "play/seq.hpp"                 /* seq66::seq::number and pointer   */
 #include "qperfbase.hpp"                /* seq66::qperfbase base class      */
 
 /*
@@ -63,6 +66,46 @@ class qperfroll final : public QWidget, public qperfbase
 
     Q_OBJECT
 
+private:
+
+    /**
+     *  One repetition of the notes of a pattern, drawn at the current zoom
+     *  and track height.  The strip is copied to each repetition inside each
+     *  trigger, instead of walking the events again for each one.  The
+     *  strip is redrawn when the pattern's sequence::draw_version(), length,
+     *  or transposability changes, or when the zoom or track height changes.
+     */
+
+    class note_strip
+    {
+        friend class qperfroll;
+
+    private:
+
+        const sequence * ns_seq;    /* the pattern the strip was drawn for  */
+        unsigned ns_version;        /* its draw_version() at that time      */
+        midipulse ns_length;        /* its length at that time              */
+        int ns_width;               /* the pixel width of one repetition    */
+        int ns_height;              /* the track height                     */
+        bool ns_transposable;       /* chooses the note color               */
+        QPixmap ns_pixmap;          /* the rendered notes                   */
+
+    public:
+
+        note_strip () :
+            ns_seq          (nullptr),
+            ns_version      (0),
+            ns_length       (0),
+            ns_width        (0),
+            ns_height       (0),
+            ns_transposable (false),
+            ns_pixmap       ()
+        {
+            // no code
+        }
+
+    };          // class note_strip
+
 public:
 
     qperfroll
@@ -98,6 +141,14 @@ private:
     int seq_id_from_xy (int /*click_x*/, int click_y);
     void draw_grid (QPainter & painter, const QRect & r);
     void draw_triggers (QPainter & painter, const QRect & r);
+    const QPixmap * get_note_strip
+    (
+        seq::number seqid, sequence & s, int lenw
+    );
+    void paint_notes
+    (
+        QPainter & painter, sequence & s, int x0, int y0, int lenw
+    );
 
     void resize ()
     {
@@ -182,6 +233,12 @@ private:
     QLinearGradient m_back_grad;
     QLinearGradient m_sel_grad;
 
+    /**
+     *  The note strips of the patterns, indexed by pattern number.
+     */
+
+    std::map<seq::number, note_strip> m_note_strips;
+
     QTimer * m_timer;
     QFont m_font;
     int m_trigger_transpose;
@@ -25,12 +25,15 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-05-30
- * \updates       2026-05-09
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  */
 
+#include <QShowEvent>                   /* QShowEvent                       */
+
 #include "cfg/cmdlineopts.hpp"          /* for build info function          */
+#include "util/perfcounters.hpp"        /* seq66::perf_counters()           */
 #include "qsbuildinfo.hpp"              /* seq66::qsbuildinfo dialog class  */
 #include "qt5_helpers.hpp"              /* seq66::qt() string conversion    */
 #include "ui_qsbuildinfo.h"
@@ -61,6 +64,21 @@ qsbuildinfo::~qsbuildinfo ()
     delete ui;
 }
 
+/**
+ *  Each time the dialog is shown, the timing counters (see the perfcounters
+ *  module) are appended to the build details, so that they are current.
+ */
+
+void
+qsbuildinfo::showEvent (QShowEvent * event)
+{
+    std::string text = seq_build_details();
+    text += "\nTiming:\n\n";
+    text += perf_counters().report();
+    ui->buildInfoTextEdit->setPlainText(qt(text));
+    QDialog::showEvent(event);
+}
+
 }               // namespace seq66
 
 /*
@@ -28,13 +28,15 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-05-30
- * \updates       2018-05-30
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  */
 
 #include <QDialog>
 
+class QShowEvent;
+
 namespace Ui
 {
    class qsbuildinfo;
@@ -52,6 +54,10 @@ public:
     explicit qsbuildinfo (QWidget * parent = nullptr);
     virtual ~qsbuildinfo ();
 
+protected:
+
+    virtual void showEvent (QShowEvent *) override;
+
 private:
 
     Ui::qsbuildinfo * ui;
@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-01-01
- * \updates       2026-05-18
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  The main window is known as the "Patterns window" or "Patterns panel".  It
@@ -261,6 +261,7 @@ qsmainwnd::qsmainwnd
     m_beatwidth_list        (beatwidth_items()),     /* see settings module */
     m_beats_per_bar_list    (beats_per_bar_items()), /* ditto               */
     m_main_bpm              (0.0),
+    m_showing_clock_bpm     (false),
     m_control_status        (automation::ctrlstatus::none),
     m_song_mode             (false),
     m_is_looping            (false),
@@ -2128,6 +2129,9 @@ qsmainwnd::conditional_update ()
     if (session_save())
         (void) save_session();
 
+    if (session_report())
+        (void) cb_perf().write_timing_report();
+
     int active_screenset = int(cb_perf().playscreen_number());
     std::string b = "#";
     b += std::to_string(active_screenset);
@@ -2189,6 +2193,29 @@ qsmainwnd::conditional_update ()
     }
     if (cb_perf().tap_bpm_timeout())
         set_tap_button(0);
+
+    /*
+     * While following an external MIDI clock, show its estimated tempo.
+     * The spin-box is made read-only, since the master sets the tempo, and
+     * the song tempo is shown again when the clock stops.
+     */
+
+    midibpm clockbpm = cb_perf().midi_clock_bpm();
+    if (clockbpm > 0.0)
+    {
+        if (! m_showing_clock_bpm)
+        {
+            m_showing_clock_bpm = true;
+            ui->spinBpm->setReadOnly(true);
+        }
+        set_beats_per_minute(clockbpm, true);
+    }
+    else if (m_showing_clock_bpm)
+    {
+        m_showing_clock_bpm = false;
+        ui->spinBpm->setReadOnly(false);
+        set_beats_per_minute(cb_perf().bpm(), true);
+    }
 }
 
 /**
@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-01-01
- * \updates       2025-07-19
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  The main window is known as the "Patterns window" or "Patterns panel".  It
@@ -360,6 +360,13 @@ private:
 
     midibpm m_main_bpm;
 
+    /**
+     *  True while the BPM spin-box shows the tempo estimated from an
+     *  external MIDI clock, rather than the tempo of the song.
+     */
+
+    bool m_showing_clock_bpm;
+
     /**
      *  Holds the last value of the MIDI-control-in status, used in displaying
      *  the current status when it changed.
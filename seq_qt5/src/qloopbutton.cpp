@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2019-06-28
- * \updates       2025-06-03
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  A paint event is a request to repaint all/part of a widget. It happens for
@@ -191,6 +191,11 @@ qloopbutton::qloopbutton
     m_fingerprint_count     (m_fingerprint_size),
     m_note_min              (usr().progress_note_min()),
     m_note_max              (usr().progress_note_max()),
+    m_thumbnail             (),
+    m_thumbnail_box         (),
+    m_thumbnail_version     (0),
+    m_thumbnail_length      (0),
+    m_thumbnail_transposable(false),
     m_seq                   (seqp),                 /* loop()               */
     m_is_checked            (loop()->armed()),
     m_is_flat               (false),
@@ -433,14 +438,10 @@ qloopbutton::initialize_fingerprint ()
                 m_fingerprint[i] = m_fingerprint_count[i] = 0;
 
             int nh = n1 - n0;
-            loop()->draw_lock();
-            for (auto cev = loop()->cbegin(); ! loop()->cend(cev); ++cev)
+            sequence::draw_snapshot_ptr notes = loop()->get_draw_snapshot();
+            for (const auto & dn : *notes)
             {
-                sequence::note_info ni;
-                sequence::draw dt = loop()->get_next_note(ni, cev);
-                if (dt == sequence::draw::finish)
-                    break;
-
+                const sequence::note_info & ni = dn.info();
                 int x = x0 + (ni.start() * xw) / t1;
                 int y = y0 + yh * (ni.note() - n0) / nh;
                 int i = i1 * (x - x0) / xw;
@@ -457,7 +458,6 @@ qloopbutton::initialize_fingerprint ()
                 else
                     m_fingerprint[i] = midishort(y);
             }
-            loop()->draw_unlock();
             for (int i = 0; i < i1; ++i)
             {
                 if (m_fingerprint_count[i] > 1)
@@ -718,7 +718,6 @@ qloopbutton::paintEvent (QPaintEvent * pev)
                 );
                 painter.drawText(box, m_top_left.m_flags, title);
             }
-            initialize_fingerprint();
         }
         if (sm_draw_progress_box)
             draw_progress_box(painter);
@@ -902,8 +901,83 @@ qloopbutton::draw_progress_box (QPainter & painter)
 }
 
 /**
- *  Draws the progress box, progress bar, and and indicator for non-empty
- *  pattern slots.  Two style of drawing are done:
+ *  Draws the pattern events by copying the cached thumbnail to the event
+ *  box, after redrawing the thumbnail if the pattern has changed.  With
+ *  hundreds of busy patterns, the live grid repaints every button at the
+ *  redraw rate, and walking all of the notes each time is far too costly.
+ */
+
+void
+qloopbutton::draw_pattern (QPainter & painter)
+{
+    if (thumbnail_stale())
+        update_thumbnail();
+
+    if (! m_thumbnail.isNull())
+        painter.drawPixmap(m_event_box.x(), m_event_box.y(), m_thumbnail);
+}
+
+/**
+ *  Checks the cheap change indicators of the pattern and the event box
+ *  against those saved with the thumbnail.
+ */
+
+bool
+qloopbutton::thumbnail_stale () const
+{
+    QRect box
+    (
+        m_event_box.x(), m_event_box.y(), m_event_box.w(), m_event_box.h()
+    );
+    return
+        m_thumbnail.isNull() ||
+        box != m_thumbnail_box ||
+        loop()->draw_version() != m_thumbnail_version ||
+        loop()->get_length() != m_thumbnail_length ||
+        loop()->transposable() != m_thumbnail_transposable;
+}
+
+/**
+ *  Redraws the thumbnail.  The version is read before the events are, so
+ *  that a change made while drawing causes another redraw at the next
+ *  paint.  The fingerprint, which depends on the events and the event box,
+ *  is recalculated as well.  The painter is translated so that
+ *  paint_pattern() can keep using the event-box coordinates.
+ */
+
+void
+qloopbutton::update_thumbnail ()
+{
+    int x0 = m_event_box.x();
+    int y0 = m_event_box.y();
+    int xw = m_event_box.w();
+    int yh = m_event_box.h();
+    m_thumbnail_box = QRect(x0, y0, xw, yh);
+    m_thumbnail_version = loop()->draw_version();
+    m_thumbnail_length = loop()->get_length();
+    m_thumbnail_transposable = loop()->transposable();
+    if (xw > 0 && yh > 0)
+    {
+        qreal ratio = devicePixelRatioF();
+        QPixmap pm(QSize(xw, yh) * ratio);
+        pm.setDevicePixelRatio(ratio);
+        pm.fill(Qt::transparent);
+        m_fingerprint_inited = m_fingerprinted = false;
+        initialize_fingerprint();
+
+        QPainter painter(&pm);
+        painter.translate(-x0, -y0);
+        paint_pattern(painter);
+        painter.end();
+        m_thumbnail = pm;
+    }
+    else
+        m_thumbnail = QPixmap();
+}
+
+/**
+ *  Draws the pattern events for the thumbnail.  Two style of drawing are
+ *  done:
  *
  *      -   If sequence::event_threshold() is true, then the calculated
  *          number of measures is greater than 4.  We don't need to draw the
@@ -912,7 +986,7 @@ qloopbutton::draw_progress_box (QPainter & painter)
  */
 
 void
-qloopbutton::draw_pattern (QPainter & painter)
+qloopbutton::paint_pattern (QPainter & painter)
 {
     midipulse t1 = loop()->get_length();
     if (loop()->event_count() > 0 && t1 > 0)
@@ -978,13 +1052,11 @@ qloopbutton::draw_pattern (QPainter & painter)
                 pen.setColor(drum_color());
 
             painter.setPen(pen);
-            loop()->draw_lock();
-            for (auto cev = loop()->cbegin(); ! loop()->cend(cev); ++cev)
+            sequence::draw_snapshot_ptr notes = loop()->get_draw_snapshot();
+            for (const auto & dn : *notes)
             {
-                sequence::note_info ni;
-                sequence::draw dt = loop()->get_next_note(ni, cev);
-                if (dt == sequence::draw::finish)
-                    break;
+                sequence::draw dt = dn.type();
+                const sequence::note_info & ni = dn.info();
 
                 int tick_s_x = (ni.start() * xw) / t1;
                 int sx = x0 + tick_s_x;                /* start x          */
@@ -1033,7 +1105,6 @@ qloopbutton::draw_pattern (QPainter & painter)
                     }
                 }
             }
-            loop()->draw_unlock();
         }
     }
 }
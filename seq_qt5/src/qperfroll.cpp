@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-01-01
- * \updates       2026-05-02
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  This class represents the central piano-roll user-interface area of the
@@ -37,6 +37,8 @@
  *  handle.  That is, if moving or growing, snap the tick.
  */
 
+#include <algorithm>                    /* std::min()                       */
+
 #include <QKeyEvent>
 #include <QMouseEvent>
 #include <QPainter>
@@ -71,6 +73,13 @@ static const int c_pen_width        = 2;
 static const int c_size_box_w       = 8;
 static const int c_size_box_click_w = c_size_box_w + 1 ;
 
+/**
+ *  The widest note strip that is cached.  A long pattern zoomed far in is
+ *  drawn directly instead, to avoid huge pixmaps.
+ */
+
+static const int c_note_strip_max   = 8192;
+
 #if defined THIS_CODE_ADDS_VALUE
 static const int c_background_x     = (c_base_ppqn * 4 * 16) / c_perf_scale_x;
 static const int c_border_width     = 2;
@@ -105,6 +114,7 @@ qperfroll::qperfroll
     m_perf_names        (seqnames),
     m_back_grad         (0, 0, 0, 1),
     m_sel_grad          (0, 0, 0, 1),
+    m_note_strips       (),
     m_timer             (nullptr),
     m_font              ("Monospace"),
     m_trigger_transpose (0),
@@ -181,7 +191,7 @@ qperfroll::follow_progress ()
  */
 
 void
-qperfroll::paintEvent (QPaintEvent * /*qpep*/)
+qperfroll::paintEvent (QPaintEvent * qpep)
 {
     QPainter painter(this);
     QRect r(0, 0, width(), height());
@@ -195,7 +205,7 @@ qperfroll::paintEvent (QPaintEvent * /*qpep*/)
         set_initialized();
 
     draw_grid(painter, r);
-    draw_triggers(painter, r);
+    draw_triggers(painter, qpep->rect());       /* only the exposed area    */
 
     /*
      * Draw selections, if applicable.  Currently, only one box can be selected.
@@ -1078,11 +1088,21 @@ qperfroll::draw_grid (QPainter & painter, const QRect & r)
     painter.drawLine(x_pos, 0, x_pos, yheight);
 }
 
+/**
+ *  Draws the triggers that intersect the given rectangle, normally the area
+ *  exposed by the scroll area.  Only the tracks in that rectangle are
+ *  examined, and a binary search (see triggers::play_start()) skips the
+ *  triggers that end before it.  The notes of each trigger repetition are
+ *  copied from the pattern's note strip.
+ */
+
 void
 qperfroll::draw_triggers (QPainter & painter, const QRect & r)
 {
-    int y_s = 0;
-    int y_f = r.height() / track_height();
+    int y_s = r.top() / track_height();
+    int y_f = (r.bottom() + 1) / track_height();
+    midipulse tick_s = z().pix_to_tix(r.left());
+    midipulse tick_f = z().pix_to_tix(r.right() + 1);
     int cbw = c_size_box_w;                     /* copied for readability   */
     QBrush brush(Qt::NoBrush);
     QPen pen(fore_color());
@@ -1124,10 +1144,13 @@ qperfroll::draw_triggers (QPainter & painter, const QRect & r)
             int cbwoffset = cbw + h / 2 - 2;
             trigger trig;
             painter.setFont(m_font);
-            s->reset_draw_trigger_marker();
+            s->reset_draw_trigger_marker(tick_s);
             while (s->next_trigger(trig))               /* side-effect      */
             {
-                if (trig.tick_end() > 0)
+                if (trig.tick_start() > tick_f)
+                    break;                              /* past the window  */
+
+                if (trig.tick_end() >= tick_s && trig.tick_end() > 0)
                 {
                     int x_on = z().tix_to_pix(trig.tick_start());
                     int x_off = z().tix_to_pix(trig.tick_end());
@@ -1221,76 +1244,153 @@ qperfroll::draw_triggers (QPainter & painter, const QRect & r)
                         painter.drawText(tx, y + cbwoffset, temp);
                     }
 
+                    if (lens <= 0)
+                        continue;
+
+                    /*
+                     * Skip the repetitions that end before the window, and
+                     * stop at the first one that starts after it.
+                     */
+
                     midipulse t = trig.trigger_marker(lens);    /* offset   */
-                    while (t < trig.tick_end())
+                    midipulse tend = std::min(trig.tick_end(), tick_f);
+                    if (t + lens < tick_s)
+                        t += ((tick_s - t) / lens) * lens;
+
+                    const QPixmap * strip = get_note_strip(seqid, *s, lenw);
+                    painter.save();
+                    painter.setClipRect(x, y, xmax - x + 1, h + 2);
+                    while (t < tend)
                     {
-                        int note0, note1;
-                        (void) s->minmax_notes(note0, note1);
-
-                        int height = note1 - note0;
-                        height += 2;
-                        if (s->transposable())
-                            pen.setColor(fore_color());
+                        int marker_x = z().tix_to_pix(t);
+                        if (not_nullptr(strip))
+                            painter.drawPixmap(marker_x, y, *strip);
                         else
-                            pen.setColor(drum_color());
+                            paint_notes(painter, *s, marker_x, y, lenw);
 
-                        painter.setPen(pen);
-
-                        int cny = track_height() - 6;
-                        int marker_x = z().tix_to_pix(t);
-                        for (auto cev = s->cbegin(); ! s->cend(cev); ++cev)
-                        {
-                            sequence::note_info ni;
-                            sequence::draw dt = s->get_next_note(ni, cev);
-                            if (dt == sequence::draw::finish)
-                                break;
-
-                            midipulse tick_s = ni.start();
-                            int sx = tick_s * lenw / lens + marker_x;
-                            if (dt == sequence::draw::tempo)
-                            {
-                                midibpm max = usr().midi_bpm_maximum();
-                                midibpm min = usr().midi_bpm_minimum();
-                                double tempo = double(ni.velocity());
-                                int yt = int(cny * (max-tempo) / (max-min)) + y;
-                                if (sx < x)
-                                    sx = x;
-
-                                if (sx <= xmax)
-                                    painter.drawEllipse(sx, yt, 3, 3);
-                            }
-                            else
-                            {
-                                midipulse tick_f = ni.finish();
-                                int note_y =
-                                (
-                                    cny - (cny * (ni.note() - note0)) / height
-                                ) + 1 + y;
-                                int fx = tick_f * lenw / lens + marker_x;
-                                if (sequence::is_draw_note_onoff(dt))
-                                    fx = sx + 1;
-
-                                if (fx <= sx)
-                                    fx = sx + 1;
-
-                                if (sx < x)
-                                    sx = x;
-
-                                if (fx > xmax)
-                                    fx = xmax;
-
-                                if (fx >= x && sx <= xmax)
-                                    painter.drawLine(sx, note_y, fx, note_y);
-                            }
-                        }
                         t += lens;
                     }
+                    painter.restore();
                 }
             }
         }
     }
 }
 
+/**
+ *  Gets the note strip of a pattern, redrawing it if it is stale.
+ *
+ * \param seqid
+ *      The pattern number, used as the key to the strip.
+ *
+ * \param s
+ *      The pattern.
+ *
+ * \param lenw
+ *      The width of one repetition of the pattern at the current zoom.
+ *
+ * \return
+ *      Returns a pointer to the pixmap, or a null pointer if the strip
+ *      would be too wide (or narrow) to cache.  In that case the caller
+ *      draws the notes directly.
+ */
+
+const QPixmap *
+qperfroll::get_note_strip (seq::number seqid, sequence & s, int lenw)
+{
+    const QPixmap * result = nullptr;
+    if (lenw > 0 && lenw <= c_note_strip_max)
+    {
+        note_strip & ns = m_note_strips[seqid];
+        unsigned version = s.draw_version();    /* read before the events   */
+        bool stale =
+            ns.ns_seq != &s || ns.ns_version != version ||
+            ns.ns_length != s.get_length() || ns.ns_width != lenw ||
+            ns.ns_height != track_height() ||
+            ns.ns_transposable != s.transposable() ||
+            ns.ns_pixmap.isNull();
+
+        if (stale)
+        {
+            qreal ratio = devicePixelRatioF();
+            QPixmap pm(QSize(lenw + 1, track_height()) * ratio);
+            pm.setDevicePixelRatio(ratio);
+            pm.fill(Qt::transparent);
+
+            QPainter painter(&pm);
+            paint_notes(painter, s, 0, 0, lenw);
+            painter.end();
+            ns.ns_seq = &s;
+            ns.ns_version = version;
+            ns.ns_length = s.get_length();
+            ns.ns_width = lenw;
+            ns.ns_height = track_height();
+            ns.ns_transposable = s.transposable();
+            ns.ns_pixmap = pm;
+        }
+        result = &ns.ns_pixmap;
+    }
+    return result;
+}
+
+/**
+ *  Draws one repetition of the notes of a pattern, with the top-left corner
+ *  at the given position.  The notes are not clipped to the trigger here;
+ *  the caller sets a clipping rectangle.
+ */
+
+void
+qperfroll::paint_notes
+(
+    QPainter & painter, sequence & s, int x0, int y0, int lenw
+)
+{
+    midipulse lens = s.get_length();
+    if (lens <= 0)
+        return;
+
+    int note0, note1;
+    (void) s.minmax_notes(note0, note1);
+
+    int height = note1 - note0;
+    height += 2;
+
+    QPen pen(s.transposable() ? fore_color() : drum_color());
+    pen.setStyle(Qt::SolidLine);
+    pen.setWidth(1);
+    painter.setPen(pen);
+    painter.setBrush(Qt::NoBrush);
+
+    int cny = track_height() - 6;
+    sequence::draw_snapshot_ptr notes = s.get_draw_snapshot();
+    for (const auto & dn : *notes)
+    {
+        sequence::draw dt = dn.type();
+        const sequence::note_info & ni = dn.info();
+        int sx = ni.start() * lenw / lens + x0;
+        if (dt == sequence::draw::tempo)
+        {
+            midibpm max = usr().midi_bpm_maximum();
+            midibpm min = usr().midi_bpm_minimum();
+            double tempo = double(ni.velocity());
+            int yt = int(cny * (max - tempo) / (max - min)) + y0;
+            painter.drawEllipse(sx, yt, 3, 3);
+        }
+        else
+        {
+            int note_y =
+            (
+                cny - (cny * (ni.note() - note0)) / height
+            ) + 1 + y0;
+            int fx = ni.finish() * lenw / lens + x0;
+            if (sequence::is_draw_note_onoff(dt) || fx <= sx)
+                fx = sx + 1;
+
+            painter.drawLine(sx, note_y, fx, note_y);
+        }
+    }
+}
+
 }           // namespace seq66
 
 /*
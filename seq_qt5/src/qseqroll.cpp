@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2018-01-01
- * \updates       2026-05-02
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  Please see the additional notes for the Gtkmm-2.4 version of this panel,
@@ -752,13 +752,11 @@ qseqroll::draw_notes
         return;
 
     int noteheight = unit_height() - 2;     /* was "- 3"    */
-    s->draw_lock();
-    for (auto cev = s->cbegin(); ! s->cend(cev); ++cev)
+    sequence::draw_snapshot_ptr notes = s->get_draw_snapshot();
+    for (const auto & dn : *notes)
     {
-        sequence::note_info ni;
-        sequence::draw dt = s->get_next_note(ni, cev);
-        if (dt == sequence::draw::finish)
-            break;
+        sequence::draw dt = dn.type();
+        const sequence::note_info & ni = dn.info();
 
         if (ni.non_note())
             continue;
@@ -912,7 +910,6 @@ qseqroll::draw_notes
             }
         }
     }
-    s->draw_unlock();
 }
 
 /**
@@ -1012,13 +1009,11 @@ qseqroll::draw_ghost_notes
      *      painter.drawRect(x0, y0 + 1, wbox, hbox);
      */
 
-    track().draw_lock();
-    for (auto cev = track().cbegin(); ! track().cend(cev); ++cev)
+    sequence::draw_snapshot_ptr notes = track().get_draw_snapshot();
+    for (const auto & dn : *notes)
     {
-        sequence::note_info ninfo;
-        sequence::draw dt = track().get_next_note(ninfo, cev);
-        if (dt == sequence::draw::finish)
-            break;
+        sequence::draw dt = dn.type();
+        const sequence::note_info & ninfo = dn.info();
 
         if (ninfo.selected())
         {
@@ -1036,7 +1031,6 @@ qseqroll::draw_ghost_notes
             }
         }
     }
-    track().draw_unlock();
 }
 
 /*
@@ -1122,13 +1116,11 @@ qseqroll::draw_drum_notes
     if (is_nullptr(s))
         return;
 
-    s->draw_lock();
-    for (auto cev = s->cbegin(); ! s->cend(cev); ++cev)
+    sequence::draw_snapshot_ptr notes = s->get_draw_snapshot();
+    for (const auto & dn : *notes)
     {
-        sequence::note_info ni;
-        sequence::draw dt = s->get_next_note(ni, cev);
-        if (dt == sequence::draw::finish)
-            break;
+        sequence::draw dt = dn.type();
+        const sequence::note_info & ni = dn.info();
 
         if (ni.non_note())
             continue;
@@ -1156,7 +1148,6 @@ qseqroll::draw_drum_notes
             draw_drum_note(painter, m_note_x, m_note_y);
         }
     }
-    s->draw_unlock();
 }
 
 /**
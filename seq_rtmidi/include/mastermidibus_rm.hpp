@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-07-24
- * \updates       2024-04-30
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  This mastermidibus module is the Linux (and, soon, JACK) version of the
@@ -107,6 +107,11 @@ protected:
         midi_master().api_flush();
     }
 
+    virtual bool api_set_engine (engine_callback f, void * arg) override
+    {
+        return midi_master().api_set_engine(f, arg);
+    }
+
     /* virtual */
     void api_port_start (mastermidibus & masterbus, int bus, int port)
     {
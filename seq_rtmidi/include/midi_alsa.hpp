@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2016-12-18
- * \updates       2022-06-02
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  The midi_alsa module is the Linux version of the midi_alsa module.
@@ -35,7 +35,10 @@
  *  for both classes.
  */
 
+#include <memory>                       /* std::unique_ptr<>                */
+
 #include "seq66-config.h"               /* SEQ66_HAVE_LIBASOUND             */
+#include "midi/sysexsender.hpp"         /* seq66::sysexsender               */
 #include "midi_api.hpp"
 
 #if SEQ66_HAVE_LIBASOUND
@@ -99,6 +102,52 @@ private:
 
     const std::string m_port_name;
 
+    /**
+     *  The ALSA queue used for scheduled output, or -1 if events are sent
+     *  directly.  See rcsettings::alsa_queue_lookahead().
+     */
+
+    const int m_out_queue;
+
+    /**
+     *  The relative real-time at which scheduled output events are stamped
+     *  on the queue.  Unused in direct mode.
+     */
+
+    snd_seq_real_time_t m_lookahead;
+
+    /**
+     *  The lookahead in nanoseconds, added to the time at which an event is
+     *  due to get its absolute stamp.  See set_timing().
+     */
+
+    const long long m_lookahead_ns;
+
+    /**
+     *  The real time of the queue minus the monotonic time, and when it was
+     *  last measured, or 0 if it is not measured.  See sync_queue_clock().
+     *  Used by the output thread only.
+     */
+
+    long long m_queue_offset_ns;
+    long long m_queue_synced_ns;
+
+    /**
+     *  A persistent MIDI-bytes encoder, allocated on first use, for the rare
+     *  output messages that api_play() does not convert directly.  This
+     *  avoids allocating and freeing an encoder for every event.
+     */
+
+    snd_midi_event_t * m_encoder;
+
+    /**
+     *  Sends the large SysEx messages of this port in paced chunks, from
+     *  a thread of its own, so that the caller does not wait.  Created when
+     *  the output port is opened.  See rcsettings::alsa_sysex_rate().
+     */
+
+    std::unique_ptr<sysexsender> m_sysex_sender;
+
 public:
 
     /*
@@ -154,18 +203,34 @@ protected:
 
     virtual bool api_connect () override;
     virtual void api_play (const event * e24, midibyte channel) override;
+    virtual void api_play_at
+    (
+        const event * e24, midibyte channel, long long ns
+    ) override;
     virtual void api_sysex (const event * e24) override;
     virtual void api_flush () override;
     virtual void api_continue_from (midipulse tick, midipulse beats) override;
     virtual void api_start () override;
     virtual void api_stop () override;
     virtual void api_clock (midipulse tick) override;
+    virtual void api_clock_at (midipulse tick, long long ns) override;
     virtual void api_set_ppqn (int ppqn) override;
     virtual void api_set_beats_per_minute (midibpm bpm) override;
 
 private:
 
     bool set_virtual_name (int portid, const std::string & portname);
+    void set_timing (snd_seq_event_t & ev, long long ns = 0);
+    void sync_queue_clock (long long now);
+    bool encode_event (snd_seq_event_t & ev, const midibyte * buffer);
+    bool send_sysex (const midibyte * data, int count);
+    void start_sysex_sender ();
+    void remove_queued_on_events (int tag);
+
+    bool scheduled () const
+    {
+        return m_out_queue >= 0;
+    }
 
 };          // class midi_alsa
 
@@ -197,6 +262,15 @@ public:
 
 };          // class midi_out_alsa
 
+/*
+ * Free functions in the seq66 namespace
+ */
+
+extern bool alsa_encode_channel_event
+(
+    snd_seq_event_t & ev, const midibyte * buffer
+);
+
 }           // namespace seq66
 
 #endif      // SEQ66_MIDI_ALSA_HPP
@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Gary P. Scavone; modifications by Chris Ahlstrom
  * \date          2016-11-14
- * \updates       2022-03-13
+ * \updates       2026-10-15
  * \license       See above.
  *
  *  Declares the following classes:
@@ -156,6 +156,25 @@ public:
     virtual void api_set_ppqn (int ppqn) = 0;
     virtual void api_set_beats_per_minute (midibpm bpm) = 0;
 
+    /**
+     *  Plays an event, or emits a clock, due at the given monotonic time,
+     *  which is 0 if not known.  Only midi_alsa, when it schedules its
+     *  output on a queue, uses the time.
+     */
+
+    virtual void api_play_at
+    (
+        const event * e24, midibyte channel, long long /* ns */
+    )
+    {
+        api_play(e24, channel);
+    }
+
+    virtual void api_clock_at (midipulse tick, long long /* ns */)
+    {
+        api_clock(tick);
+    }
+
     /*
      * The next two functions are provisional.  Currently useful only in the
      * midi_jack module.
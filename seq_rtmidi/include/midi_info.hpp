@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2016-12-05
- * \updates       2022-06-15
+ * \updates       2026-10-15
  * \license       See above.
  *
  *  We need to have a way to get all of the API information from each
@@ -54,6 +54,7 @@
  *  An alternate name for this class could be "midi_master".  :-)
  */
 
+#include "midi/midibus_common.hpp"      /* seq66::engine_callback           */
 #include "rterror.hpp"                  /* seq66::rterror exception class   */
 #include "rtmidi_types.hpp"             /* seq66::rtmidi_api, midi_message  */
 
@@ -527,6 +528,15 @@ public:
         return true;
     }
 
+    /**
+     *  Installs the pull-mode callback.  Only JACK supports it.
+     */
+
+    virtual bool api_set_engine (engine_callback /* f */, void * /* arg */)
+    {
+        return false;
+    }
+
     virtual int get_port_count () const
     {
         const midi_port_info & mpi = const_midi_port_info();
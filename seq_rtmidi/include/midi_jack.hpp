@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Gary P. Scavone; severe refactoring by Chris Ahlstrom
  * \date          2016-11-14
- * \updates       2026-05-09
+ * \updates       2026-10-15
  * \license       See above.
  *
  *    In this refactoring, we've stripped out most of the original RtMidi
@@ -166,6 +166,7 @@ protected:
     void close_client ();
     void close_port ();
     bool create_ringbuffer (size_t rbsize);
+    bool create_sysex_buffer ();
     bool connect_port
     (
         midibase::io iotype,
@@ -238,6 +239,14 @@ protected:
 
     std::string m_client_name;
 
+    /**
+     *  Receives the bytes of an incoming SysEx message from the port's SysEx
+     *  buffer.  It is used by the input thread, not the JACK callback, and
+     *  grows to fit the longest message seen.
+     */
+
+    midibytes m_sysex_buffer;
+
 public:
 
     midi_in_jack (midibus & parentbus, midi_info & masterinfo);
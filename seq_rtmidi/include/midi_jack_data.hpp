@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2017-01-02
- * \updates       2022-11-22
+ * \updates       2026-10-15
  * \license       See above.
  *
  *  GitHub issue #165: enabled a build and run with no JACK support.
@@ -42,10 +42,11 @@
 
 #include <jack/jack.h>
 
+#include <jack/ringbuffer.h>            /* jack_ringbuffer_t for SysEx      */
+#include <vector>                       /* std::vector<> for pull mode      */
+
 #if defined SEQ66_USE_MIDI_MESSAGE_RINGBUFFER
 #include "util/ring_buffer.hpp"         /* seq66::ring_buffer<> template    */
-#else
-#include <jack/ringbuffer.h>
 #endif
 
 namespace seq66
@@ -109,6 +110,27 @@ class midi_jack_data
     jack_ringbuffer_t * m_jack_buffmessage;
 #endif
 
+    /**
+     *  Holds the bytes of long (SysEx) messages, which are too big for a
+     *  midi_message.  The midi_message in the ring-buffer (output) or the
+     *  input queue holds only the size and status byte, and the bytes are
+     *  read from here in the same order.  This buffer is allocated when the
+     *  port is set up, so the JACK process callback never allocates.
+     */
+
+    jack_ringbuffer_t * m_jack_sysex;
+
+    /**
+     *  In pull mode, the events played in the current JACK process cycle.
+     *  Each time-stamp holds the frame offset in the cycle.  The events of
+     *  different patterns arrive out of time order, so they are collected
+     *  here, sorted, and then written to the port buffer.  Only the process
+     *  callback touches this list, and its capacity is reserved when the
+     *  port is set up.
+     */
+
+    std::vector<midi_message> m_jack_cycle;
+
     /**
      *  The last time-stamp obtained.  Use for calculating the delta time, I
      *  would imagine.
@@ -355,6 +377,21 @@ public:
     }
 #endif
 
+    jack_ringbuffer_t * jack_sysex ()
+    {
+        return m_jack_sysex;
+    }
+
+    void jack_sysex (jack_ringbuffer_t * jrb)
+    {
+        m_jack_sysex = jrb;
+    }
+
+    std::vector<midi_message> & jack_cycle ()
+    {
+        return m_jack_cycle;
+    }
+
     jack_time_t jack_lasttime () const
     {
         return m_jack_lasttime;
@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2017-01-01
- * \updates       2023-12-08
+ * \updates       2026-10-15
  * \license       See above.
  *
  *    We need to have a way to get all of the JACK information of
@@ -40,6 +40,7 @@
 
 #if SEQ66_JACK_SUPPORT
 
+#include <atomic>                       /* std::atomic<> for pull callback  */
 #include <jack/jack.h>                  /* JACK (2) API                     */
 
 #include "midi_info.hpp"                /* seq66::midi_port_info etc.       */
@@ -117,6 +118,24 @@ private:
 
     jack_nframes_t m_jack_sample_rate;
 
+    /**
+     *  An eventfd (Linux only) written by the JACK process callback when MIDI
+     *  input arrives, so that the input thread can block in poll() instead
+     *  of sleeping and re-checking every port.  Set to -1 if unavailable.
+     */
+
+    int m_input_fd;
+
+    /**
+     *  The pull-mode callback and its argument (the performer), set by
+     *  api_set_engine().  If not null, the JACK process callback calls it at
+     *  the start of each cycle, so that the patterns are played right in the
+     *  process callback.  See performer::pull_cycle().
+     */
+
+    std::atomic<engine_callback> m_engine;
+    std::atomic<void *> m_engine_arg;
+
 public:
 
     midi_jack_info () = delete;
@@ -147,6 +166,7 @@ public:
     virtual int api_poll_for_midi () override;
     virtual void api_set_ppqn (int p) override;
     virtual void api_set_beats_per_minute (midibpm b) override;
+    virtual bool api_set_engine (engine_callback f, void * arg) override;
     virtual void api_port_start
     (
         mastermidibus & masterbus,
@@ -186,6 +206,8 @@ private:
 
     jack_client_t * connect ();
     void disconnect ();
+    void signal_input ();
+    bool run_engine (jack_nframes_t nframes, engine_cycle & cycle);
     void extract_names
     (
         const std::string & fullname,
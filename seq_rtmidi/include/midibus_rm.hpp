@@ -28,7 +28,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2016-11-21
- * \updates       2025-04-30
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  This midibus module is the RtMidi version of the midibus
@@ -122,7 +122,12 @@ protected:
     virtual void api_start () override;
     virtual void api_stop () override;
     virtual void api_clock (midipulse tick) override;
+    virtual void api_clock_at (midipulse tick, long long ns) override;
     virtual void api_play (const event * e24, midibyte channel) override;
+    virtual void api_play_at
+    (
+        const event * e24, midibyte channel, long long ns
+    ) override;
     virtual void api_sysex (const event * e24) override;
 
 };          // class midibus (rtmidi version)
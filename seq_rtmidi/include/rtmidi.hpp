@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Gary P. Scavone; refactoring by Chris Ahlstrom
  * \date          2016-11-14
- * \updates       2025-01-20
+ * \updates       2026-10-15
  * \license       See above.
  *
  *  The big difference between this class (seq66::rtmidi) and
@@ -89,6 +89,14 @@ public:
         get_api()->api_play(e24, channel);
     }
 
+    virtual void api_play_at
+    (
+        const event * e24, midibyte channel, long long ns
+    ) override
+    {
+        get_api()->api_play_at(e24, channel, ns);
+    }
+
     virtual void api_continue_from (midipulse tick, midipulse beats) override
     {
         get_api()->api_continue_from(tick, beats);
@@ -109,6 +117,11 @@ public:
         get_api()->api_clock(tick);
     }
 
+    virtual void api_clock_at (midipulse tick, long long ns) override
+    {
+        get_api()->api_clock_at(tick, ns);
+    }
+
     virtual void api_set_ppqn (int ppqn) override
     {
         get_api()->api_set_ppqn(ppqn);
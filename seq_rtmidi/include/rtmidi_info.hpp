@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Refactoring by Chris Ahlstrom
  * \date          2016-12-08
- * \updates       2022-03-26
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  This class is like the rtmidi_in and rtmidi_out classes, but cut down to
@@ -303,6 +303,11 @@ public:
         return get_api_info()->api_poll_for_midi();
     }
 
+    bool api_set_engine (engine_callback f, void * arg)
+    {
+        return get_api_info()->api_set_engine(f, arg);
+    }
+
     static rtmidi_api & selected_api ()
     {
         return sm_selected_api;
@@ -27,7 +27,7 @@
  * \library       seq66 application
  * \author        Gary P. Scavone; severe refactoring by Chris Ahlstrom
  * \date          2016-11-20
- * \updates       2023-12-03
+ * \updates       2026-10-15
  * \license       See above.
  *
  *  The lack of hiding of these types within a class is a little to be
@@ -120,7 +120,15 @@ api_to_int (rtmidi_api api)
 }
 
 /**
- *  Provides a handy capsule for a MIDI message, based on the
+ *  The number of status and data bytes that a midi_message holds in place.
+ *  This covers the channel messages and the system common and realtime
+ *  messages.
+ */
+
+const int c_midi_message_bytes = 3;
+
+/**
+ *  Provides a handy capsule for a MIDI message, originally based on the
  *  std::vector<unsigned char> data type from the RtMidi project.
  *
  *  For issue #100, we add the timestamp (in units of MIDI ticks, also
@@ -139,22 +147,19 @@ api_to_int (rtmidi_api api)
  *  uses the seq66::event rather than the seq66::midi_message object.
  *  For the moment, we will translate between them until we have the
  *  interactions between the old and new modules under control.
+ *
+ *  The status and data bytes are held in a small in-place array rather than
+ *  a vector, so that the object is trivially copyable:  creating one in
+ *  api_play() or in the JACK input callback, and copying it into and out of
+ *  a ring-buffer, never calls the allocator.  A message longer than the
+ *  array (SysEx) holds only its size and status byte here; the caller
+ *  moves its bytes through a separate, pre-allocated byte buffer (see
+ *  midi_jack_data::jack_sysex()).
  */
 
 class midi_message
 {
 
-public:
-
-    /**
-     *  Holds the data of the MIDI message.  Callers should use
-     *  midi_message::container rather than using the vector directly.
-     *  Bytes are added by the push() function, and are safely accessed
-     *  (with bounds-checking) by operator [].
-     */
-
-    using container = std::vector<midibyte>;
-
 private:
 
 #if defined SEQ66_SHOW_TIMING
@@ -181,12 +186,6 @@ private:
 
 #endif
 
-    /**
-     *  Holds the event status and data bytes.
-     */
-
-    container m_bytes;
-
     /**
      *  Holds the timestamp of the MIDI message. Non-zero only in the JACK
      *  implementation at present.  It can also hold a JACK frame number. The
@@ -195,6 +194,19 @@ private:
 
     midipulse m_timestamp;
 
+    /**
+     *  The full size of the message.  If greater than c_midi_message_bytes,
+     *  only the status byte is held in m_bytes, and the message is "long".
+     */
+
+    int m_size;
+
+    /**
+     *  Holds the event status and data bytes.
+     */
+
+    midibyte m_bytes[c_midi_message_bytes];
+
     /**
      *  Holds the ID number of the input MIDI buss on which the message
      *  was received. Note that this is an index number. Starts out
@@ -214,13 +226,13 @@ public:
     midibyte & operator [] (std::size_t i)
     {
         static midibyte s_zero = 0;
-        return (i < m_bytes.size()) ? m_bytes[i] : s_zero ;
+        return (int(i) < inline_count()) ? m_bytes[i] : s_zero ;
     }
 
     const midibyte & operator [] (std::size_t i) const
     {
         static midibyte s_zero = 0;
-        return (i < m_bytes.size()) ? m_bytes[i] : s_zero ;
+        return (int(i) < inline_count()) ? m_bytes[i] : s_zero ;
     }
 
     const char * buffer () const                // was "array"
@@ -230,7 +242,7 @@ public:
 
     const midibyte * event_bytes () const       // bypasses timestamp
     {
-        return m_bytes.data();
+        return &m_bytes[0];
     }
 
 #if defined SEQ66_SHOW_TIMING
@@ -257,14 +269,56 @@ public:
         return event_count() == 0;
     }
 
+    /**
+     *  The full size of the message, including the bytes of a long message
+     *  that are not held here.
+     */
+
     int event_count () const                    // was "count"
     {
-        return int(m_bytes.size());
+        return m_size;
+    }
+
+    /**
+     *  The number of bytes actually held by event_bytes().
+     */
+
+    int inline_count () const
+    {
+        return is_long() ? 1 : m_size ;
     }
 
-    void push (midibyte b)
+    bool is_long () const
+    {
+        return m_size > c_midi_message_bytes;
+    }
+
+    /**
+     *  Appends a byte to a short message.
+     *
+     * \return
+     *      Returns false if the message is full, in which case the caller
+     *      should have used long_message() instead.
+     */
+
+    bool push (midibyte b)
+    {
+        bool result = m_size < c_midi_message_bytes;
+        if (result)
+            m_bytes[m_size++] = b;
+
+        return result;
+    }
+
+    /**
+     *  Marks the message as a long one of the given size.  The caller is
+     *  responsible for passing the bytes along separately.
+     */
+
+    void long_message (midibyte status, int sz)
     {
-        m_bytes.push_back(b);
+        m_bytes[0] = status;
+        m_size = sz;
     }
 
     midipulse timestamp () const
@@ -289,12 +343,12 @@ public:
 
     midibyte status () const
     {
-        return event_count() > 0 ? m_bytes[0] : 0 ;
+        return m_size > 0 ? m_bytes[0] : 0 ;
     }
 
     bool is_sysex () const
     {
-        return m_bytes.size() > 0 ? event::is_sysex_msg(m_bytes[0]) : false ;
+        return m_size > 0 ? event::is_sysex_msg(m_bytes[0]) : false ;
     }
 
     std::string to_string () const;
@@ -306,8 +360,8 @@ private:
 /**
  *  MIDI caller callback function type definition.  Used to be nested in the
  *  rtmidi_in class.  The timestamp parameter has been folded into the
- *  midi_message class (a wrapper for std::vector<unsigned char>), and the
- *  pointer has been replaced by a reference.
+ *  midi_message class (originally a wrapper for std::vector<unsigned char>),
+ *  and the pointer has been replaced by a reference.
  */
 
 using rtmidi_callback_t = void (*)
@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2015-07-24
- * \updates       2024-06-04
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  This file provides a Windows-only implementation of the mastermidibus
@@ -253,19 +253,23 @@ mastermidibus::activate ()
 }
 
 /**
- *  Initiate a poll() on the existing poll descriptors.  This is a
- *  primitive poll, which exits when some data is obtained, or sleeps a
- *  millisecond in note data is obtained.
+ *  Initiate a poll() on the existing poll descriptors.  This poll blocks
+ *  until some data is obtained, or a short timeout (10 ms) elapses so that
+ *  the input thread can check for exit.
  *
- *  For JACK polling, call the base-class implementation:
+ *  For JACK polling, first check the input-port queues without waiting:
  *
- *      -   mastermidibase::api_poll_for_midi()
  *      -   busarray::poll_for_midi()
  *      -   businfo::poll_for_midi()
  *      -   midibus::poll_for_midi() [midibase::poll_for_midi()]
  *      -   midibase::api_poll_for_midi(), a virtual function overridden
  *          for JACK (and ALSA).
  *
+ *  If nothing is queued, wait in midi_jack_info::api_poll_for_midi() for the
+ *  JACK process callback to signal new input, then check the queues again.
+ *  This replaces the old 10 us sleep, which woke an idle Seq66 about
+ *  100,000 times a second.
+ *
  *  Otherwise, the call sequence is:
  *
  *      -   rtmidi_info::api_poll_for_midi()
@@ -286,7 +290,13 @@ mastermidibus::api_poll_for_midi ()
 {
 #if defined SEQ66_USE_JACK_POLLING_FLAG
     if (m_use_jack_polling)                             /* --jack-midi set  */
-        return mastermidibase::api_poll_for_midi();     /* inbus-array poll */
+    {
+        int result = m_inbus_array.poll_for_midi();     /* inbus-array poll */
+        if (result == 0 && midi_master().api_poll_for_midi() > 0)
+            result = m_inbus_array.poll_for_midi();     /* JACK signalled   */
+
+        return result;
+    }
     else
         return midi_master().api_poll_for_midi();       /* ALSA poll        */
 #else
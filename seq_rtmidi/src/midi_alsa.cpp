@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2016-12-18
- * \updates       2025-08-10
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  This file provides a Linux-only implementation of ALSA MIDI support.
@@ -111,6 +111,7 @@
 
 #include "cfg/settings.hpp"             /* seq66::rc()                      */
 #include "midi/event.hpp"               /* seq66::event (MIDI event)        */
+#include "os/timing.hpp"                /* seq66::nanotime()                */
 #include "midibus_rm.hpp"               /* seq66::midibus for rtmidi        */
 #include "midi_alsa.hpp"                /* seq66::midi_alsa for ALSA        */
 #include "midi_info.hpp"                /* seq66::midi_info                 */
@@ -166,8 +167,21 @@ midi_alsa::midi_alsa (midibus & parentbus, midi_info & masterinfo) :
     m_dest_addr_client  (parentbus.bus_id()),
     m_dest_addr_port    (parentbus.port_id()),
     m_local_addr_client (snd_seq_client_id(m_seq)),     /* our client ID    */
-    m_local_addr_port   (-1)
+    m_local_addr_port   (-1),
+    m_out_queue
+    (
+        rc().alsa_queue_scheduling() ? masterinfo.global_queue() : (-1)
+    ),
+    m_lookahead         (),
+    m_lookahead_ns      (rc().alsa_queue_lookahead() * 1000000LL),
+    m_queue_offset_ns   (0),
+    m_queue_synced_ns   (0),
+    m_encoder           (nullptr),
+    m_sysex_sender      ()
 {
+    int us = rc().alsa_queue_lookahead() * 1000;
+    m_lookahead.tv_sec = 0;
+    m_lookahead.tv_nsec = unsigned(us) * 1000;
     set_client_id(m_local_addr_client);
     set_name(SEQ66_CLIENT_NAME, bus_name(), port_name());
 #if defined SEQ66_SHOW_BUS_VALUES
@@ -176,12 +190,15 @@ midi_alsa::midi_alsa (midibus & parentbus, midi_info & masterinfo) :
 }
 
 /**
- *  A rote empty virtual destructor.
+ *  Stops the SysEx thread first, since it calls back into this object, and
+ *  frees the fallback encoder, if it was ever needed.
  */
 
 midi_alsa::~midi_alsa ()
 {
-    // empty body
+    m_sysex_sender.reset();
+    if (not_nullptr(m_encoder))
+        snd_midi_event_free(m_encoder);
 }
 
 /**
@@ -238,8 +255,10 @@ midi_alsa::api_init_out ()
         return false;
     }
     else
+    {
         set_port_open();
-
+        start_sysex_sender();
+    }
     return true;
 }
 
@@ -394,6 +413,7 @@ midi_alsa::api_init_out_sub ()
     {
         set_virtual_name(result, portname);
         set_port_open();
+        start_sysex_sender();
     }
     return true;
 }
@@ -529,11 +549,125 @@ midi_alsa::api_connect ()
 
 static const size_t s_event_size_max =  12;
 
+/**
+ *  The furthest past the lookahead that an absolute stamp may lie.  A later
+ *  time means that the ticks jumped without the pulse clock being told, and
+ *  the event is sent at the lookahead instead.
+ */
+
+static const long long c_stamp_ahead_max_ns = 1000000000LL;
+
+/**
+ *  How often the offset of the queue clock from the monotonic clock is
+ *  measured again, to follow any drift between the two.
+ */
+
+static const long long c_queue_sync_ns = 1000000000LL;
+
+/**
+ *  Sets the delivery of an output event.  In the default (direct) mode, the
+ *  event bypasses the ALSA queue and goes out as soon as it is drained.
+ *
+ *  In queue-scheduling mode, the event is stamped on the global queue with
+ *  a real time.  If the monotonic time at which its pulse is due is known
+ *  (see pulseclock and midibase::commit()), the stamp is that time plus the
+ *  lookahead, converted to the clock of the queue.  The output thread then
+ *  only has to be ahead of the kernel timer, which alone decides when the
+ *  event goes out, so the jitter of its wakeups does not reach the output.
+ *  Otherwise, as for MIDI thru or the user interface, the event is stamped
+ *  at the lookahead relative to the moment it reaches the sequencer.  A
+ *  real-time stamp is used, rather than a tick stamp, so that changes of
+ *  tempo and beat width, and jumps, need no handling in the queue.
+ *
+ * \param ev
+ *      The event whose direct/scheduled status is to be set.
+ *
+ * \param ns
+ *      The monotonic time at which the event is due, or 0 if not known.
+ */
+
+void
+midi_alsa::set_timing (snd_seq_event_t & ev, long long ns)
+{
+    if (scheduled())
+    {
+        bool absolute = false;
+        if (ns > 0)
+        {
+            long long now = nanotime();
+            long long due = ns + m_lookahead_ns;
+            if (due < now + m_lookahead_ns + c_stamp_ahead_max_ns)
+            {
+                if (now - m_queue_synced_ns >= c_queue_sync_ns)
+                    sync_queue_clock(now);
+
+                if (m_queue_synced_ns > 0)
+                {
+                    if (due < now)
+                        due = now;                  /* late: send it now    */
+
+                    due += m_queue_offset_ns;       /* to the queue clock   */
+                    snd_seq_real_time_t rt;
+                    rt.tv_sec = unsigned(due / 1000000000LL);
+                    rt.tv_nsec = unsigned(due % 1000000000LL);
+                    snd_seq_ev_schedule_real(&ev, m_out_queue, 0, &rt);
+                    absolute = true;
+                }
+            }
+        }
+        if (! absolute)
+            snd_seq_ev_schedule_real(&ev, m_out_queue, 1, &m_lookahead);
+    }
+    else
+        snd_seq_ev_set_direct(&ev);
+}
+
+/**
+ *  Measures the offset of the real time of the queue from the monotonic
+ *  clock.  The queue is started at the start of the application, and runs
+ *  on the system timer, so this changes only by drift.  On failure, the
+ *  offset is left unmeasured, and the events keep their relative stamps.
+ *
+ * \param now
+ *      The monotonic time, just taken.
+ */
+
+void
+midi_alsa::sync_queue_clock (long long now)
+{
+    snd_seq_queue_status_t * status;
+    snd_seq_queue_status_alloca(&status);
+    if (snd_seq_get_queue_status(m_seq, m_out_queue, status) == 0)
+    {
+        const snd_seq_real_time_t * rt =
+            snd_seq_queue_status_get_real_time(status);
+
+        long long qns = rt->tv_sec * 1000000000LL + rt->tv_nsec;
+        long long after = nanotime();
+        m_queue_offset_ns = qns - (now + after) / 2;
+        m_queue_synced_ns = after;
+    }
+    else
+        m_queue_synced_ns = 0;
+}
+
+/**
+ *  Plays an event as soon as possible, or at the lookahead in
+ *  queue-scheduling mode.  See api_play_at().
+ */
+
+void
+midi_alsa::api_play (const event * e24, midibyte channel)
+{
+    api_play_at(e24, channel, 0);
+}
+
 /**
  *  This play() function takes a native event, encodes it to an ALSA MIDI
  *  sequencer event, sets the broadcasting to the subscribers, sets the
- *  direct-passing mode to send the event without queueing, and puts it in the
- *  queue.
+ *  direct-passing or scheduled mode (see set_timing()), and puts it in the
+ *  queue.  The event tag is left at 0, so that pending Note Ons can be
+ *  removed when playback stops.
  *
  * \threadsafe
  *
@@ -545,129 +679,206 @@ static const size_t s_event_size_max =  12;
  *      The channel of the playback.  This channel is either the global MIDI
  *      channel of the sequence, or the channel of the event.  Either way, we
  *      mask it into the event status.
+ *
+ * \param ns
+ *      The monotonic time at which the pulse of the event is due, or 0.
  */
 
 void
-midi_alsa::api_play (const event * e24, midibyte channel)
+midi_alsa::api_play_at (const event * e24, midibyte channel, long long ns)
 {
     if (parent_bus().port_enabled())
     {
-        snd_midi_event_t * midi_ev;                         /* MIDI parser  */
-        int rc = snd_midi_event_new(s_event_size_max, &midi_ev);
-        if (rc == 0)
+        snd_seq_event_t ev;                                 /* event memory */
+        midibyte buffer[4];                                 /* temp data    */
+        buffer[0] = e24->get_status(channel);               /* status+chan  */
+        e24->get_data(buffer[1], buffer[2]);                /* set the data */
+        snd_seq_ev_clear(&ev);                              /* clear event  */
+        if (encode_event(ev, buffer))
         {
-            snd_seq_event_t ev;                             /* event memory */
-            midibyte buffer[4];                             /* temp data    */
-            buffer[0] = e24->get_status(channel);           /* status+chan  */
-            e24->get_data(buffer[1], buffer[2]);            /* set the data */
-            snd_seq_ev_clear(&ev);                          /* clear event  */
-            snd_midi_event_encode(midi_ev, buffer, 3, &ev); /* 3 raw bytes  */
-            snd_midi_event_free(midi_ev);                   /* free parser  */
             snd_seq_ev_set_source(&ev, m_local_addr_port);  /* set source   */
             snd_seq_ev_set_subs(&ev);                       /* subscriber   */
-            snd_seq_ev_set_direct(&ev);                     /* immediate    */
+            set_timing(ev, ns);                             /* now or queue */
             snd_seq_event_output(m_seq, &ev);               /* pump to que  */
         }
-        else
-        {
-            errprint("ALSA out-of-memory");
-        }
     }
 }
 
 /**
- *  min() for long values.
+ *  Converts the raw status and data bytes of a channel message directly to
+ *  the ALSA sequencer event, which is all that snd_midi_event_encode() does
+ *  for these messages, but without creating an encoder or running its byte
+ *  parser.  Any other status falls back to a single encoder that is kept
+ *  for the life of the port.
  *
- * \param a
- *      First operand.
+ * \param [out] ev
+ *      The cleared ALSA event to be filled in.
  *
- * \param b
- *      Second operand.
+ * \param buffer
+ *      Provides the status byte (with channel) and two data bytes.
  *
  * \return
- *      Returns the minimum value of a and b.
+ *      Returns true if the event was filled in and can be sent.
  */
 
-inline long
-min (long a, long b)
+bool
+midi_alsa::encode_event (snd_seq_event_t & ev, const midibyte * buffer)
 {
-    return (a < b) ? a : b ;
+    bool result = alsa_encode_channel_event(ev, buffer);
+    if (! result)
+    {
+        if (is_nullptr(m_encoder))
+        {
+            int rc = snd_midi_event_new(s_event_size_max, &m_encoder);
+            if (rc != 0)
+            {
+                m_encoder = nullptr;
+                errprint("ALSA out-of-memory");
+            }
+        }
+        if (not_nullptr(m_encoder))
+        {
+            snd_midi_event_reset_encode(m_encoder);
+            result = snd_midi_event_encode(m_encoder, buffer, 3, &ev) > 0;
+        }
+    }
+    return result;
 }
 
 /**
- *  Defines the value used for sleeping, in microseconds.  Defined locally
- *  simply for visibility.  Why 80000?
+ *  SysEx messages of this size or larger are handed to the sysexsender of
+ *  the port, which sends them in chunks of this size, paced to
+ *  rcsettings::alsa_sysex_rate().
+ */
+
+static const int c_sysex_chunk = 256;
+
+/**
+ *  ALSA copies a variable-length event, such as SysEx, into a scratch
+ *  buffer of the sequencer handle, which all ports share.  The callers of
+ *  api_sysex() and the SysEx threads of the ports thus take turns with this
+ *  lock.  Other events do not use the buffer, so api_play() needs no lock.
  */
 
-static const int c_sysex_sleep_us   = 80000;
-static const int c_sysex_chunk      =   256;
+static recmutex s_sysex_mutex;
 
 /**
- *  Takes a native SYSEX event, encodes it to an ALSA event, and then
- *  puts it in the queue.
+ *  Sends SysEx bytes to the subscribers of the port.  In queue-scheduling
+ *  mode, they are stamped at the lookahead like any other event not
+ *  played by the output thread (see set_timing()).  Sending them directly
+ *  would put them ahead of the notes queued before them.  The chunks of a
+ *  large message get increasing stamps, and so stay in order.
  *
- * \param e24
- *      The event to be handled.
+ * \param data
+ *      The bytes, which are a whole message or a chunk of one.
+ *
+ * \param count
+ *      The number of bytes.
+ *
+ * \return
+ *      Returns true if ALSA accepted the bytes.
  */
 
-void
-midi_alsa::api_sysex (const event * e24)
+bool
+midi_alsa::send_sysex (const midibyte * data, int count)
 {
     snd_seq_event_t ev;
     snd_seq_ev_clear(&ev);                              /* clear event      */
     snd_seq_ev_set_priority(&ev, 1);
     snd_seq_ev_set_subs(&ev);
-    snd_seq_ev_set_direct(&ev);                         /* it's immediate   */
+    set_timing(ev);                                     /* now or queued    */
     snd_seq_ev_set_source(&ev, m_local_addr_port);      /* set source       */
+    snd_seq_ev_set_sysex(&ev, count, const_cast<midibyte *>(data));
 
-    /*
-     *  Replaced by a vector of midibytes:
-     *
-     *      midibyte * data = e24->get_sysex();
-     *
-     *  This tack relies on the standard property of std::vector, where all n
-     *  elements of the vector are guaranteed to be stored contiguously (in
-     *  order to be accessible via random-access iterators).
-     *
-     *  We send the sysex data in chunks, with a sleep, for slower devices.
-     */
+    automutex locker(s_sysex_mutex);
+    return snd_seq_event_output_direct(m_seq, &ev) >= 0;
+}
 
-    event::sysex & data = const_cast<event::sysex &>(e24->get_sysex());
-    int data_size = e24->sysex_size();
-    if (data_size < c_sysex_chunk)
+/**
+ *  Creates the sysexsender of an output port.  This is done when the port
+ *  is opened, rather than on the first large message, which during
+ *  playback would start a thread on the output thread.
+ *
+ *  Completion is only logged: a finished dump is reported when verbose,
+ *  an abandoned one always.
+ */
+
+void
+midi_alsa::start_sysex_sender ()
+{
+    if (! m_sysex_sender)
     {
-        snd_seq_ev_set_sysex(&ev, data_size, &data[0]);
+        m_sysex_sender = std::make_unique<sysexsender>
+        (
+            [this] (const midibyte * d, int n)
+            {
+                bool ok = send_sysex(d, n);
+                if (! ok)
+                    errprint("Sending SysEx failed");
+
+                return ok;
+            },
+            c_sysex_chunk, rc().alsa_sysex_rate(),
+            [] (unsigned id, bool ok)
+            {
+                std::string msg = "SysEx dump ";
+                msg += std::to_string(id);
+                if (! ok)
+                {
+                    msg += " abandoned";
+                    errprint(msg);
+                }
+                else if (rc().verbose())
+                {
+                    msg += " sent";
+                    infoprint(msg);
+                }
+            }
+        );
+    }
+}
+
+/**
+ *  Takes a native SYSEX event, encodes it to an ALSA event, and sends it.
+ *
+ *  Large messages are sent in chunks, with a pause after each, for slower
+ *  devices.  That used to be done here, with a sleep of 80 ms per chunk,
+ *  which stalled the output thread when a pattern held a patch dump.  Now
+ *  the message is queued to the sysexsender of the port, and this function
+ *  returns at once.  While the sender is busy, small messages are queued
+ *  too, so that all SysEx goes out in order.  A port that was never opened
+ *  for output has no sender, and sends the message whole.
+ *
+ * \param e24
+ *      The event to be handled.
+ */
 
-        int rc = snd_seq_event_output_direct(m_seq, &ev);
-        if (rc >= 0)
+void
+midi_alsa::api_sysex (const event * e24)
+{
+    const event::sysex & data = e24->get_sysex();
+    int data_size = e24->sysex_size();
+    if (data_size > 0)
+    {
+        bool paced = bool(m_sysex_sender);
+        bool busy = paced && m_sysex_sender->pending() > 0;
+        if (paced && (busy || data_size >= c_sysex_chunk))
         {
-            api_flush();
+            unsigned id = m_sysex_sender->send(data);
+            if (rc().verbose())
+            {
+                std::string msg = "SysEx dump ";
+                msg += std::to_string(id);
+                msg += " queued";
+                infoprint(msg);
+            }
         }
         else
         {
-            errprint("Sending complete SysEx failed");
-        }
-    }
-    else
-    {
-        for (int offset = 0; offset < data_size; offset += c_sysex_chunk)
-        {
-            int data_left = data_size - offset;
-            snd_seq_ev_set_sysex
-            (
-                &ev, min(data_left, c_sysex_chunk), &data[offset]
-            );
-
-            int rc = snd_seq_event_output_direct(m_seq, &ev);
-            if (rc >= 0)
-            {
-                usleep(c_sysex_sleep_us);
+            if (send_sysex(data.data(), data_size))
                 api_flush();
-            }
             else
-            {
-                errprint("Sending SysEx failed");
-            }
+                errprint("Sending complete SysEx failed");
         }
     }
 }
@@ -717,8 +928,8 @@ midi_alsa::api_continue_from (midipulse /* tick */, midipulse beats)
         snd_seq_ev_set_subs(&evc);
         snd_seq_ev_set_source(&ev, m_local_addr_port);
         snd_seq_ev_set_subs(&ev);
-        snd_seq_ev_set_direct(&ev);                     /* it's immediate   */
-        snd_seq_ev_set_direct(&evc);
+        set_timing(ev);                                 /* now or queued    */
+        set_timing(evc);
         snd_seq_event_output(m_seq, &evc);              /* pump into queue  */
         api_flush();
         snd_seq_event_output(m_seq, &ev);
@@ -742,13 +953,15 @@ midi_alsa::api_start ()
         snd_seq_ev_set_priority(&ev, 1);
         snd_seq_ev_set_source(&ev, m_local_addr_port);  /* set the source   */
         snd_seq_ev_set_subs(&ev);
-        snd_seq_ev_set_direct(&ev);                     /* it's immediate   */
+        set_timing(ev);                                 /* now or queued    */
         snd_seq_event_output(m_seq, &ev);               /* pump into queue  */
     }
 }
 
 /**
- *  Stop the MIDI buss.
+ *  Stop the MIDI buss.  In queue-scheduling mode, any Note Ons still
+ *  pending in the queue are removed first, so that nothing starts sounding
+ *  after the stop.  Pending Note Offs are kept.
  */
 
 void
@@ -756,6 +969,9 @@ midi_alsa::api_stop ()
 {
     if (parent_bus().port_enabled())
     {
+        if (scheduled())
+            remove_queued_on_events(0);
+
         snd_seq_event_t ev;
         snd_seq_ev_clear(&ev);                          /* memsets it to 0  */
         ev.type = SND_SEQ_EVENT_STOP;
@@ -763,23 +979,38 @@ midi_alsa::api_stop ()
         snd_seq_ev_set_priority(&ev, 1);
         snd_seq_ev_set_source(&ev, m_local_addr_port);  /* set the source   */
         snd_seq_ev_set_subs(&ev);
-        snd_seq_ev_set_direct(&ev);                     /* it's immediate   */
+        set_timing(ev);                                 /* now or queued    */
         snd_seq_event_output(m_seq, &ev);               /* pump into queue  */
     }
 }
 
+/**
+ *  Generates the MIDI clock as soon as possible.  See api_clock_at().
+ */
+
+void
+midi_alsa::api_clock (midipulse tick)
+{
+    api_clock_at(tick, 0);
+}
+
 /**
  *  Generates the MIDI clock, starting at the given tick value.
- *  Also sets the event tag to 127 so the sequences won't remove it.
+ *  Also sets the event tag to 127 so the sequences won't remove it.  In
+ *  queue-scheduling mode the clock gets the same lookahead as the notes, so
+ *  that they stay aligned.
  *
  * \threadsafe
  *
  * \param tick
  *      Provides the starting tick, unused in the ALSA implementation.
+ *
+ * \param ns
+ *      The monotonic time at which the clock is due, or 0.
  */
 
 void
-midi_alsa::api_clock (midipulse /*tick*/)
+midi_alsa::api_clock_at (midipulse /*tick*/, long long ns)
 {
     snd_seq_event_t ev;
     snd_seq_ev_clear(&ev);                          /* clear event          */
@@ -789,7 +1020,7 @@ midi_alsa::api_clock (midipulse /*tick*/)
     snd_seq_ev_set_priority(&ev, 1);
     snd_seq_ev_set_source(&ev, m_local_addr_port);  /* set source           */
     snd_seq_ev_set_subs(&ev);
-    snd_seq_ev_set_direct(&ev);                     /* it's immediate       */
+    set_timing(ev, ns);                             /* now or queued        */
     snd_seq_event_output(m_seq, &ev);               /* pump it into queue   */
 }
 
@@ -849,11 +1080,14 @@ midi_alsa::api_set_beats_per_minute (midibpm bpm)
     }
 }
 
-#if defined REMOVE_QUEUED_ON_EVENTS_CODE
-
 /**
- *  Deletes events in the queue.  This function is not used anywhere, and
- *  there was no comment about the intent/context of this function.
+ *  Deletes the output events with the given tag that are still pending in
+ *  the queue, except for Note Offs.  Used by api_stop() in queue-scheduling
+ *  mode.
+ *
+ * \param tag
+ *      The tag of the events to remove.  Note events have a tag of 0, while
+ *      clock events use 127.
  */
 
 void
@@ -867,12 +1101,13 @@ midi_alsa::remove_queued_on_events (int tag)
             SND_SEQ_REMOVE_IGNORE_OFF
     );
     snd_seq_remove_events_set_tag(remove_events, tag);
+    if (scheduled())
+        snd_seq_remove_events_set_queue(remove_events, m_out_queue);
+
     snd_seq_remove_events(m_seq, remove_events);
     snd_seq_remove_events_free(remove_events);
 }
 
-#endif      // REMOVE_QUEUED_ON_EVENTS_CODE
-
 /*
  * --------------------------------------------------------------------------
  *  midi_in_alsa
@@ -915,6 +1150,81 @@ midi_out_alsa::midi_out_alsa (midibus & parentbus, midi_info & masterinfo) :
     // Empty body
 }
 
+/*
+ * Free functions in the seq66 namespace
+ */
+
+/**
+ *  Fills an ALSA sequencer event from the status and data bytes of a
+ *  channel message (Note Off through Pitch Wheel), without an encoder.
+ *  Used by midi_alsa::encode_event(), and by the encoding benchmark (see
+ *  tests/alsa_encode_bench.cpp), which times it against
+ *  snd_midi_event_encode().
+ *
+ * \param [out] ev
+ *      The cleared ALSA event to be filled in.
+ *
+ * \param buffer
+ *      Provides the status byte (with channel) and two data bytes.
+ *
+ * \return
+ *      Returns true if the status is that of a channel message, and the
+ *      event was filled in.
+ */
+
+bool
+alsa_encode_channel_event (snd_seq_event_t & ev, const midibyte * buffer)
+{
+    bool result = true;
+    midibyte status = buffer[0];
+    int ch = int(status & EVENT_GET_CHAN_MASK);
+    int d0 = int(buffer[1]);
+    int d1 = int(buffer[2]);
+    switch (status & EVENT_GET_STATUS_MASK)
+    {
+    case EVENT_NOTE_OFF:
+
+        snd_seq_ev_set_noteoff(&ev, ch, d0, d1);
+        break;
+
+    case EVENT_NOTE_ON:
+
+        snd_seq_ev_set_noteon(&ev, ch, d0, d1);
+        break;
+
+    case EVENT_AFTERTOUCH:
+
+        snd_seq_ev_set_keypress(&ev, ch, d0, d1);
+        break;
+
+    case EVENT_CONTROL_CHANGE:
+
+        snd_seq_ev_set_controller(&ev, ch, d0, d1);
+        break;
+
+    case EVENT_PROGRAM_CHANGE:
+
+        snd_seq_ev_set_pgmchange(&ev, ch, d0);
+        break;
+
+    case EVENT_CHANNEL_PRESSURE:
+
+        snd_seq_ev_set_chanpress(&ev, ch, d0);
+        break;
+
+    case EVENT_PITCH_WHEEL:
+
+        snd_seq_ev_set_pitchbend(&ev, ch, ((d1 << 7) | d0) - 8192);
+        break;
+
+    default:
+
+        result = false;
+        break;
+    }
+    return result;
+}
+
 }           // namespace seq66
 
 /*
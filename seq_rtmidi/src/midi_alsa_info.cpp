@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2016-11-14
- * \updates       2025-05-20
+ * \updates       2026-10-15
  * \license       See above.
  *
  *  API information found at:
@@ -157,6 +157,16 @@ midi_alsa_info::midi_alsa_info
         midi_handle(seq);
         snd_seq_set_client_name(m_alsa_seq, rc().app_client_name().c_str());
         global_queue(snd_seq_alloc_queue(m_alsa_seq));
+        if (rc().alsa_queue_scheduling())
+        {
+            /*
+             * The queue must run for the output ports to schedule events on
+             * it.  It runs continuously; only real-time stamps are used.
+             */
+
+            snd_seq_start_queue(m_alsa_seq, global_queue(), nullptr);
+            snd_seq_drain_output(m_alsa_seq);
+        }
         get_poll_descriptors();
     }
 }
@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Gary P. Scavone; severe refactoring by Chris Ahlstrom
  * \date          2016-11-14
- * \updates       2026-05-09
+ * \updates       2026-10-15
  * \license       See above.
  *
  *  Written primarily by Alexander Svetalkin, with updates for delta time by
@@ -69,8 +69,8 @@
  *          void callback (midi_message & message, void * userdata)
  *
  *      This callback is wired in by calling rtmidi_in_data ::
- *      user_callback().  Unlike RtMidi, the delta time is stored as part of
- *      the message.
+ *      user_callback().  Unlike RtMidi, the time of receipt, in
+ *      microseconds, is stored as the timestamp of the message.
  *
  * JackPortFlags:
  *
@@ -188,7 +188,8 @@
 #include "midi/jack_assistant.hpp"      /* seq66::jack_status_pair_t        */
 #include "midibus_rm.hpp"               /* seq66::midibus for rtmidi        */
 #include "midi_jack.hpp"                /* seq66::midi_jack                 */
-#include "os/timing.hpp"                /* seq66::microsleep()              */
+#include "os/timing.hpp"                /* seq66::microsleep(), microtime() */
+#include "util/perfcounters.hpp"        /* seq66::perf_counters()           */
 
 /**
  *  Delimits the size of the JACK ringbuffer. Related to issue #100, when
@@ -210,6 +211,20 @@ static const size_t c_jack_ringbuffer_size = 2048;          /* tentative    */
 static const size_t c_jack_ringbuffer_size = 32768;         /* was 16384    */
 #endif
 
+/**
+ *  The size of the byte buffer that carries the data of SysEx messages
+ *  alongside the midi_message ring-buffer or input queue of each port.
+ */
+
+static const size_t c_jack_sysex_buffer_size = 16384;
+
+/**
+ *  The number of pull-mode events that each output port can take in one
+ *  JACK cycle without allocating.  Any more go to the ring-buffer.
+ */
+
+static const size_t c_jack_cycle_reserve = 1024;
+
 namespace seq66
 {
 
@@ -226,6 +241,31 @@ namespace seq66
 
 static const size_t s_message_buffer_size = 256;
 
+/**
+ *  The pull-mode cycle in progress on this thread, if any.  It is set only
+ *  on the JACK process thread, and only while the performer is playing the
+ *  patterns for the cycle, so that midi_jack::send_message() can tell the
+ *  events played by the process callback from those sent by other threads
+ *  (the output thread's MIDI clock, or notes previewed in the editors),
+ *  which still go through the ring-buffer.
+ */
+
+static thread_local engine_cycle * s_pull_cycle = nullptr;
+
+/**
+ *  Sets or clears the current pull-mode cycle.  Called by jack_process_io()
+ *  around the pull-mode callback and the writing of the output ports.
+ *
+ * \param cycle
+ *      The cycle being processed, or nullptr when done.
+ */
+
+void
+jack_pull_cycle (engine_cycle * cycle)
+{
+    s_pull_cycle = cycle;
+}
+
 #if defined SEQ66_PLATFORM_DEBUG_TMI
 
 /**
@@ -344,7 +384,8 @@ valid_frame_offset (jack_nframes_t offset)
  *    A pointer to the midi_jack_data structure to be processed.
  *
  * \return
- *    Returns 0 unless overflow occurs, then -1 is returned.
+ *    Returns the number of messages queued, so that jack_process_io() can
+ *    wake the input thread.  If overflow occurs, -1 is returned.
  */
 
 int
@@ -354,6 +395,9 @@ jack_process_rtmidi_input (jack_nframes_t framect, void * arg)
     rtmidi_in_data * rtindata = jackdata->jack_rtmidiin();
     void * buf = ::jack_port_get_buffer(jackdata->jack_port(), framect);
     int evcount = ::jack_midi_get_event_count(buf);
+    jack_client_t * client = jackdata->jack_client();
+    jack_nframes_t cycle_start = ::jack_last_frame_time(client) - framect;
+    int queued = 0;
     bool overflow = false;
     for (int j = 0; j < evcount; ++j)
     {
@@ -361,33 +405,54 @@ jack_process_rtmidi_input (jack_nframes_t framect, void * arg)
         int rc = ::jack_midi_event_get(&jmevent, buf, j);
         if (rc == 0)                                /* ENODATA if buf empty */
         {
-            jack_time_t jtime = ::jack_get_time();  /* time in microsec (!) */
-            jack_time_t delta_jtime;                /* uint64_t             */
-            if (rtindata->first_message())
-            {
-                rtindata->first_message(false);
-                delta_jtime = 0;
-            }
-            else
-            {
-                jtime -= jackdata->jack_lasttime();
-                delta_jtime = jack_time_t(jtime * 0.000001);    /* secs ??? */
-            }
-            jackdata->jack_lasttime(jtime);
+            /*
+             * The message is stamped with its time of arrival, in
+             * microseconds, so that api_get_midi_event() can measure the
+             * input latency, and the MIDI clock follower can filter out the
+             * jitter of the process cycle.  The events of this cycle
+             * arrived during the previous cycle, at the given frame offset.
+             */
 
             size_t eventsize = jmevent.size;
-            midi_message message(delta_jtime);      /* issue #100 ??????    */
-            for (size_t i = 0; i < eventsize; ++i)
-                message.push(jmevent.buffer[i]);
-
+            midipulse arrival = midipulse
+            (
+                ::jack_frames_to_time(client, cycle_start + jmevent.time)
+            );
+            midi_message message(arrival);
             if (! rtindata->continue_sysex())
             {
-                if (! rtindata->queue().add(message))
+                if (rtindata->queue().full())
                 {
                     async_safe_strprint("~");
                     overflow = true;
                     break;
                 }
+                if (eventsize > size_t(c_midi_message_bytes))
+                {
+                    jack_ringbuffer_t * sx = jackdata->jack_sysex();
+                    if
+                    (
+                        is_nullptr(sx) ||
+                        ::jack_ringbuffer_write_space(sx) < eventsize
+                    )
+                    {
+                        async_safe_errprint("SysEx input dropped");
+                        continue;
+                    }
+                    (void) ::jack_ringbuffer_write
+                    (
+                        sx, reinterpret_cast<const char *>(jmevent.buffer),
+                        eventsize
+                    );
+                    message.long_message(jmevent.buffer[0], int(eventsize));
+                }
+                else
+                {
+                    for (size_t i = 0; i < eventsize; ++i)
+                        (void) message.push(jmevent.buffer[i]);
+                }
+                (void) rtindata->queue().add(message);
+                ++queued;
             }
         }
         else
@@ -406,7 +471,7 @@ jack_process_rtmidi_input (jack_nframes_t framect, void * arg)
         async_safe_errprint(" Message overflow ");
         return (-1);
     }
-    return 0;
+    return queued;
 }
 
 #if defined SEQ66_SHOW_TIMING
@@ -527,7 +592,22 @@ jack_get_event_data
         if (process)
         {
             size_t datasz = size_t(msg.event_count());
-            if (datasz <= destsz)
+            if (msg.is_long())
+            {
+                jack_ringbuffer_t * sx = jackdata->jack_sysex();
+                if (datasz <= destsz)
+                {
+                    (void) ::jack_ringbuffer_read(sx, dest, datasz);
+                    destsz = datasz;
+                }
+                else
+                {
+                    ::jack_ringbuffer_read_advance(sx, datasz);
+                    async_safe_errprint("SysEx too long for JACK output");
+                    destsz = 0;
+                }
+            }
+            else
             {
                 memcpy(dest, msg.event_bytes(), datasz);
                 destsz = datasz;
@@ -553,6 +633,104 @@ jack_get_event_data
 
 #endif  // defined SEQ66_USE_MIDI_MESSAGE_RINGBUFFER
 
+/**
+ *  Adds an event played by the pull-mode callback to the cycle list of the
+ *  port, converting its pulse time-stamp to a frame offset in the cycle.
+ *  Events that are late (for example, from a pattern whose lock was busy in
+ *  the previous cycle) go at the start of the cycle.
+ *
+ * \param jackdata
+ *      The port's JACK data.
+ *
+ * \param message
+ *      The (short) message to add.
+ *
+ * \return
+ *      Returns false if the cycle list is full, so that the caller can fall
+ *      back to the ring-buffer.
+ */
+
+static bool
+jack_queue_cycle_event (midi_jack_data * jackdata, const midi_message & message)
+{
+    std::vector<midi_message> & cyc = jackdata->jack_cycle();
+    bool result = cyc.size() < cyc.capacity();
+    if (result)
+    {
+        const engine_cycle & ec = *s_pull_cycle;
+        double ticks = double(message.timestamp()) - ec.ec_start_tick;
+        double frame = ticks * ec.ec_frames_per_tick;
+        jack_nframes_t offset = 0;
+        if (frame >= double(ec.ec_frames))
+            offset = jack_nframes_t(ec.ec_frames - 1);
+        else if (frame > 0.0)
+            offset = jack_nframes_t(frame);
+
+        cyc.push_back(message);
+        cyc.back().timestamp(midipulse(offset));
+    }
+    return result;
+}
+
+/**
+ *  Writes the events of the pull-mode cycle to the port buffer.  JACK needs
+ *  the events in time order, so they are sorted first.  The sort is an
+ *  insertion sort: it is stable, so that a Note Off followed by a Note On at
+ *  the same frame stay in that order, it does not allocate, and the events
+ *  of each pattern are already in order.
+ *
+ * \param jackdata
+ *      The port's JACK data.
+ *
+ * \param buf
+ *      The port buffer for this cycle.
+ *
+ * \param lastvalue
+ *      The offset of the last event written from the ring-buffer.  No event
+ *      can be written before it.
+ */
+
+static void
+jack_write_cycle_events
+(
+    midi_jack_data * jackdata,
+    void * buf,
+    jack_nframes_t lastvalue
+)
+{
+    std::vector<midi_message> & cyc = jackdata->jack_cycle();
+    if (cyc.empty())
+        return;
+
+    for (size_t i = 1; i < cyc.size(); ++i)
+    {
+        midi_message m = cyc[i];
+        size_t j = i;
+        for ( ; j > 0 && cyc[j - 1].timestamp() > m.timestamp(); --j)
+            cyc[j] = cyc[j - 1];
+
+        cyc[j] = m;
+    }
+    for (const auto & m : cyc)
+    {
+        jack_nframes_t offset = jack_nframes_t(m.timestamp());
+        if (offset < lastvalue)
+            offset = lastvalue;
+
+        const jack_midi_data_t * data =
+            reinterpret_cast<const jack_midi_data_t *>(m.event_bytes());
+
+        int rc = ::jack_midi_event_write(buf, offset, data, m.event_count());
+        if (rc != 0)
+        {
+            async_safe_errprint("JACK MIDI cycle write error");
+            break;
+        }
+        lastvalue = offset;
+    }
+    cyc.clear();                            /* keeps the capacity           */
+}
+
 /**
  *  Defines the JACK output process callback for a MIDI output port (a
  *  midi_out_jack object associated with, for example,
@@ -621,7 +799,10 @@ jack_process_rtmidi_output (jack_nframes_t framect, void * arg)
         (
             jackdata, framect, cycle_start, lastvalue, mbuf, destsz
         );
-        if (destsz > 0 && valid_frame_offset(offset))
+        if (! valid_frame_offset(offset))
+            break;
+
+        if (destsz > 0)                     /* 0 if a SysEx was dropped     */
         {
             const jack_midi_data_t * data =
                 reinterpret_cast<const jack_midi_data_t *>(mbuf);
@@ -634,9 +815,8 @@ jack_process_rtmidi_output (jack_nframes_t framect, void * arg)
             }
             lastvalue = offset;            /* tricky code */
         }
-        else
-            break;
     }
+    jack_write_cycle_events(jackdata, buf, lastvalue);  /* pull mode only  */
     return 0;
 }
 
@@ -1002,6 +1182,8 @@ midi_jack::~midi_jack ()
     if (not_nullptr(jack_data().jack_buffmessage()))
         ::jack_ringbuffer_free(jack_data().jack_buffmessage());
 #endif
+    if (not_nullptr(jack_data().jack_sysex()))
+        ::jack_ringbuffer_free(jack_data().jack_sysex());
 }
 
 /**
@@ -1079,7 +1261,12 @@ midi_jack::api_init_in ()
     std::string remoteportname = connect_name();    /* "bus:port"       */
     remote_port_name(remoteportname);
     set_alt_name(rc().application_name(), rc().app_client_name());
-    return register_port(midibase::io::input, port_name());
+
+    bool result = create_sysex_buffer();
+    if (result)
+        result = register_port(midibase::io::input, port_name());
+
+    return result;
 }
 
 /**
@@ -1239,7 +1426,10 @@ midi_jack::api_init_in_sub ()
             portname += " ";
             portname += std::to_string(portid);
         }
-        result = register_port(midibase::io::input, portname);
+        result = create_sysex_buffer();
+        if (result)
+            result = register_port(midibase::io::input, portname);
+
         if (result)
         {
             set_virtual_name(portid, portname);
@@ -1292,11 +1482,10 @@ midi_jack::api_deinit_in ()
 }
 
 /**
- *  We could push the bytes of the event into a midibyte vector, as done in
- *  send_message().  The ALSA code (seq_alsamidi/src/midibus.cpp) sticks the
- *  event bytes in an array, which might be a little faster than using
- *  push_back(), but let's try the vector first.  The rtmidi code here is from
- *  midi_out_jack :: send_message().
+ *  Puts the bytes of the event into a midi_message, which holds them in
+ *  place, so that neither building the message nor copying it into the
+ *  ring-buffer allocates.  The rtmidi code here is from midi_out_jack ::
+ *  send_message().
  */
 
 void
@@ -1306,10 +1495,10 @@ midi_jack::api_play (const event * e24, midibyte channel)
     midibyte status = e24->get_status(channel);
     midibyte d0, d1;
     e24->get_data(d0, d1);
-    message.push(status);
-    message.push(d0);
+    (void) message.push(status);
+    (void) message.push(d0);
     if (e24->is_two_bytes())
-        message.push(d1);
+        (void) message.push(d1);
 
 #if defined SEQ66_SHOW_TIMING
     message.msg_send_time(uint64_t(::jack_get_time()));
@@ -1363,30 +1552,23 @@ midi_jack::send_message (const midi_message & message)
     ncmessage.timestamp(midipulse(::jack_frame_time(jack_data().jack_client())));
 #endif
 
-#if defined SEQ66_PLATFORM_DEBUG
-    bool result = rb->push_back(message);
-    if (result)
+    if (not_nullptr(s_pull_cycle) && ! message.is_long())
     {
-        size_t space = size_t(rb->read_space());
-        result = space > 0 && space < c_jack_ringbuffer_size;
+        if (jack_queue_cycle_event(&jack_data(), message))
+            return true;                        /* written by this cycle    */
     }
 
-    /*
-     * Redundant. We get "seq66] JACK send event failed" anyway.
-     *
-     *  if (! result)
-     *      printf("send_message() failed\n");
-     */
-
+    bool result = rb->push_back(message);       /* refused if it is full    */
+    perf_counters().ring_usage
+    (
+        parent_bus().bus_index(), rb->count_max(), rb->dropped()
+    );
     return result;
-#else
-    return rb->push_back(message);
-#endif
 
 #else   // ! defined SEQ66_USE_MIDI_MESSAGE_RINGBUFFER
 
-    int nbytes = message.event_count();
-    bool result = nbytes > 0 && nbytes < int(s_message_buffer_size);
+    int nbytes = message.inline_count();
+    bool result = nbytes > 0 && ! message.is_long();
     if (result)
     {
         short n = short(nbytes);
@@ -1411,6 +1593,11 @@ midi_jack::send_message (const midi_message & message)
  *  Work on this routine now in progress.  Unlike the ALSA implementation, we
  *  do not try to send large messages (greater than 255 bytes) in chunks.
  *
+ *  A SysEx message is too long to be held in a midi_message, so its bytes
+ *  are written to the pre-allocated SysEx buffer, and the message holds
+ *  only the size and status.  Both buffers are checked for room first, so
+ *  that the message and its bytes are either both queued or both dropped.
+ *
  *  The event::sysex data type is a vector of midibytes.  Also note that both
  *  Meta and Sysex messages are covered by the event :: is_ex_data() function
  *  and via the sysex() function to send data.
@@ -1431,12 +1618,33 @@ midi_jack::api_sysex (const event * e24)
     midi_message message(e24->timestamp());             /* issue #100       */
     const event::sysex & data = e24->get_sysex();
     int data_size = e24->sysex_size();
-    for (int offset = 0; offset < data_size; ++offset)
-        message.push(data[offset]);
-
-    if (jack_data().valid_buffer())
+    if (jack_data().valid_buffer() && data_size > 0)
     {
-        if (! send_message(message))
+        bool ok = true;
+        if (data_size > c_midi_message_bytes)
+        {
+            jack_ringbuffer_t * sx = jack_data().jack_sysex();
+            size_t sz = size_t(data_size);
+            ok = not_nullptr(sx) && ::jack_ringbuffer_write_space(sx) >= sz;
+#if defined SEQ66_USE_MIDI_MESSAGE_RINGBUFFER
+            if (ok)
+                ok = jack_data().jack_buffer()->write_space() > 0;
+#endif
+            if (ok)
+            {
+                (void) ::jack_ringbuffer_write
+                (
+                    sx, reinterpret_cast<const char *>(data.data()), sz
+                );
+                message.long_message(data[0], data_size);
+            }
+        }
+        else
+        {
+            for (int offset = 0; offset < data_size; ++offset)
+                (void) message.push(data[offset]);
+        }
+        if (! ok || ! send_message(message))
             printf("JACK send sysex failed");
     }
 }
@@ -1564,7 +1772,7 @@ void
 midi_jack::send_byte (midipulse tick, midibyte evbyte)
 {
     midi_message message(tick);
-    message.push(evbyte);
+    (void) message.push(evbyte);
     if (jack_data().valid_buffer())
     {
         if (! send_message(message))
@@ -1874,7 +2082,11 @@ midi_jack::create_ringbuffer (size_t rbsize)
 
         result = not_nullptr(rb);
         if (result)
+        {
+            (void) rb->mlock();                 /* no page faults in RT     */
             jack_data().jack_buffer(rb);
+            jack_data().jack_cycle().reserve(c_jack_cycle_reserve);
+        }
 #else
         jack_ringbuffer_t * rb = ::jack_ringbuffer_create(rbsize);
         result = not_nullptr(rb);
@@ -1886,6 +2098,36 @@ midi_jack::create_ringbuffer (size_t rbsize)
             m_error_string = "JACK ringbuffer create error";
             error(rterror::kind::warning, m_error_string);
         }
+        else
+            result = create_sysex_buffer();
+    }
+    return result;
+}
+
+/**
+ *  Creates the byte buffer that carries the data of SysEx messages for
+ *  either an input or an output port.  Does nothing if it already exists.
+ */
+
+bool
+midi_jack::create_sysex_buffer ()
+{
+    bool result = not_nullptr(jack_data().jack_sysex());
+    if (! result)
+    {
+        jack_ringbuffer_t * rb =
+            ::jack_ringbuffer_create(c_jack_sysex_buffer_size);
+
+        result = not_nullptr(rb);
+        if (result)
+        {
+            jack_data().jack_sysex(rb);
+        }
+        else
+        {
+            m_error_string = "JACK SysEx buffer create error";
+            error(rterror::kind::warning, m_error_string);
+        }
     }
     return result;
 }
@@ -1911,7 +2153,8 @@ midi_jack::create_ringbuffer (size_t rbsize)
 midi_in_jack::midi_in_jack (midibus & parentbus, midi_info & masterinfo)
  :
     midi_jack       (parentbus, masterinfo),
-    m_client_name   ()
+    m_client_name   (),
+    m_sysex_buffer  ()
 {
     /*
      * Currently, we cannot initialize here because the clientname is empty.
@@ -1926,6 +2169,8 @@ midi_in_jack::midi_in_jack (midibus & parentbus, midi_info & masterinfo)
 
 /**
  *  Checks the rtmidi_in_data queue for the number of items in the queue.
+ *  This no longer sleeps; the waiting is done once for all ports in
+ *  midi_jack_info::api_poll_for_midi().
  *
  * \return
  *      Returns the value of rtindata->queue().count(), unless the caller is
@@ -1936,7 +2181,6 @@ int
 midi_in_jack::api_poll_for_midi ()
 {
     rtmidi_in_data * rtindata = jack_data().jack_rtmidiin();
-    (void) microsleep(std_sleep_us());                          /* 10 us */
     return rtindata->queue().count();
 }
 
@@ -1971,10 +2215,32 @@ midi_in_jack::api_get_midi_event (event * inev)
     if (result)
     {
         midi_message mm = rtindata->queue().pop_front();
-        result = inev->set_midi_event
-        (
-            mm.timestamp(), mm.event_bytes(), mm.event_count()
-        );
+        jack_time_t received = jack_time_t(mm.timestamp());
+        long age = long(::jack_get_time() - received);
+        perf_counters().input_latency(age);
+        if (mm.is_long())
+        {
+            jack_ringbuffer_t * sx = jack_data().jack_sysex();
+            std::size_t sz = std::size_t(mm.event_count());
+            if (m_sysex_buffer.size() < sz)
+                m_sysex_buffer.resize(sz);
+
+            (void) ::jack_ringbuffer_read
+            (
+                sx, reinterpret_cast<char *>(m_sysex_buffer.data()), sz
+            );
+            result = inev->set_midi_event
+            (
+                0, m_sysex_buffer.data(), mm.event_count()
+            );
+        }
+        else
+        {
+            result = inev->set_midi_event
+            (
+                0, mm.event_bytes(), mm.event_count()
+            );
+        }
         inev->set_input_bus(mm.input_buss());   // but busarry::get_midi_event()!
         if (result)
         {
@@ -2011,6 +2277,8 @@ midi_in_jack::api_get_midi_event (event * inev)
             }
             if (event::is_sense_or_reset(st))
                 result = false;
+            else if (st == EVENT_MIDI_CLOCK)
+                inev->set_timestamp(midipulse(microtime() - age));
 
             /*
              * Issue #55 (ignoring the channel).  The status is already set,
@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2022-09-13
- * \updates       2026-05-09
+ * \updates       2026-10-15
  * \license       See above.
  *
  *  GitHub issue #165: enabled a build and run with no JACK support.
@@ -70,6 +70,8 @@ midi_jack_data::midi_jack_data () :
 #else
     m_jack_buffmessage      (nullptr),
 #endif
+    m_jack_sysex            (nullptr),
+    m_jack_cycle            (),
     m_jack_lasttime         (0),
 #if defined SEQ66_MIDI_PORT_REFRESH
     m_internal_port_id      (null_system_port_id()),
@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2017-01-01
- * \updates       2026-05-09
+ * \updates       2026-10-15
  * \license       See above.
  *
  *  This class is meant to collect a whole bunch of JACK information about
@@ -54,15 +54,29 @@
 #include "util/basic_macros.hpp"        /* C++ version of easy macros       */
 #include "util/strfunctions.hpp"        /* seq66::contains()                */
 
+#if defined SEQ66_PLATFORM_LINUX
+#include <poll.h>                       /* poll(2)                          */
+#include <sys/eventfd.h>                /* eventfd(2)                       */
+#include <unistd.h>                     /* read(2), write(2), close(2)      */
+#endif
+
 namespace seq66
 {
 
+/**
+ *  The maximum time to wait for JACK MIDI input, in milliseconds, so that
+ *  the input thread can check for exit.  Matches the ALSA poll() timeout.
+ */
+
+static const int c_poll_wait_ms = 10;
+
 /*
  * Defined in midi_jack.cpp; used to be static.
  */
 
 extern int jack_process_rtmidi_input (jack_nframes_t nframes, void * arg);
 extern int jack_process_rtmidi_output (jack_nframes_t nframes, void * arg);
+extern void jack_pull_cycle (engine_cycle * cycle);
 extern void jack_shutdown_callback (void * arg);
 
 #if defined SEQ66_JACK_PORT_CONNECT_CALLBACK
@@ -83,7 +97,12 @@ extern void jack_port_register_callback
  *  Provides a JACK callback function that uses the callbacks defined in the
  *  midi_jack module.  This function calls both the input callback and
  *  the output callback, depending on the port type.  This may lead to
- *  delays, depending on the size of the JACK MIDI buffer.
+ *  delays, depending on the size of the JACK MIDI buffer.  If any input
+ *  arrived, the input thread is woken; see api_poll_for_midi().
+ *
+ *  In pull mode, the performer's callback is called first, and plays the
+ *  patterns for this cycle.  The events land in the per-port cycle lists,
+ *  with exact frame offsets, and the output ports write them out below.
  *
  * \param nframes
  *      The frame number from the JACK API.
@@ -105,17 +124,28 @@ jack_process_io (jack_nframes_t nframes, void * arg)
          * Go through the I/O ports and route the data appropriately.
          */
 
+        engine_cycle cycle;
+        bool pulled = self->run_engine(nframes, cycle);
+        bool gotinput = false;
         for (auto mj : self->jack_ports())  /* midi_jack pointers       */
         {
             if (mj->enabled())
             {
                 midi_jack_data * mjp = &mj->jack_data();
                 if (mj->parent_bus().is_input_port())
-                    (void) jack_process_rtmidi_input(nframes, mjp);
+                {
+                    if (jack_process_rtmidi_input(nframes, mjp) != 0)
+                        gotinput = true;        /* events or overflow   */
+                }
                 else
                     (void) jack_process_rtmidi_output(nframes, mjp);
             }
         }
+        if (pulled)
+            jack_pull_cycle(nullptr);       /* back to the ring-buffers     */
+
+        if (gotinput)
+            self->signal_input();
     }
     return 0;
 }
@@ -143,8 +173,16 @@ midi_jack_info::midi_jack_info
     m_jack_ports            (),
     m_jack_client           (nullptr),              /* inited for connect() */
     m_jack_buffer_size      (0),
-    m_jack_sample_rate      (0)
+    m_jack_sample_rate      (0),
+    m_input_fd              (-1),
+    m_engine                (nullptr),
+    m_engine_arg            (nullptr)
 {
+#if defined SEQ66_PLATFORM_LINUX
+    m_input_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_input_fd < 0)
+        error_message("JACK input eventfd failed, polling instead");
+#endif
     silence_jack_info();
     m_jack_client = connect();
     if (not_nullptr(m_jack_client))                 /* created by connect() */
@@ -163,6 +201,13 @@ midi_jack_info::midi_jack_info
 midi_jack_info::~midi_jack_info ()
 {
     disconnect();
+#if defined SEQ66_PLATFORM_LINUX
+    if (m_input_fd >= 0)
+    {
+        (void) ::close(m_input_fd);
+        m_input_fd = -1;
+    }
+#endif
 }
 
 /**
@@ -906,14 +951,136 @@ midi_jack_info::api_port_start
 }
 
 /**
- *  We might be able to eliminate this function.
+ *  Installs (or, with a null function, removes) the pull-mode callback.
+ *  The argument is stored first, so that the process callback never sees
+ *  the new function with the old argument.  On removal the argument is
+ *  left alone, in case a cycle in progress has just loaded the function.
+ *
+ * \param f
+ *      The callback, normally performer::pull_callback().
+ *
+ * \param arg
+ *      The pointer to pass to the callback.
+ *
+ * \return
+ *      Returns true, as JACK supports pull mode.
+ */
+
+bool
+midi_jack_info::api_set_engine (engine_callback f, void * arg)
+{
+    if (not_nullptr(f))
+        m_engine_arg = arg;             /* before the function, see above   */
+
+    m_engine = f;
+    return true;
+}
+
+/**
+ *  Called at the start of the JACK process callback.  If a pull-mode
+ *  callback is installed, this function fills in the cycle timing, makes
+ *  the cycle current for midi_jack::send_message(), and calls it.  Only
+ *  real-time-safe JACK calls are made here.
+ *
+ * \param nframes
+ *      The number of frames in the cycle.
+ *
+ * \param [out] cycle
+ *      Provides the cycle information to fill in.
+ *
+ * \return
+ *      Returns true if the callback played the cycle.  In that case the
+ *      caller must call jack_pull_cycle(nullptr) when done with the ports.
+ */
+
+bool
+midi_jack_info::run_engine (jack_nframes_t nframes, engine_cycle & cycle)
+{
+    engine_callback f = m_engine;
+    bool result = not_nullptr(f);
+    if (result)
+    {
+        jack_position_t pos;
+        jack_transport_state_t state =
+            ::jack_transport_query(client_handle(), &pos);
+
+        cycle.ec_frames = unsigned(nframes);
+        cycle.ec_sample_rate = unsigned(pos.frame_rate);
+        cycle.ec_transport = rc().with_jack_transport() &&
+            state == JackTransportRolling;
+
+        cycle.ec_frame = cycle.ec_transport ?
+            unsigned(pos.frame) :
+            unsigned(::jack_last_frame_time(client_handle())) ;
+
+        cycle.ec_start_tick = 0.0;
+        cycle.ec_frames_per_tick = 0.0;
+        result = cycle.ec_sample_rate > 0;
+        if (result)
+        {
+            jack_pull_cycle(&cycle);
+            result = f(m_engine_arg, cycle);
+            if (! result)
+                jack_pull_cycle(nullptr);
+        }
+    }
+    return result;
+}
+
+/**
+ *  Wakes up the input thread waiting in api_poll_for_midi().  Called from
+ *  the JACK process callback, so it only bumps the eventfd counter, which
+ *  never blocks and never allocates.
+ */
+
+void
+midi_jack_info::signal_input ()
+{
+#if defined SEQ66_PLATFORM_LINUX
+    if (m_input_fd >= 0)
+    {
+        uint64_t one = 1;
+        (void) ::write(m_input_fd, &one, sizeof one);
+    }
+#endif
+}
+
+/**
+ *  Waits for the JACK process callback to signal that MIDI input has been
+ *  queued on one of the input ports, or for c_poll_wait_ms to elapse, so
+ *  that the input thread does not spin while idle.  Any input queued before
+ *  the wait leaves the eventfd readable, so nothing is missed.  Without an
+ *  eventfd, this falls back to the old short sleep.
+ *
+ * \return
+ *      Returns 1 if input was signalled (the caller then checks the port
+ *      queues), and 0 on a timeout.
  */
 
 int
 midi_jack_info::api_poll_for_midi ()
 {
+    int result = 0;
+#if defined SEQ66_PLATFORM_LINUX
+    if (m_input_fd >= 0)
+    {
+        struct pollfd pfd;
+        pfd.fd = m_input_fd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        if (::poll(&pfd, 1, c_poll_wait_ms) > 0)
+        {
+            uint64_t count;
+            if (::read(m_input_fd, &count, sizeof count) > 0)
+                result = 1;
+        }
+    }
+    else
+        (void) microsleep(std_sleep_us());
+#else
     (void) microsleep(std_sleep_us());
-    return 0;
+#endif
+    return result;
 }
 
 /**
@@ -25,7 +25,7 @@
  * \library       seq66 application
  * \author        Chris Ahlstrom
  * \date          2016-11-21
- * \updates       2025-01-20
+ * \updates       2026-10-15
  * \license       GNU GPLv2 or above
  *
  *  This file provides a cross-platform implementation of the midibus class.
@@ -406,6 +406,18 @@ midibus::api_play (const event * e24, midibyte channel)
         m_rt_midi->api_play(e24, channel);
 }
 
+/**
+ *  Plays an event due at the given monotonic time.  Called by
+ *  midibase::commit().
+ */
+
+void
+midibus::api_play_at (const event * e24, midibyte channel, long long ns)
+{
+    if (good_api())
+        m_rt_midi->api_play_at(e24, channel, ns);
+}
+
 void
 midibus::api_sysex (const event * e24)
 {
@@ -474,6 +486,17 @@ midibus::api_clock (midipulse tick)
         m_rt_midi->api_clock(tick);
 }
 
+/**
+ *  Generates a MIDI clock due at the given monotonic time.
+ */
+
+void
+midibus::api_clock_at (midipulse tick, long long ns)
+{
+    if (good_api())
+        m_rt_midi->api_clock_at(tick, ns);
+}
+
 }           // namespace seq66
 
 /*
@@ -24,7 +24,7 @@
  * \library       seq66 application
  * \author        Gary P. Scavone; severe refactoring by Chris Ahlstrom
  * \date          2016-12-01
- * \updates       2023-12-03
+ * \updates       2026-10-15
  * \license       See above.
  *
  *  Provides some basic types for the (heavily-factored) rtmidi library, very
@@ -60,15 +60,18 @@ midi_message::midi_message (midipulse ts) :
     m_msg_number    (sm_msg_number++),
     m_msg_send_time (0),
 #endif
-    m_bytes         (),
     m_timestamp     (ts),
+    m_size          (0),
+    m_bytes         (),
     m_input_buss    (null_buss())
 {
     // No code
 }
 
 /**
- *  Constructs a midi_message from an array of bytes.
+ *  Constructs a midi_message from an array of bytes.  If the array is too
+ *  long to hold in place, only its status byte and size are kept, and the
+ *  caller must pass the bytes along separately.
  *
  * \param mbs
  *      Provides the data, which should start with the timestamp bytes, and
@@ -81,13 +84,22 @@ midi_message::midi_message (midipulse ts) :
 midi_message::midi_message (const midibyte * mbs, std::size_t sz) :
 #if defined SEQ66_SHOW_TIMING
     m_msg_number    (sm_msg_number++),
+    m_msg_send_time (0),
 #endif
-    m_bytes         (),
     m_timestamp     (0),
+    m_size          (0),
+    m_bytes         (),
     m_input_buss    (null_buss())
 {
-    for (std::size_t i = 0; i < sz; ++i)
-        m_bytes.push_back(*mbs++);
+    if (int(sz) > c_midi_message_bytes)
+    {
+        long_message(mbs[0], int(sz));
+    }
+    else
+    {
+        for (std::size_t i = 0; i < sz; ++i)
+            (void) push(*mbs++);
+    }
 }
 
 /**
@@ -109,9 +121,7 @@ midi_message::to_string () const
     result += std::to_string(ts);
     result += ":";
 
-    int counter = 8;
-    if (event_count() < counter)
-        counter = event_count();
+    int counter = inline_count();
 
     for (int i = 0; i < counter; ++i)
     {
@@ -0,0 +1,256 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          alsa_encode_bench.cpp
+ *
+ *  This module times the encoding of output events for the ALSA sequencer.
+ *
+ * \library       seq66 tests
+ * \author        Chris Ahlstrom
+ * \date          2026-10-15
+ * \updates       2026-10-15
+ * \license       GNU GPLv2 or above
+ *
+ *  midi_alsa::api_play() fills the ALSA event of a channel message directly
+ *  (see alsa_encode_channel_event()), rather than running the bytes through
+ *  snd_midi_event_encode().  This program times both ways on the same mix
+ *  of messages, and reports the events per second of each.  No sequencer
+ *  or device is opened.
+ *
+ *  It first checks that both ways build the same events, and fails if they
+ *  do not, so that it can also be run as a test.
+ *
+ *      alsa_encode_bench [events]
+ */
+
+#include <cstdio>                       /* std::printf()                    */
+#include <cstdlib>                      /* std::atol(), EXIT_SUCCESS        */
+#include <cstring>                      /* std::memcmp()                    */
+#include <vector>                       /* std::vector<>                    */
+
+#include "midi_alsa.hpp"                /* seq66::alsa_encode_channel_event */
+#include "os/timing.hpp"                /* seq66::nanotime()                */
+
+namespace
+{
+
+/**
+ *  The default number of events per run, and the number of runs.  The best
+ *  run is reported, as the others include scheduling noise.
+ */
+
+const long c_events_default = 1000000;
+const int c_runs = 5;
+
+/**
+ *  The size given to the ALSA encoder, the same as in midi_alsa.
+ */
+
+const size_t c_encoder_size = 12;
+
+/**
+ *  A mix of channel messages like that of a busy song: mostly notes, some
+ *  controllers and pitch wheel, and a few of the rest, on all channels.
+ */
+
+const seq66::midibyte c_statuses [] =
+{
+    0x90, 0x80, 0x90, 0x80, 0x90, 0x80, 0xB0, 0xE0, 0xA0, 0xC0, 0xD0, 0xB0
+};
+
+void
+make_messages (std::vector<seq66::midibyte> & msgs, long count)
+{
+    const int statuses = int(sizeof c_statuses / sizeof c_statuses[0]);
+    msgs.clear();
+    msgs.reserve(size_t(count) * 3);
+    for (long i = 0; i < count; ++i)
+    {
+        seq66::midibyte status = c_statuses[i % statuses];
+        msgs.push_back(seq66::midibyte(status | (i % 16)));
+        msgs.push_back(seq66::midibyte((i * 7) % 128));
+        msgs.push_back(seq66::midibyte((i * 13) % 128));
+    }
+}
+
+/**
+ *  Folds the parts of an event that the encoding sets into a value that the
+ *  compiler cannot discard.
+ */
+
+inline unsigned long
+fold (const snd_seq_event_t & ev)
+{
+    return unsigned(ev.type) + unsigned(ev.data.note.channel) +
+        unsigned(ev.data.note.note) + unsigned(ev.data.note.velocity) +
+        unsigned(ev.data.control.value);
+}
+
+long long
+time_direct (const std::vector<seq66::midibyte> & msgs, unsigned long & sum)
+{
+    long long start = seq66::nanotime();
+    for (size_t i = 0; i < msgs.size(); i += 3)
+    {
+        snd_seq_event_t ev;
+        snd_seq_ev_clear(&ev);
+        if (seq66::alsa_encode_channel_event(ev, &msgs[i]))
+            sum += fold(ev);
+    }
+    return seq66::nanotime() - start;
+}
+
+long long
+time_encoder
+(
+    snd_midi_event_t * encoder,
+    const std::vector<seq66::midibyte> & msgs,
+    unsigned long & sum
+)
+{
+    long long start = seq66::nanotime();
+    for (size_t i = 0; i < msgs.size(); i += 3)
+    {
+        snd_seq_event_t ev;
+        snd_seq_ev_clear(&ev);
+        snd_midi_event_reset_encode(encoder);
+        if (snd_midi_event_encode(encoder, &msgs[i], 3, &ev) > 0)
+            sum += fold(ev);
+    }
+    return seq66::nanotime() - start;
+}
+
+/**
+ *  Checks that both encodings of each message of one cycle of the mix, on
+ *  each channel, give the same event.
+ */
+
+bool
+same_events (snd_midi_event_t * encoder)
+{
+    bool result = true;
+    std::vector<seq66::midibyte> msgs;
+    make_messages(msgs, 16 * 12);
+    for (size_t i = 0; i < msgs.size(); i += 3)
+    {
+        snd_seq_event_t direct, encoded;
+        snd_seq_ev_clear(&direct);
+        snd_seq_ev_clear(&encoded);
+        snd_midi_event_reset_encode(encoder);
+        bool ok = seq66::alsa_encode_channel_event(direct, &msgs[i]) &&
+            snd_midi_event_encode(encoder, &msgs[i], 3, &encoded) > 0;
+
+        if (ok)
+        {
+            ok = direct.type == encoded.type &&
+                std::memcmp(&direct.data, &encoded.data, sizeof direct.data)
+                    == 0;
+        }
+        if (! ok)
+        {
+            std::fprintf
+            (
+                stderr, "Encodings differ for %02X %02X %02X\n",
+                unsigned(msgs[i]), unsigned(msgs[i + 1]),
+                unsigned(msgs[i + 2])
+            );
+            result = false;
+        }
+    }
+    return result;
+}
+
+void
+report (const char * name, long events, long long best, long long total)
+{
+    double best_us = double(best) / 1000.0;
+    double mean_us = double(total) / 1000.0 / c_runs;
+    double rate = best > 0 ? double(events) * 1.0e9 / double(best) : 0.0 ;
+    std::printf
+    (
+        "%s,%ld,%.1f,%.1f,%.0f\n", name, events, best_us, mean_us, rate
+    );
+}
+
+}           // namespace (anonymous)
+
+/**
+ *  Runs the comparison.  The output is comma-separated: the name of the
+ *  encoding, the events per run, the best and mean run in microseconds,
+ *  and the events per second of the best run.
+ */
+
+int
+main (int argc, char * argv [])
+{
+    long events = argc > 1 ? std::atol(argv[1]) : c_events_default ;
+    if (events <= 0)
+        events = c_events_default;
+
+    bool ok = false;
+    snd_midi_event_t * encoder = nullptr;
+    if (snd_midi_event_new(c_encoder_size, &encoder) == 0)
+        ok = same_events(encoder);
+    else
+        std::fprintf(stderr, "Could not create the ALSA encoder\n");
+
+    if (ok)
+    {
+        std::vector<seq66::midibyte> msgs;
+        make_messages(msgs, events);
+
+        unsigned long sum = 0;
+        long long best_direct = 0, total_direct = 0;
+        long long best_encoder = 0, total_encoder = 0;
+        for (int r = 0; r < c_runs; ++r)
+        {
+            long long t = time_direct(msgs, sum);
+            total_direct += t;
+            if (r == 0 || t < best_direct)
+                best_direct = t;
+
+            t = time_encoder(encoder, msgs, sum);
+            total_encoder += t;
+            if (r == 0 || t < best_encoder)
+                best_encoder = t;
+        }
+        std::printf("encoding,events,best_us,mean_us,events_per_s\n");
+        report("direct", events, best_direct, total_direct);
+        report("snd_midi_event_encode", events, best_encoder, total_encoder);
+        if (best_direct > 0)
+        {
+            std::printf
+            (
+                "# direct fill is %.1fx the encoder (checksum %lu)\n",
+                double(best_encoder) / double(best_direct), sum
+            );
+        }
+    }
+    if (not_nullptr(encoder))
+        snd_midi_event_free(encoder);
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE ;
+}
+
+/*
+ * alsa_encode_bench.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */
+
@@ -0,0 +1,917 @@
+/*
+ *  This file is part of seq66.
+ *
+ *  seq66 is free software; you can redistribute it and/or modify it under the
+ *  terms of the GNU General Public License as published by the Free Software
+ *  Foundation; either version 2 of the License, or (at your option) any later
+ *  version.
+ *
+ *  seq66 is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with seq66; if not, write to the Free Software Foundation, Inc., 59 Temple
+ *  Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file          core_bench.cpp
+ *
+ *  This module times the sequencing core on a large synthetic song.
+ *
+ * \library       seq66 tests
+ * \author        Chris Ahlstrom
+ * \date          2026-10-15
+ * \updates       2026-10-15
+ * \license       GNU GPLv2 or above
+ *
+ *  The benchmark builds a large synthetic song in a performer of its own:
+ *  many patterns, thousands of events each, and many triggers.  It then
+ *  times the paths that grow with the size of a song: adding and sorting
+ *  events, linking notes, playing the patterns frame by frame in Live and
+ *  Song mode, writing, exporting, and parsing the MIDI file, and the
+ *  quantize and LFO transforms.  Each case is run a few times, and the best
+ *  and the mean times are written as comma-separated values, one line per
+ *  case.
+ *
+ *  The performer is never launched, so no MIDI engine, port, session, or
+ *  configuration file is used.  What the patterns play is counted by a
+ *  count-only midicapture (see performer::capture()).
+ *
+ *  If a baseline report, such as one saved from an earlier release, is
+ *  given, the time per operation of each case is compared to it, and the
+ *  program fails if any case is slower by more than the threshold percent
+ *  (25 by default), so that it can also be run as a regression test.
+ *
+ *      core_bench [-b baseline.csv] [-t percent] [report.csv]
+ *
+ *  The report goes to standard output if no file is named.  The scratch
+ *  MIDI file is "core_bench.mid", or the report name with ".mid" appended,
+ *  and is deleted at the end.
+ */
+
+#include <algorithm>                    /* std::shuffle()                   */
+#include <chrono>                       /* std::chrono::steady_clock        */
+#include <cstdio>                       /* std::snprintf(), std::fprintf()  */
+#include <cstdlib>                      /* std::atof(), EXIT_SUCCESS        */
+#include <fstream>                      /* std::ifstream, std::ofstream     */
+#include <functional>                   /* std::function<>                  */
+#include <iostream>                     /* std::cout, std::cerr             */
+#include <map>                          /* std::map<>                       */
+#include <random>                       /* std::minstd_rand                 */
+#include <string>                       /* std::string                      */
+#include <vector>                       /* std::vector<>                    */
+
+#include "cfg/settings.hpp"             /* seq66::usr(), c_base_ppqn        */
+#include "midi/eventlist.hpp"           /* seq66::eventlist                 */
+#include "midi/midicapture.hpp"         /* seq66::midicapture               */
+#include "midi/midifile.hpp"            /* seq66::midifile                  */
+#include "play/performer.hpp"           /* seq66::performer                 */
+#include "play/sequence.hpp"            /* seq66::sequence                  */
+#include "seq66_features.hpp"           /* seq66::seq_version()             */
+#include "util/filefunctions.hpp"       /* seq66::file_delete(), etc.       */
+
+namespace seq66
+{
+
+/**
+ *  The size of the synthetic song.  Each pattern is four measures long and
+ *  has a note, its Note Off, and a control change every few ticks, about
+ *  3000 events.  Its triggers are a measure long, one every other measure,
+ *  staggered between odd and even patterns.
+ */
+
+static const int c_bench_patterns   = 128;
+static const int c_bench_measures   = 4;
+static const int c_bench_notes      = 1024;
+static const int c_bench_triggers   = 32;
+
+/**
+ *  The number of times each case is run, and the number of times the
+ *  patterns are looped in Live mode.
+ */
+
+static const int c_bench_repeats    = 3;
+static const int c_bench_live_loops = 4;
+
+/**
+ *  The controller written with each note, and changed by the LFO case.  It
+ *  is the modulation wheel.
+ */
+
+static const midibyte c_bench_control = 1;
+
+/**
+ *  The default percentage by which a case may be slower than the baseline
+ *  before it counts as a regression.  Timings on a shared build machine
+ *  vary by several percent from run to run.
+ */
+
+static const double c_bench_threshold = 25.0;
+
+/**
+ *  Runs the timing cases on a synthetic song and reports the results.
+ */
+
+class benchmark
+{
+
+public:
+
+    /**
+     *  A step of a case.  Returns false if the step failed, which stops
+     *  the benchmark.
+     */
+
+    using action = std::function<bool ()>;
+
+    /**
+     *  The timings of one case.
+     */
+
+    class timing
+    {
+    public:
+
+        std::string t_name;             /**< The name of the case.          */
+        long t_operations;              /**< Operations in one run.         */
+        long t_events;                  /**< Events handled in one run.     */
+        double t_best_us;               /**< The fastest run.               */
+        double t_mean_us;               /**< The average run.               */
+
+        double ns_per_op () const
+        {
+            return t_operations > 0 ?
+                t_best_us * 1000.0 / t_operations : 0.0 ;
+        }
+    };
+
+private:
+
+    performer & m_perf;
+
+    /**
+     *  The MIDI file written and parsed by the file cases.  It is deleted
+     *  at the end.
+     */
+
+    std::string m_scratch_file;
+
+    /**
+     *  The patterns of the song, refreshed whenever the song is rebuilt.
+     */
+
+    std::vector<seq::pointer> m_patterns;
+
+    /**
+     *  The events of one pattern in shuffled order, for the eventlist
+     *  cases, and the list that they are sorted in.
+     */
+
+    event::buffer m_shuffled;
+    eventlist m_sort_list;
+
+    /**
+     *  Counts the events played, which go nowhere else.
+     */
+
+    midicapture * m_capture;
+
+    /**
+     *  The length of each pattern, and the number of events in the song.
+     */
+
+    midipulse m_pattern_length;
+    long m_event_count;
+
+    std::vector<timing> m_results;
+    std::string m_error_message;
+
+public:
+
+    benchmark (performer & p, const std::string & scratchfile);
+    benchmark (const benchmark &) = delete;
+    benchmark & operator = (const benchmark &) = delete;
+
+    bool run ();
+    bool write (std::ostream & out);
+
+    const std::vector<timing> & results () const
+    {
+        return m_results;
+    }
+
+    const std::string & error_message () const
+    {
+        return m_error_message;
+    }
+
+private:
+
+    bool measure
+    (
+        const std::string & name,
+        long operations, long events,
+        action timed, action setup = nullptr
+    );
+    bool run_cases ();
+    bool clear ();
+    bool generate ();
+    bool collect ();
+    void pattern_events (int index, event::buffer & evlist) const;
+    bool rewind (bool songmode);
+    long play (bool songmode, midipulse endtick);
+
+};          // class benchmark
+
+/**
+ *  Principal constructor.
+ *
+ * \param p
+ *      The performer, which must have no song and need not be launched.
+ *
+ * \param scratchfile
+ *      The MIDI file to write and parse.  It is overwritten, and deleted at
+ *      the end of run().
+ */
+
+benchmark::benchmark (performer & p, const std::string & scratchfile) :
+    m_perf              (p),
+    m_scratch_file      (scratchfile),
+    m_patterns          (),
+    m_shuffled          (),
+    m_sort_list         (),
+    m_capture           (nullptr),
+    m_pattern_length    (0),
+    m_event_count       (0),
+    m_results           (),
+    m_error_message     ()
+{
+    // no code
+}
+
+/**
+ *  Runs all the cases.  For the duration, what the patterns play goes to a
+ *  counting midicapture, and the patterns do not sleep when they wrap
+ *  around, as for performer::bounce().
+ *
+ * \return
+ *      Returns true if every case succeeded.  Otherwise, error_message()
+ *      names the case that failed.
+ */
+
+bool
+benchmark::run ()
+{
+    bool result = false;
+    if (m_perf.is_running() || m_perf.sequence_count() > 0)
+    {
+        m_error_message = "The benchmark needs an idle, empty performer";
+    }
+    else
+    {
+        midicapture cap(m_perf.ppqn(), true);
+        m_capture = &cap;
+        m_perf.capture(&cap);
+        result = run_cases();
+        (void) rewind(false);                   /* final Note Offs          */
+        (void) clear();
+        m_perf.capture(nullptr);
+        m_capture = nullptr;
+        if (file_exists(m_scratch_file))
+            (void) file_delete(m_scratch_file);
+    }
+    return result;
+}
+
+/**
+ *  The cases, in an order that leaves each one with the song it needs.
+ *  The transforms change the events, so they come last, on the song that
+ *  was read back from the file.
+ */
+
+bool
+benchmark::run_cases ()
+{
+    long patterns = c_bench_patterns;
+    long songevents = patterns * c_bench_notes * 3;
+    bool result = measure
+    (
+        "sequence.add_event", patterns, songevents,
+        [this] () { return generate(); },
+        [this] () { return clear(); }
+    );
+    if (result)
+    {
+        std::minstd_rand shuffler(66);
+        pattern_events(0, m_shuffled);
+        std::shuffle(m_shuffled.begin(), m_shuffled.end(), shuffler);
+
+        long count = long(m_shuffled.size());
+        result = measure
+        (
+            "eventlist.add", count, count,
+            [this] ()
+            {
+                eventlist el;
+                for (const auto & e : m_shuffled)
+                    (void) el.add(e);
+
+                return ! el.empty();
+            }
+        );
+        if (result)
+        {
+            result = measure
+            (
+                "eventlist.sort", 1, count,
+                [this] () { m_sort_list.sort(); return true; },
+                [this] ()
+                {
+                    m_sort_list.clear();
+                    for (const auto & e : m_shuffled)
+                        (void) m_sort_list.append(e);
+
+                    return true;
+                }
+            );
+        }
+    }
+    if (result)
+    {
+        result = measure
+        (
+            "sequence.verify_and_link", patterns, m_event_count,
+            [this] ()
+            {
+                for (auto & s : m_patterns)
+                    (void) s->verify_and_link();
+
+                return true;
+            }
+        );
+    }
+    if (result)
+    {
+        long played = 0;
+        midipulse endtick = m_pattern_length * c_bench_live_loops;
+        result = measure
+        (
+            "sequence.play.live", long(endtick), 0,
+            [this, endtick, &played] ()
+            {
+                played = play(false, endtick);
+                return played > 0;
+            },
+            [this] () { return rewind(false); }
+        );
+        if (result)
+            m_results.back().t_events = played;
+    }
+    if (result)
+    {
+        long played = 0;
+        midipulse endtick = m_perf.get_max_extent();
+        result = measure
+        (
+            "sequence.play.song", long(endtick), 0,
+            [this, endtick, &played] ()
+            {
+                played = play(true, endtick);
+                return played > 0;
+            },
+            [this] () { return rewind(true); }
+        );
+        if (result)
+            m_results.back().t_events = played;
+    }
+    if (result)
+    {
+        result = measure
+        (
+            "midifile.export", patterns, m_event_count,
+            [this] ()
+            {
+                midifile f(m_scratch_file, m_perf.ppqn());
+                return f.write_song(m_perf);
+            }
+        );
+    }
+    if (result)
+    {
+        result = measure
+        (
+            "midifile.write", patterns, m_event_count,
+            [this] ()
+            {
+                bool glob = usr().global_seq_feature();
+                midifile f(m_scratch_file, m_perf.ppqn(), glob);
+                return f.write(m_perf, true);
+            }
+        );
+    }
+    if (result)
+    {
+        result = measure
+        (
+            "midifile.parse", patterns, m_event_count,
+            [this] ()
+            {
+                midifile f(m_scratch_file, m_perf.ppqn());
+                return f.parse(m_perf, 0);
+            },
+            [this] () { return clear(); }
+        );
+        if (result)
+            result = collect();
+    }
+    if (result)
+    {
+        lfoparameters lp
+        {
+            64.0, 32.0, 4.0, 0.0, waveform::sine, false, false
+        };
+        result = measure
+        (
+            "sequence.lfo", patterns, m_event_count,
+            [this, lp] ()
+            {
+                for (auto & s : m_patterns)
+                    s->change_event_data_lfo
+                    (
+                        lp, EVENT_CONTROL_CHANGE, c_bench_control
+                    );
+
+                return true;
+            }
+        );
+    }
+    if (result)
+    {
+        result = measure
+        (
+            "sequence.quantize", patterns, m_event_count,
+            [this] ()
+            {
+                for (auto & s : m_patterns)
+                    (void) s->push_quantize_notes(1);
+
+                return true;
+            },
+            [this] ()
+            {
+                for (auto & s : m_patterns)
+                    s->select_all();
+
+                return true;
+            }
+        );
+    }
+    return result;
+}
+
+/**
+ *  Runs one case c_bench_repeats times and records its timings.  Only the
+ *  timed action is timed.
+ *
+ * \param name
+ *      The name of the case, written in the report.
+ *
+ * \param operations
+ *      The number of operations in one run, used to get the time for each.
+ *      For example, the number of patterns, or of frames played.
+ *
+ * \param events
+ *      The number of events handled in one run.
+ *
+ * \param timed
+ *      The work to time.
+ *
+ * \param setup
+ *      If not null, called before each run to put things back in place.
+ *
+ * \return
+ *      Returns true if all the runs succeeded.
+ */
+
+bool
+benchmark::measure
+(
+    const std::string & name,
+    long operations, long events,
+    action timed, action setup
+)
+{
+    using clock = std::chrono::steady_clock;
+    bool result = true;
+    double best = 0.0;
+    double total = 0.0;
+    for (int r = 0; result && r < c_bench_repeats; ++r)
+    {
+        if (setup)
+            result = setup();
+
+        if (result)
+        {
+            clock::time_point start = clock::now();
+            result = timed();
+
+            std::chrono::duration<double, std::micro> us =
+                clock::now() - start;
+
+            if (r == 0 || us.count() < best)
+                best = us.count();
+
+            total += us.count();
+        }
+    }
+    if (result)
+    {
+        timing t;
+        t.t_name = name;
+        t.t_operations = operations;
+        t.t_events = events;
+        t.t_best_us = best;
+        t.t_mean_us = total / c_bench_repeats;
+        m_results.push_back(t);
+    }
+    else
+        m_error_message = "Benchmark case failed: " + name;
+
+    return result;
+}
+
+/**
+ *  Removes the song.  Unlike performer::clear_all(), this leaves the global
+ *  sequence features of usr() alone.
+ */
+
+bool
+benchmark::clear ()
+{
+    m_patterns.clear();
+    return m_perf.clear_song();
+}
+
+/**
+ *  Builds the synthetic song.  The events are added one at a time, in time
+ *  order, as when recording.
+ */
+
+bool
+benchmark::generate ()
+{
+    int ppq = m_perf.ppqn();
+    midipulse triglength = midipulse(ppq) * 4;
+    bool result = true;
+    m_pattern_length = triglength * c_bench_measures;
+    m_event_count = 0;
+    for (int i = 0; result && i < c_bench_patterns; ++i)
+    {
+        seq::number finalseq;
+        result = m_perf.new_sequence(finalseq, seq::number(i));
+        if (result)
+        {
+            seq::pointer s = m_perf.get_sequence(finalseq);
+            result = bool(s);
+            if (result)
+            {
+                event::buffer evlist;
+                pattern_events(i, evlist);
+                (void) s->set_midi_channel(midibyte(i % 16));
+                (void) s->set_length(m_pattern_length, false, false);
+                for (const auto & e : evlist)
+                    (void) s->add_event(e);
+
+                for (int t = 0; t < c_bench_triggers; ++t)
+                {
+                    midipulse tick = (2 * t + i % 2) * triglength;
+                    midipulse offset = (t % c_bench_measures) * triglength;
+                    (void) s->add_trigger(tick, triglength, offset);
+                }
+                m_event_count += long(evlist.size());
+            }
+        }
+    }
+    if (result)
+        result = collect();
+
+    return result;
+}
+
+/**
+ *  Gets the patterns of the song as it now is.
+ */
+
+bool
+benchmark::collect ()
+{
+    m_patterns.clear();
+    for (int i = 0; i < m_perf.sequence_high(); ++i)
+    {
+        seq::pointer s = m_perf.get_sequence(seq::number(i));
+        if (s)
+            m_patterns.push_back(s);
+    }
+    return ! m_patterns.empty();
+}
+
+/**
+ *  Makes the events of one pattern, in time order.  The notes and values
+ *  vary with the pattern, so that no two patterns are alike.
+ */
+
+void
+benchmark::pattern_events (int index, event::buffer & evlist) const
+{
+    int ppq = m_perf.ppqn();
+    midipulse length = midipulse(ppq) * 4 * c_bench_measures;
+    midipulse spacing = length / c_bench_notes;
+    if (spacing < 2)
+        spacing = 2;
+
+    midibyte channel = midibyte(index % 16);
+    evlist.clear();
+    evlist.reserve(c_bench_notes * 3);
+    for (int n = 0; n < c_bench_notes; ++n)
+    {
+        midipulse tick = n * spacing;
+        midibyte note = midibyte(36 + (index * 7 + n * 5) % 48);
+        midibyte velocity = midibyte(64 + n % 32);
+        midibyte value = midibyte((index + n) % 128);
+        evlist.emplace_back
+        (
+            tick, midibyte(EVENT_CONTROL_CHANGE | channel),
+            c_bench_control, value
+        );
+        evlist.emplace_back
+        (
+            tick, midibyte(EVENT_NOTE_ON | channel), note, velocity
+        );
+        evlist.emplace_back
+        (
+            tick + spacing - 1, midibyte(EVENT_NOTE_OFF | channel), note, 0
+        );
+    }
+}
+
+/**
+ *  Stops the patterns and puts them back at the start.  In Live mode they
+ *  are armed; in Song mode, the triggers arm them.
+ */
+
+bool
+benchmark::rewind (bool songmode)
+{
+    m_perf.set_tick(0);
+    for (auto & s : m_patterns)
+    {
+        s->stop(songmode);
+        if (! songmode)
+            (void) s->set_armed(true);
+    }
+    return true;
+}
+
+/**
+ *  Plays the patterns one tick at a time, as performer::bounce() does.  A
+ *  frame of one tick is the worst case for the cost of each call.
+ *
+ * \return
+ *      Returns the number of events played.
+ */
+
+long
+benchmark::play (bool songmode, midipulse endtick)
+{
+    long before = m_capture->event_count();
+    for (midipulse tick = 0; tick < endtick; ++tick)
+    {
+        m_perf.set_tick(tick);
+        for (auto & s : m_patterns)
+            s->play_queue(tick, songmode, false);
+    }
+    return m_capture->event_count() - before;
+}
+
+/**
+ *  Writes the report.  Lines starting with "#" describe the run; the rest
+ *  is comma-separated values with a header line.  The times are in
+ *  microseconds, and the time per operation, from the best run, in
+ *  nanoseconds.
+ */
+
+bool
+benchmark::write (std::ostream & out)
+{
+    out
+        << "# " << seq_app_name() << " " << seq_version()
+        << " benchmark\n"
+        << "# ppqn " << m_perf.ppqn()
+        << ", patterns " << c_bench_patterns
+        << ", notes " << c_bench_notes
+        << ", triggers " << c_bench_triggers
+        << ", runs " << c_bench_repeats << "\n"
+        << "name,runs,operations,events,best_us,mean_us,best_ns_per_op\n"
+        ;
+    for (const auto & t : m_results)
+    {
+        char line[128];
+        (void) std::snprintf
+        (
+            line, sizeof line, ",%d,%ld,%ld,%.1f,%.1f,%.1f\n",
+            c_bench_repeats, t.t_operations, t.t_events,
+            t.t_best_us, t.t_mean_us, t.ns_per_op()
+        );
+        out << t.t_name << line;
+    }
+    out.flush();
+
+    bool result = out.good();
+    if (! result)
+        m_error_message = "Cannot write the benchmark report";
+
+    return result;
+}
+
+/**
+ *  Reads the time per operation of each case from an earlier report.
+ *  Comments, the header line, and short lines are skipped.
+ */
+
+static bool
+read_baseline (const std::string & fname, std::map<std::string, double> & ns)
+{
+    std::ifstream file(fname);
+    bool result = file.is_open();
+    if (result)
+    {
+        std::string line;
+        while (std::getline(file, line))
+        {
+            if (line.empty() || line[0] == '#')
+                continue;
+
+            std::vector<std::string> fields;
+            std::string::size_type start = 0;
+            for (;;)
+            {
+                std::string::size_type comma = line.find(',', start);
+                fields.push_back(line.substr(start, comma - start));
+                if (comma == std::string::npos)
+                    break;
+
+                start = comma + 1;
+            }
+            if (fields.size() >= 7 && fields[0] != "name")
+                ns[fields[0]] = std::atof(fields[6].c_str());
+        }
+        result = ! ns.empty();
+    }
+    return result;
+}
+
+/**
+ *  Compares each case with the baseline.  A case missing from the baseline
+ *  is noted, but is not a failure.
+ *
+ * \return
+ *      Returns true if no case is slower than the baseline by more than
+ *      the given percentage.
+ */
+
+static bool
+compare_baseline
+(
+    const benchmark & b,
+    const std::map<std::string, double> & baseline,
+    double percent
+)
+{
+    bool result = true;
+    for (const auto & t : b.results())
+    {
+        auto it = baseline.find(t.t_name);
+        if (it != baseline.end())
+        {
+            double base = it->second;
+            double now = t.ns_per_op();
+            double change = base > 0.0 ? (now - base) * 100.0 / base : 0.0 ;
+            bool slow = change > percent;
+            std::fprintf
+            (
+                stderr, "%s: %.1f ns/op, baseline %.1f, %+.1f%%%s\n",
+                t.t_name.c_str(), now, base, change, slow ? " REGRESSION" : ""
+            );
+            if (slow)
+                result = false;
+        }
+        else
+            std::fprintf(stderr, "%s: not in the baseline\n", t.t_name.c_str());
+    }
+    return result;
+}
+
+}           // namespace seq66
+
+/**
+ *  Runs the benchmark on a performer that is never launched, writes the
+ *  report, and checks it against the baseline, if one is given.
+ */
+
+int
+main (int argc, char * argv [])
+{
+    std::string baselinefile;
+    std::string reportfile;
+    double percent = seq66::c_bench_threshold;
+    bool ok = true;
+    for (int i = 1; ok && i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "-b" && i + 1 < argc)
+            baselinefile = argv[++i];
+        else if (arg == "-t" && i + 1 < argc)
+            percent = std::atof(argv[++i]);
+        else if (arg[0] != '-' && reportfile.empty())
+            reportfile = arg;
+        else
+            ok = false;
+    }
+    if (! ok)
+    {
+        std::fprintf
+        (
+            stderr, "Usage: %s [-b baseline.csv] [-t percent] [report.csv]\n",
+            argv[0]
+        );
+        return EXIT_FAILURE;
+    }
+
+    std::map<std::string, double> baseline;
+    if (! baselinefile.empty())
+    {
+        ok = seq66::read_baseline(baselinefile, baseline);
+        if (! ok)
+        {
+            std::fprintf
+            (
+                stderr, "Cannot read the baseline %s\n", baselinefile.c_str()
+            );
+        }
+    }
+    if (ok)
+    {
+        std::string scratch = reportfile.empty() ?
+            std::string("core_bench.mid") : reportfile + ".mid" ;
+
+        seq66::performer p
+        (
+            seq66::c_base_ppqn, seq66::usr().mainwnd_rows(),
+            seq66::usr().mainwnd_cols()
+        );
+        seq66::benchmark b(p, scratch);
+
+        /*
+         * The library writes its status messages to standard output; send
+         * them to standard error while the cases run, so that they do not
+         * end up in the report.
+         */
+
+        std::streambuf * coutbuf = std::cout.rdbuf(std::cerr.rdbuf());
+        ok = b.run();
+        (void) std::cout.rdbuf(coutbuf);
+        if (ok)
+        {
+            if (reportfile.empty())
+            {
+                ok = b.write(std::cout);
+            }
+            else
+            {
+                std::ofstream file(reportfile, std::ios::out | std::ios::trunc);
+                ok = file.is_open() && b.write(file);
+            }
+        }
+        if (! ok)
+        {
+            const std::string & msg = b.error_message();
+            std::fprintf
+            (
+                stderr, "%s\n",
+                msg.empty() ? "Cannot write the benchmark report" : msg.c_str()
+            );
+        }
+        else if (! baseline.empty())
+            ok = seq66::compare_baseline(b, baseline, percent);
+    }
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE ;
+}
+
+/*
+ * core_bench.cpp
+ *
+ * vim: sw=4 ts=4 wm=4 et ft=cpp
+ */